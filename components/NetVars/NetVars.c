@@ -6,10 +6,13 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <limits.h>
+#include <float.h>
 
 #include "cJSON.h"
 #include <nvs.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #include <mbedtls/base64.h>
@@ -18,6 +21,13 @@
 
 static const char *TAG = "NetVars";
 
+#ifndef CONFIG_NETVARS_NVS_DEBOUNCE_MS
+#define CONFIG_NETVARS_NVS_DEBOUNCE_MS 5000
+#endif
+#ifndef CONFIG_NETVARS_NVS_MAX_DELAY_MS
+#define CONFIG_NETVARS_NVS_MAX_DELAY_MS 30000
+#endif
+
 static void u8_buf_to_hex(const uint8_t *src, size_t len, char *dst, size_t dst_len);
 static bool hex_to_u8_buf(const char *src, uint8_t *dst, size_t len, bool *out_changed);
 static bool base64_encode_buf(const uint8_t *src, size_t len, char **out, size_t *out_len);
@@ -476,53 +486,67 @@ void NetVars_nvs_load(const NetVars_desc_t netvars_desc[], const size_t netvars_
     }
 }
 
-void NetVars_nvs_save(const NetVars_desc_t netvars_desc[], const size_t netvars_count, nvs_handle_t h)
+// Writes one descriptor (no commit). Adds the payload size to *bytes.
+static esp_err_t nvs_save_one(const NetVars_desc_t *d, nvs_handle_t h, uint32_t *bytes)
 {
-    esp_err_t err;
+    esp_err_t err = ESP_OK;
+    size_t n = 0;
 
+    switch (d->type) {
+    case NETVARS_TYPE_BOOL:
+        err = nvs_set_u8(h, d->nvs_key, *(bool *)d->ptr ? 1 : 0);
+        n = 1;
+        break;
+    case NETVARS_TYPE_U8: {
+        size_t len = d->len ? d->len : 1;
+        if (len > 1) {
+            err = nvs_set_blob(h, d->nvs_key, d->ptr, len);
+        } else {
+            err = nvs_set_u8(h, d->nvs_key, *(uint8_t *)d->ptr);
+        }
+        n = len;
+        break;
+    }
+    case NETVARS_TYPE_I8:
+        err = nvs_set_i8(h, d->nvs_key, *(int8_t *)d->ptr);
+        n = 1;
+        break;
+    case NETVARS_TYPE_I16:
+        err = nvs_set_i16(h, d->nvs_key, *(int16_t *)d->ptr);
+        n = 2;
+        break;
+    case NETVARS_TYPE_U16:
+        err = nvs_set_u16(h, d->nvs_key, *(uint16_t *)d->ptr);
+        n = 2;
+        break;
+    case NETVARS_TYPE_I32:
+        err = nvs_set_i32(h, d->nvs_key, *(int32_t *)d->ptr);
+        n = 4;
+        break;
+    case NETVARS_TYPE_U32:
+        err = nvs_set_u32(h, d->nvs_key, *(uint32_t *)d->ptr);
+        n = 4;
+        break;
+    case NETVARS_TYPE_FLOAT:
+    case NETVARS_TYPE_FLOATINT:
+        err = nvs_set_blob(h, d->nvs_key, d->ptr, sizeof(float));
+        n = sizeof(float);
+        break;
+    case NETVARS_TYPE_STRING:
+        break;
+    }
+
+    if (err == ESP_OK && bytes) *bytes += (uint32_t)n;
+    return err;
+}
+
+void NetVars_nvs_save(const NetVars_desc_t netvars_desc[], const size_t netvars_count, nvs_handle_t h)
+{
     for (size_t i = 0; i < netvars_count; ++i) {
         const NetVars_desc_t *d = &netvars_desc[i];
-        if (!d->nvs_key) continue;
-        if (d->nvs_mode != PRJCFG_NVS_SAVE &&
-            d->nvs_mode != PRJCFG_NVS_LOADSAVE) continue;
-
-        switch (d->type) {
-        case NETVARS_TYPE_BOOL:
-            err = nvs_set_u8(h, d->nvs_key, *(bool *)d->ptr ? 1 : 0);
-            break;
-        case NETVARS_TYPE_U8: {
-            size_t len = d->len ? d->len : 1;
-            if (len > 1) {
-                err = nvs_set_blob(h, d->nvs_key, d->ptr, len);
-            } else {
-                err = nvs_set_u8(h, d->nvs_key, *(uint8_t *)d->ptr);
-            }
-            break;
-        }
-        case NETVARS_TYPE_I8:
-            err = nvs_set_i8(h, d->nvs_key, *(int8_t *)d->ptr);
-            break;
-        case NETVARS_TYPE_I16:
-            err = nvs_set_i16(h, d->nvs_key, *(int16_t *)d->ptr);
-            break;
-        case NETVARS_TYPE_U16:
-            err = nvs_set_u16(h, d->nvs_key, *(uint16_t *)d->ptr);
-            break;
-        case NETVARS_TYPE_I32:
-            err = nvs_set_i32(h, d->nvs_key, *(int32_t *)d->ptr);
-            break;
-        case NETVARS_TYPE_U32:
-            err = nvs_set_u32(h, d->nvs_key, *(uint32_t *)d->ptr);
-            break;
-        case NETVARS_TYPE_FLOAT:
-        case NETVARS_TYPE_FLOATINT:
-            err = nvs_set_blob(h, d->nvs_key, d->ptr, sizeof(float));
-            break;
-        case NETVARS_TYPE_STRING:
-            err = ESP_OK;
-            break;
-        }
+        if (!should_mark_nvs(d)) continue;
 
+        esp_err_t err = nvs_save_one(d, h, NULL);
         if (err != ESP_OK) {
             // opcional: logs
         }
@@ -576,58 +600,119 @@ void NetVars_append_json(const NetVars_desc_t netvars_desc[], const size_t netva
 }
 
 static const NetVars_desc_t *
-NetVars_find_by_json_key(const NetVars_desc_t netvars_desc[], const size_t netvars_count, const char *key)
+NetVars_find_by_json_key(const NetVars_desc_t netvars_desc[], const size_t netvars_count,
+                         const uint16_t key_index[], const size_t key_index_count, const char *key)
 {
-    for (size_t i = 0; i < netvars_count; ++i) {
-        const NetVars_desc_t *d = &netvars_desc[i];
-        if (d->json_key && strcmp(d->json_key, key) == 0)
+    if (!key) return NULL;
+    if (!key_index) {
+        for (size_t i = 0; i < netvars_count; ++i) {
+            const NetVars_desc_t *d = &netvars_desc[i];
+            if (d->json_key && strcmp(d->json_key, key) == 0)
+                return d;
+        }
+        return NULL;
+    }
+
+    // Lower bound over the generated key index, so duplicated keys resolve
+    // to the lowest table position, as the linear scan does.
+    size_t lo = 0, hi = key_index_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (strcmp(netvars_desc[key_index[mid]].json_key, key) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < key_index_count && key_index[lo] < netvars_count) {
+        const NetVars_desc_t *d = &netvars_desc[key_index[lo]];
+        if (strcmp(d->json_key, key) == 0)
             return d;
     }
     return NULL;
 }
 
+bool NetVars_key_index_check(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count,
+                             const uint16_t key_index[], const size_t key_index_count)
+{
+    size_t keyed = 0;
+    for (size_t i = 0; i < netvars_count; ++i) {
+        if (netvars_desc[i].json_key) keyed++;
+    }
+    if (key_index_count != keyed) {
+        ESP_LOGE(TAG, "%s: key index has %u entries for %u keyed descriptors", ident, (unsigned)key_index_count,
+                 (unsigned)keyed);
+        return false;
+    }
+    // Strictly increasing (json_key, position) pairs: sorted, no position
+    // listed twice, so with the count above every keyed descriptor is in.
+    for (size_t k = 0; k < key_index_count; ++k) {
+        const uint16_t pos = key_index[k];
+        if (pos >= netvars_count || !netvars_desc[pos].json_key) {
+            ESP_LOGE(TAG, "%s: key index entry %u points at no keyed descriptor", ident, (unsigned)k);
+            return false;
+        }
+        if (k == 0) continue;
+        const uint16_t prev = key_index[k - 1];
+        int order = strcmp(netvars_desc[prev].json_key, netvars_desc[pos].json_key);
+        if (order > 0 || (order == 0 && prev >= pos)) {
+            ESP_LOGE(TAG, "%s: key index out of order at \"%s\"", ident, netvars_desc[pos].json_key);
+            return false;
+        }
+    }
+    return true;
+}
+
 bool NetVars_parse_json_dict(const NetVars_desc_t netvars_desc[], const size_t netvars_count, cJSON *root)
+{
+    return NetVars_parse_json_dict_indexed(netvars_desc, netvars_count, NULL, 0, root, NULL);
+}
+
+bool NetVars_parse_json_dict_indexed(const NetVars_desc_t netvars_desc[], const size_t netvars_count,
+                                     const uint16_t key_index[], const size_t key_index_count, cJSON *root,
+                                     netvars_nvs_mgr_t *mngr)
 {
     bool out_nvs_changed = false;
 
     cJSON *nvi = NULL;
     cJSON_ArrayForEach(nvi, root) {
         const NetVars_desc_t *d =
-            NetVars_find_by_json_key(netvars_desc, netvars_count, nvi->string);
+            NetVars_find_by_json_key(netvars_desc, netvars_count, key_index, key_index_count, nvi->string);
         if (!d) continue;
         NetVars_json_mode_t mode_dir = (NetVars_json_mode_t)d->json_mode;
         if (mode_dir == NETVARS_JSON_MODE_NONE || mode_dir == NETVARS_JSON_MODE_OUT) continue;
         NetVars_json_repr_t jm = (NetVars_json_repr_t)d->json_repr;
 
+        bool d_changed = false;
+
         switch (d->type) {
         case NETVARS_TYPE_BOOL: {
             bool value = cJSON_IsTrue(nvi);
             if (value != *(bool *)d->ptr) {
                 *(bool *)d->ptr = value;
-                if (should_mark_nvs(d)) out_nvs_changed = true;
+                if (should_mark_nvs(d)) d_changed = true;
             }
             break;
         }
         case NETVARS_TYPE_U8:
-            parse_json_u8_u16_vec(d, jm, nvi, &out_nvs_changed, sizeof(uint8_t));
+            parse_json_u8_u16_vec(d, jm, nvi, &d_changed, sizeof(uint8_t));
             break;
         case NETVARS_TYPE_I8:
         case NETVARS_TYPE_I16:
         case NETVARS_TYPE_I32: {
-            parse_json_scalar_int(d, jm, nvi, &out_nvs_changed);
+            parse_json_scalar_int(d, jm, nvi, &d_changed);
             break;
         }
         case NETVARS_TYPE_U16:
-            parse_json_u8_u16_vec(d, jm, nvi, &out_nvs_changed, sizeof(uint16_t));
+            parse_json_u8_u16_vec(d, jm, nvi, &d_changed, sizeof(uint16_t));
             break;
         case NETVARS_TYPE_U32:
-            parse_json_scalar_int(d, jm, nvi, &out_nvs_changed);
+            parse_json_scalar_int(d, jm, nvi, &d_changed);
             break;
         case NETVARS_TYPE_FLOAT: {
             float value = (float)nvi->valuedouble;
             if (value != *(float *)d->ptr) {
                 *(float *)d->ptr = value;
-                if (should_mark_nvs(d)) out_nvs_changed = true;
+                if (should_mark_nvs(d)) d_changed = true;
             }
             break;
         }
@@ -638,7 +723,7 @@ bool NetVars_parse_json_dict(const NetVars_desc_t netvars_desc[], const size_t n
                 float value = (float)scaled / (float)scale;
                 if (value != *(float *)d->ptr) {
                     *(float *)d->ptr = value;
-                    if (should_mark_nvs(d)) out_nvs_changed = true;
+                    if (should_mark_nvs(d)) d_changed = true;
                 }
             }
             break;
@@ -652,11 +737,16 @@ bool NetVars_parse_json_dict(const NetVars_desc_t netvars_desc[], const size_t n
                 strlcpy(dst, nvi->valuestring, max_len);
                 size_t new_len = strnlen(dst, max_len);
                 if (new_len != prev_len || strncmp(dst, nvi->valuestring, max_len) != 0) {
-                    if (should_mark_nvs(d)) out_nvs_changed = true;
+                    if (should_mark_nvs(d)) d_changed = true;
                 }
             }
             break;
         }
+
+        if (d_changed) {
+            out_nvs_changed = true;
+            if (mngr) NetVars_nvs_set_dirty_index(mngr, (size_t)(d - netvars_desc));
+        }
     }
     return out_nvs_changed;
 }
@@ -707,6 +797,13 @@ void NetVars_append_json_component(const char *ident, const NetVars_desc_t netva
 }
 
 bool NetVars_parse_json_component(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count, cJSON *root)
+{
+    return NetVars_parse_json_component_indexed(ident, netvars_desc, netvars_count, NULL, 0, root, NULL);
+}
+
+bool NetVars_parse_json_component_indexed(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count,
+                                          const uint16_t key_index[], const size_t key_index_count, cJSON *root,
+                                          netvars_nvs_mgr_t *mngr)
 {
     if (!ident || !root) return false;
     if (netvars_count == 0) return false;
@@ -721,7 +818,7 @@ bool NetVars_parse_json_component(const char *ident, const NetVars_desc_t netvar
             cJSON *sub = cJSON_GetObjectItemCaseSensitive(elem, ident);
             if (sub)
             {
-                if (NetVars_parse_json_dict(netvars_desc, netvars_count, sub))
+                if (NetVars_parse_json_dict_indexed(netvars_desc, netvars_count, key_index, key_index_count, sub, mngr))
                     changed = true;
             }
         }
@@ -731,7 +828,7 @@ bool NetVars_parse_json_component(const char *ident, const NetVars_desc_t netvar
         cJSON *sub = cJSON_GetObjectItemCaseSensitive(root, ident);
         if (sub)
         {
-            changed = NetVars_parse_json_dict(netvars_desc, netvars_count, sub);
+            changed = NetVars_parse_json_dict_indexed(netvars_desc, netvars_count, key_index, key_index_count, sub, mngr);
         }
     }
 
@@ -748,6 +845,302 @@ bool NetVars_parse_json_component_data(const char *ident, const NetVars_desc_t n
     return changed;
 }
 
+// ------------------ BEGIN Streaming JSON writer ------------------
+
+void NetVars_jw_init(NetVars_json_writer_t *w, char *buf, size_t size, NetVars_jw_flush_t flush, void *ctx)
+{
+    if (!w) return;
+    memset(w, 0, sizeof(*w));
+    w->buf = buf;
+    w->size = size;
+    w->flush = flush;
+    w->ctx = ctx;
+    w->overflow = (!buf || size < 2);
+}
+
+static void jw_put(NetVars_json_writer_t *w, const char *s, size_t n)
+{
+    while (!w->overflow && n > 0) {
+        size_t room = w->size - 1 - w->len;
+        if (room == 0) {
+            if (!w->flush) {
+                w->overflow = true;
+                return;
+            }
+            w->flush(w->buf, w->len, w->ctx);
+            w->len = 0;
+            continue;
+        }
+        size_t chunk = (n < room) ? n : room;
+        memcpy(w->buf + w->len, s, chunk);
+        w->len += chunk;
+        w->total += chunk;
+        s += chunk;
+        n -= chunk;
+    }
+}
+
+static inline void jw_putc(NetVars_json_writer_t *w, char c)
+{
+    jw_put(w, &c, 1);
+}
+
+// Same escaping as cJSON's print_string_ptr(); stops at NUL or max_len.
+static void jw_string(NetVars_json_writer_t *w, const char *s, size_t max_len)
+{
+    jw_putc(w, '"');
+    const char *run = s;
+    size_t i = 0;
+    for (; i < max_len && s[i] != '\0'; ++i) {
+        unsigned char c = (unsigned char)s[i];
+        char esc[7];
+        size_t esc_len = 2;
+        esc[0] = '\\';
+        switch (c) {
+        case '"':  esc[1] = '"';  break;
+        case '\\': esc[1] = '\\'; break;
+        case '\b': esc[1] = 'b';  break;
+        case '\f': esc[1] = 'f';  break;
+        case '\n': esc[1] = 'n';  break;
+        case '\r': esc[1] = 'r';  break;
+        case '\t': esc[1] = 't';  break;
+        default:
+            if (c >= 0x20) continue;
+            esc_len = (size_t)snprintf(esc, sizeof(esc), "\\u%04x", c);
+            break;
+        }
+        jw_put(w, run, (size_t)(&s[i] - run));
+        jw_put(w, esc, esc_len);
+        run = &s[i + 1];
+    }
+    jw_put(w, run, (size_t)(&s[i] - run));
+    jw_putc(w, '"');
+}
+
+static void jw_key(NetVars_json_writer_t *w, const char *key)
+{
+    uint8_t bit = (uint8_t)(1u << w->depth);
+    if (w->has_items & bit) jw_putc(w, ',');
+    w->has_items |= bit;
+    jw_string(w, key, SIZE_MAX);
+    jw_putc(w, ':');
+}
+
+// Same formatting as cJSON's print_number(), including the valueint
+// saturation used to pick the integer form.
+static void jw_number(NetVars_json_writer_t *w, double d)
+{
+    char buf[32];
+    int n;
+    if (isnan(d) || isinf(d)) {
+        n = snprintf(buf, sizeof(buf), "null");
+    } else {
+        int vi = (d >= INT_MAX) ? INT_MAX : (d <= (double)INT_MIN) ? INT_MIN : (int)d;
+        if (d == (double)vi) {
+            n = snprintf(buf, sizeof(buf), "%d", vi);
+        } else {
+            double test = 0.0;
+            n = snprintf(buf, sizeof(buf), "%1.15g", d);
+            if (sscanf(buf, "%lg", &test) != 1 ||
+                fabs(test - d) > fmax(fabs(test), fabs(d)) * DBL_EPSILON) {
+                n = snprintf(buf, sizeof(buf), "%1.17g", d);
+            }
+        }
+    }
+    if (n > 0) jw_put(w, buf, (size_t)n);
+}
+
+void NetVars_jw_begin_object(NetVars_json_writer_t *w, const char *key)
+{
+    if (!w) return;
+    if (w->depth >= NETVARS_JW_MAX_DEPTH - 1) {
+        w->overflow = true;
+        return;
+    }
+    if (w->depth > 0 && key) jw_key(w, key);
+    jw_putc(w, '{');
+    w->depth++;
+    w->has_items &= (uint8_t)~(1u << w->depth);
+}
+
+void NetVars_jw_end_object(NetVars_json_writer_t *w)
+{
+    if (!w || w->depth == 0) return;
+    jw_putc(w, '}');
+    w->depth--;
+}
+
+bool NetVars_jw_finish(NetVars_json_writer_t *w)
+{
+    if (!w) return false;
+    if (w->buf && w->size > 0) {
+        if (w->flush && w->len > 0 && !w->overflow) {
+            w->flush(w->buf, w->len, w->ctx);
+            w->len = 0;
+        }
+        w->buf[w->len] = '\0';
+    }
+    return !w->overflow;
+}
+
+static void write_json_scalar_int(const NetVars_desc_t *d, NetVars_json_repr_t jm, NetVars_json_writer_t *w)
+{
+    NetVars_json_repr_t mode = jm;
+    if (mode == NETVARS_JSON_REPR_AUTO) {
+        mode = NETVARS_JSON_REPR_DEC;
+    }
+
+    size_t bytes = 0;
+    bool is_signed = false;
+    double value = 0.0;
+    switch (d->type) {
+    case NETVARS_TYPE_U8:  bytes = sizeof(uint8_t);  is_signed = false; value = *(uint8_t *)d->ptr;  break;
+    case NETVARS_TYPE_I8:  bytes = sizeof(int8_t);   is_signed = true;  value = *(int8_t *)d->ptr;   break;
+    case NETVARS_TYPE_U16: bytes = sizeof(uint16_t); is_signed = false; value = *(uint16_t *)d->ptr; break;
+    case NETVARS_TYPE_I16: bytes = sizeof(int16_t);  is_signed = true;  value = *(int16_t *)d->ptr;  break;
+    case NETVARS_TYPE_I32: bytes = sizeof(int32_t);  is_signed = true;  value = *(int32_t *)d->ptr;  break;
+    case NETVARS_TYPE_U32: bytes = sizeof(uint32_t); is_signed = false; value = *(uint32_t *)d->ptr; break;
+    default: return;
+    }
+
+    jw_key(w, d->json_key);
+    if (mode == NETVARS_JSON_REPR_HEX || mode == NETVARS_JSON_REPR_INVHEX) {
+        char buf[2 * sizeof(uint64_t) + 1] = {0};
+        if (mode == NETVARS_JSON_REPR_INVHEX) {
+            scalar_to_invhex_string(d->ptr, bytes, buf, sizeof(buf));
+        } else {
+            scalar_to_hex_string(d->ptr, bytes, is_signed, buf, sizeof(buf));
+        }
+        jw_string(w, buf, sizeof(buf));
+        return;
+    }
+    jw_number(w, value);
+}
+
+static void write_json_u8_u16_vec(const NetVars_desc_t *d, NetVars_json_writer_t *w, size_t elem_size)
+{
+    size_t len = d->len ? d->len : 1;
+    NetVars_json_repr_t repr = (NetVars_json_repr_t)d->json_repr;
+    if (repr == NETVARS_JSON_REPR_AUTO) {
+        repr = (len > 1) ? NETVARS_JSON_REPR_HEX : NETVARS_JSON_REPR_DEC;
+    }
+    if (len <= 1) {
+        write_json_scalar_int(d, repr, w);
+        return;
+    }
+
+    const uint8_t *src = (const uint8_t *)d->ptr;
+    size_t byte_len = len * elem_size;
+    jw_key(w, d->json_key);
+    switch (repr) {
+    case NETVARS_JSON_REPR_ARRAY:
+        jw_putc(w, '[');
+        for (size_t j = 0; j < len; ++j) {
+            uint32_t value = (elem_size == sizeof(uint8_t)) ?
+                ((uint8_t *)d->ptr)[j] : ((uint16_t *)d->ptr)[j];
+            if (j > 0) jw_putc(w, ',');
+            jw_number(w, value);
+        }
+        jw_putc(w, ']');
+        break;
+    case NETVARS_JSON_REPR_HEX: {
+        // Chunked so the whole string never has to exist at once.
+        char hex[2 * 16 + 1];
+        jw_putc(w, '"');
+        for (size_t off = 0; off < byte_len; off += 16) {
+            size_t n = (byte_len - off < 16) ? (byte_len - off) : 16;
+            u8_buf_to_hex(src + off, n, hex, sizeof(hex));
+            jw_put(w, hex, 2 * n);
+        }
+        jw_putc(w, '"');
+        break;
+    }
+    case NETVARS_JSON_REPR_BASE64: {
+        // 48-byte input chunks keep every chunk on a 3-byte group boundary,
+        // so the concatenation equals a single-shot encode.
+        unsigned char b64[4 * (48 / 3) + 1];
+        jw_putc(w, '"');
+        for (size_t off = 0; off < byte_len; off += 48) {
+            size_t n = (byte_len - off < 48) ? (byte_len - off) : 48;
+            size_t olen = 0;
+            if (mbedtls_base64_encode(b64, sizeof(b64), &olen, src + off, n) != 0) {
+                w->overflow = true;
+                return;
+            }
+            jw_put(w, (const char *)b64, olen);
+        }
+        jw_putc(w, '"');
+        break;
+    }
+    case NETVARS_JSON_REPR_DEC:
+    default:
+        jw_number(w, (elem_size == sizeof(uint8_t)) ? *(uint8_t *)d->ptr : *(uint16_t *)d->ptr);
+        break;
+    }
+}
+
+void NetVars_write_json(const NetVars_desc_t netvars_desc[], const size_t netvars_count, NetVars_json_writer_t *w)
+{
+    if (!w) return;
+    for (size_t i = 0; i < netvars_count && !w->overflow; ++i) {
+        const NetVars_desc_t *d = &netvars_desc[i];
+        if (!d->json || !d->json_key) continue;
+        NetVars_json_mode_t mode_dir = (NetVars_json_mode_t)d->json_mode;
+        if (mode_dir == NETVARS_JSON_MODE_NONE || mode_dir == NETVARS_JSON_MODE_IN) continue;
+        NetVars_json_repr_t jm = (NetVars_json_repr_t)d->json_repr;
+
+        switch (d->type) {
+        case NETVARS_TYPE_BOOL:
+            jw_key(w, d->json_key);
+            if (*(bool *)d->ptr) jw_put(w, "true", 4);
+            else jw_put(w, "false", 5);
+            break;
+        case NETVARS_TYPE_U8:
+            write_json_u8_u16_vec(d, w, sizeof(uint8_t));
+            break;
+        case NETVARS_TYPE_I8:
+        case NETVARS_TYPE_I16:
+        case NETVARS_TYPE_I32:
+        case NETVARS_TYPE_U32:
+            write_json_scalar_int(d, jm, w);
+            break;
+        case NETVARS_TYPE_U16:
+            write_json_u8_u16_vec(d, w, sizeof(uint16_t));
+            break;
+        case NETVARS_TYPE_FLOAT:
+            jw_key(w, d->json_key);
+            jw_number(w, *(float *)d->ptr);
+            break;
+        case NETVARS_TYPE_FLOATINT: {
+            int32_t scale = d->scale > 0 ? d->scale : 1;
+            float v = *(float *)d->ptr;
+            int64_t scaled = llroundf(v * (float)scale);
+            jw_key(w, d->json_key);
+            jw_number(w, (double)scaled);
+            break;
+        }
+        case NETVARS_TYPE_STRING:
+            jw_key(w, d->json_key);
+            jw_string(w, (const char *)d->ptr, d->len ? d->len : SIZE_MAX);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void NetVars_write_json_component(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count, NetVars_json_writer_t *w)
+{
+    if (!ident || !w) return;
+    if (netvars_count == 0) return;
+
+    NetVars_jw_begin_object(w, ident);
+    NetVars_write_json(netvars_desc, netvars_count, w);
+    NetVars_jw_end_object(w);
+}
+
+// ------------------ END   Streaming JSON writer ------------------
+
 static inline BaseType_t _create_nvs_mutex_once(netvars_nvs_mgr_t *mngr)
 {
     if (!mngr) return pdFAIL;
@@ -759,13 +1152,34 @@ static inline BaseType_t _create_nvs_mutex_once(netvars_nvs_mgr_t *mngr)
     return pdPASS;
 }
 
+static void nvs_touch_locked(netvars_nvs_mgr_t *mngr)
+{
+    TickType_t now = xTaskGetTickCount();
+    if (!mngr->dirty) mngr->dirty_first = now;
+    mngr->dirty = true;
+    mngr->dirty_since = now;
+}
+
 void NetVars_nvs_set_dirty(netvars_nvs_mgr_t *mngr)
 {
     if (_create_nvs_mutex_once(mngr) != pdPASS) return;
     xSemaphoreTake(mngr->mutex, portMAX_DELAY);
-    mngr->dirty = true;
-        mngr->dirty_since = xTaskGetTickCount();
-        xSemaphoreGive(mngr->mutex);
+    mngr->dirty_all = true;
+    nvs_touch_locked(mngr);
+    xSemaphoreGive(mngr->mutex);
+}
+
+void NetVars_nvs_set_dirty_index(netvars_nvs_mgr_t *mngr, size_t index)
+{
+    if (_create_nvs_mutex_once(mngr) != pdPASS) return;
+    xSemaphoreTake(mngr->mutex, portMAX_DELAY);
+    if (index < (size_t)NETVARS_NVS_DIRTY_WORDS * 32) {
+        mngr->dirty_bits[index / 32] |= 1u << (index % 32);
+    } else {
+        mngr->dirty_all = true;
+    }
+    nvs_touch_locked(mngr);
+    xSemaphoreGive(mngr->mutex);
 }
 
 static void u8_buf_to_hex(const uint8_t *src, size_t len, char *dst, size_t dst_len)
@@ -849,6 +1263,17 @@ static bool base64_decode_buf(const char *src, uint8_t *dst, size_t len, bool *o
     return true;
 }
 
+// Caller holds the mutex.
+static bool nvs_batch_due(const netvars_nvs_mgr_t *mngr, TickType_t now_ticks)
+{
+    if (!mngr->dirty) return false;
+    if ((TickType_t)(now_ticks - mngr->dirty_since) >= pdMS_TO_TICKS(CONFIG_NETVARS_NVS_DEBOUNCE_MS)) return true;
+#if CONFIG_NETVARS_NVS_MAX_DELAY_MS > 0
+    if ((TickType_t)(now_ticks - mngr->dirty_first) >= pdMS_TO_TICKS(CONFIG_NETVARS_NVS_MAX_DELAY_MS)) return true;
+#endif
+    return false;
+}
+
 bool NetVars_nvs_spin(netvars_nvs_mgr_t *mngr)
 {
     if (_create_nvs_mutex_once(mngr) != pdPASS) return false;
@@ -856,13 +1281,278 @@ bool NetVars_nvs_spin(netvars_nvs_mgr_t *mngr)
     bool should_save = false;
 
     xSemaphoreTake(mngr->mutex, portMAX_DELAY);
-    if (mngr->dirty &&
-        (TickType_t)(now_ticks - mngr->dirty_since) >= pdMS_TO_TICKS(5000))
+    if (nvs_batch_due(mngr, now_ticks))
     {
         mngr->dirty = false;
+        mngr->dirty_all = false;
+        memset(mngr->dirty_bits, 0, sizeof(mngr->dirty_bits));
         should_save = true;
     }
     xSemaphoreGive(mngr->mutex);
 
     return should_save;
 }
+
+// Puts the keys of a flush that did not make it back into the batch, so
+// they are retried after another debounce period instead of being lost.
+static void nvs_requeue(netvars_nvs_mgr_t *mngr, const uint32_t bits[], bool all)
+{
+    TickType_t now_ticks = xTaskGetTickCount();
+    xSemaphoreTake(mngr->mutex, portMAX_DELAY);
+    for (size_t w = 0; w < NETVARS_NVS_DIRTY_WORDS; ++w)
+    {
+        mngr->dirty_bits[w] |= bits[w];
+    }
+    mngr->dirty_all |= all;
+    if (!mngr->dirty)
+    {
+        mngr->dirty = true;
+        mngr->dirty_first = now_ticks;
+    }
+    mngr->dirty_since = now_ticks;
+    xSemaphoreGive(mngr->mutex);
+}
+
+bool NetVars_nvs_spin_component(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count,
+                                netvars_nvs_mgr_t *mngr)
+{
+    if (!ident || _create_nvs_mutex_once(mngr) != pdPASS) return false;
+    TickType_t now_ticks = xTaskGetTickCount();
+    uint32_t bits[NETVARS_NVS_DIRTY_WORDS];
+    bool all;
+
+    xSemaphoreTake(mngr->mutex, portMAX_DELAY);
+    if (!nvs_batch_due(mngr, now_ticks))
+    {
+        xSemaphoreGive(mngr->mutex);
+        return false;
+    }
+    all = mngr->dirty_all;
+    memcpy(bits, mngr->dirty_bits, sizeof(bits));
+    mngr->dirty = false;
+    mngr->dirty_all = false;
+    memset(mngr->dirty_bits, 0, sizeof(mngr->dirty_bits));
+    xSemaphoreGive(mngr->mutex);
+
+    int64_t t0 = esp_timer_get_time();
+    nvs_handle_t h;
+    esp_err_t err = nvs_open(ident, NVS_READWRITE, &h);
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "nvs_open(%s) failed: %s", ident, esp_err_to_name(err));
+        nvs_requeue(mngr, bits, all);
+        return false;
+    }
+
+    uint32_t failed_bits[NETVARS_NVS_DIRTY_WORDS] = {0};
+    bool failed_all = false;
+    uint32_t written = 0;
+    uint32_t skipped = 0;
+    uint32_t bytes = 0;
+    for (size_t i = 0; i < netvars_count; ++i)
+    {
+        const NetVars_desc_t *d = &netvars_desc[i];
+        if (!should_mark_nvs(d)) continue;
+        bool tracked = i < (size_t)NETVARS_NVS_DIRTY_WORDS * 32;
+        bool dirty = all || (tracked && (bits[i / 32] & (1u << (i % 32))));
+        if (!dirty)
+        {
+            skipped++;
+            continue;
+        }
+        err = nvs_save_one(d, h, &bytes);
+        if (err != ESP_OK)
+        {
+            ESP_LOGW(TAG, "%s: nvs_set(%s) failed: %s", ident, d->nvs_key, esp_err_to_name(err));
+            if (tracked)
+                failed_bits[i / 32] |= 1u << (i % 32);
+            else
+                failed_all = true;
+            continue;
+        }
+        written++;
+    }
+    if (written > 0)
+    {
+        err = nvs_commit(h);
+        if (err != ESP_OK)
+        {
+            // Nothing of this batch is known to be stored: retry all of it.
+            ESP_LOGW(TAG, "nvs_commit(%s) failed: %s", ident, esp_err_to_name(err));
+            memcpy(failed_bits, bits, sizeof(failed_bits));
+            failed_all = all;
+            written = 0;
+            bytes = 0;
+        }
+    }
+    nvs_close(h);
+
+    bool failed = failed_all;
+    for (size_t w = 0; w < NETVARS_NVS_DIRTY_WORDS; ++w)
+    {
+        if (failed_bits[w]) failed = true;
+    }
+    if (failed)
+    {
+        nvs_requeue(mngr, failed_bits, failed_all);
+    }
+
+    uint32_t dt = (uint32_t)(esp_timer_get_time() - t0);
+    netvars_nvs_stats_t *st = &mngr->stats;
+    st->keys_written += written;
+    st->writes_avoided += skipped;
+    st->bytes_written += bytes;
+    if (written > 0)
+    {
+        st->commits++;
+        st->last_commit_us = dt;
+        if (dt > st->max_commit_us) st->max_commit_us = dt;
+    }
+    ESP_LOGD(TAG, "%s: flushed %lu keys (%lu B, %lu clean%s) in %lu us", ident,
+             (unsigned long)written, (unsigned long)bytes, (unsigned long)skipped, failed ? ", some requeued" : "",
+             (unsigned long)dt);
+    return written > 0;
+}
+
+// ------------------ BEGIN Config parse benchmark ------------------
+#if CONFIG_NETVARS_PARSE_BENCH
+
+#define BENCH_COMPONENTS 15
+#define BENCH_VARS 6
+
+typedef struct {
+    bool     flag;
+    uint32_t count;
+    int32_t  offset;
+    float    gain;
+    float    scaled;
+    char     label[16];
+} bench_vars_t;
+
+// Descriptor positions sorted by json_key: count, flag, gain, label, offset, scaled.
+static const uint16_t s_bench_key_index[BENCH_VARS] = { 1, 0, 3, 5, 2, 4 };
+
+static bench_vars_t s_bench_vars[BENCH_COMPONENTS];
+static NetVars_desc_t s_bench_desc[BENCH_COMPONENTS][BENCH_VARS];
+static char s_bench_ident[BENCH_COMPONENTS][8];
+static uint32_t s_bench_allocs;
+static uint32_t s_bench_alloc_bytes;
+
+static void *bench_malloc(size_t size)
+{
+    s_bench_allocs++;
+    s_bench_alloc_bytes += (uint32_t)size;
+    return malloc(size);
+}
+
+static void bench_free(void *ptr)
+{
+    free(ptr);
+}
+
+static void bench_desc(NetVars_desc_t *d, const char *key, NetVars_type_t type, void *ptr, size_t len, int32_t scale)
+{
+    memset(d, 0, sizeof(*d));
+    d->name = key;
+    d->json_key = key;
+    d->type = type;
+    d->nvs_mode = PRJCFG_NVS_NONE;
+    d->json = true;
+    d->json_mode = NETVARS_JSON_MODE_INOUT;
+    d->json_repr = NETVARS_JSON_REPR_AUTO;
+    d->len = len;
+    d->ptr = ptr;
+    d->scale = scale;
+}
+
+static size_t bench_build(char *buf, size_t size)
+{
+    size_t len = 0;
+    len += (size_t)snprintf(buf + len, size - len, "{");
+    for (int c = 0; c < BENCH_COMPONENTS && len < size; c++)
+    {
+        bench_vars_t *v = &s_bench_vars[c];
+        snprintf(s_bench_ident[c], sizeof(s_bench_ident[c]), "Bench%02d", c);
+        bench_desc(&s_bench_desc[c][0], "flag", NETVARS_TYPE_BOOL, &v->flag, 0, 0);
+        bench_desc(&s_bench_desc[c][1], "count", NETVARS_TYPE_U32, &v->count, 0, 0);
+        bench_desc(&s_bench_desc[c][2], "offset", NETVARS_TYPE_I32, &v->offset, 0, 0);
+        bench_desc(&s_bench_desc[c][3], "gain", NETVARS_TYPE_FLOAT, &v->gain, 0, 0);
+        bench_desc(&s_bench_desc[c][4], "scaled", NETVARS_TYPE_FLOATINT, &v->scaled, 0, 100);
+        bench_desc(&s_bench_desc[c][5], "label", NETVARS_TYPE_STRING, v->label, sizeof(v->label), 0);
+        len += (size_t)snprintf(buf + len, size - len,
+                                "%s\"%s\":{\"flag\":true,\"count\":%d,\"offset\":%d,\"gain\":0.75,"
+                                "\"scaled\":%d,\"label\":\"mould %d\"}",
+                                c ? "," : "", s_bench_ident[c], 1000 + c, -c, 1234 + c, c);
+    }
+    if (len < size) len += (size_t)snprintf(buf + len, size - len, "}");
+    return len < size ? len : 0;
+}
+
+void NetVars_config_parse_benchmark(uint32_t messages)
+{
+    char *doc = malloc(2048);
+    if (!doc) return;
+    size_t doc_len = bench_build(doc, 2048);
+    if (doc_len == 0 || messages == 0)
+    {
+        free(doc);
+        return;
+    }
+
+    cJSON_Hooks hooks = { .malloc_fn = bench_malloc, .free_fn = bench_free };
+    cJSON_InitHooks(&hooks);
+
+    // Before: every component callback parses the whole message on its own.
+    s_bench_allocs = 0;
+    s_bench_alloc_bytes = 0;
+    int64_t t0 = esp_timer_get_time();
+    for (uint32_t m = 0; m < messages; m++)
+    {
+        for (int c = 0; c < BENCH_COMPONENTS; c++)
+        {
+            (void)NetVars_parse_json_component_data(s_bench_ident[c], s_bench_desc[c], BENCH_VARS, doc);
+        }
+    }
+    uint32_t old_us = (uint32_t)(esp_timer_get_time() - t0);
+    uint32_t old_allocs = s_bench_allocs;
+    uint32_t old_bytes = s_bench_alloc_bytes;
+
+    // After: one tree shared by every *_parse_json_root().
+    s_bench_allocs = 0;
+    s_bench_alloc_bytes = 0;
+    t0 = esp_timer_get_time();
+    for (uint32_t m = 0; m < messages; m++)
+    {
+        cJSON *root = cJSON_ParseWithLength(doc, doc_len);
+        if (!root) break;
+        for (int c = 0; c < BENCH_COMPONENTS; c++)
+        {
+            (void)NetVars_parse_json_component_indexed(s_bench_ident[c], s_bench_desc[c], BENCH_VARS,
+                                                       s_bench_key_index, BENCH_VARS, root, NULL);
+        }
+        cJSON_Delete(root);
+    }
+    uint32_t new_us = (uint32_t)(esp_timer_get_time() - t0);
+
+    cJSON_InitHooks(NULL);
+    free(doc);
+
+    ESP_LOGI(TAG, "bench: %u-byte message, %d components, %lu runs", (unsigned)doc_len, BENCH_COMPONENTS,
+             (unsigned long)messages);
+    ESP_LOGI(TAG, "bench: per-component cJSON_Parse: %lu us/msg, %lu allocs/msg, %lu bytes/msg",
+             (unsigned long)(old_us / messages), (unsigned long)(old_allocs / messages),
+             (unsigned long)(old_bytes / messages));
+    ESP_LOGI(TAG, "bench: shared cJSON_ParseWithLength: %lu us/msg, %lu allocs/msg, %lu bytes/msg",
+             (unsigned long)(new_us / messages), (unsigned long)(s_bench_allocs / messages),
+             (unsigned long)(s_bench_alloc_bytes / messages));
+}
+
+#else
+
+void NetVars_config_parse_benchmark(uint32_t messages)
+{
+    (void)messages;
+}
+
+#endif
+// ------------------ END   Config parse benchmark ------------------
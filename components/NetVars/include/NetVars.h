@@ -11,6 +11,7 @@ extern "C" {
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #include <nvs.h>
+#include "sdkconfig.h"
 
 // ------------------ BEGIN Return code ------------------
 typedef enum {
@@ -74,10 +75,28 @@ typedef struct {
 
 // ------------------ END   Datatypes ------------------
 
+#ifndef CONFIG_NETVARS_NVS_MAX_TRACKED
+#define CONFIG_NETVARS_NVS_MAX_TRACKED 64
+#endif
+#define NETVARS_NVS_DIRTY_WORDS ((CONFIG_NETVARS_NVS_MAX_TRACKED + 31) / 32)
+
+typedef struct {
+    uint32_t commits;        // successful nvs_commit() calls issued by spin
+    uint32_t keys_written;   // keys set and committed
+    uint32_t writes_avoided; // NVS-backed keys skipped because they were clean
+    uint32_t bytes_written;  // payload bytes handed to nvs_set_*
+    uint32_t last_commit_us; // open + writes + commit of the latest flush
+    uint32_t max_commit_us;
+} netvars_nvs_stats_t;
+
 typedef struct {
     SemaphoreHandle_t mutex;
     bool dirty;
-    TickType_t dirty_since;
+    bool dirty_all;          // untracked change: rewrite every key
+    TickType_t dirty_since;  // last change (debounce)
+    TickType_t dirty_first;  // first change of the pending batch
+    uint32_t dirty_bits[NETVARS_NVS_DIRTY_WORDS];
+    netvars_nvs_stats_t stats;
 } netvars_nvs_mgr_t;
 
 void NetVars_nvs_load(const NetVars_desc_t netvars_desc[], const size_t netvars_count, nvs_handle_t h);
@@ -91,8 +110,69 @@ void NetVars_append_json_component(const char *ident, const NetVars_desc_t netva
 bool NetVars_parse_json_component(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count, cJSON *root);
 bool NetVars_parse_json_component_data(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count, const char *data);
 
+// Same as above, but members are looked up by binary search in `key_index`:
+// the descriptor positions sorted by json_key, as emitted by gen_netvars.py
+// into <Module>_netvars_index_fragment.c_. A NULL index falls back to the
+// linear scan. With a non-NULL `mngr`, every NVS-backed descriptor that
+// changed is marked dirty individually (see NetVars_nvs_spin_component()).
+bool NetVars_parse_json_dict_indexed(const NetVars_desc_t netvars_desc[], const size_t netvars_count,
+                                     const uint16_t key_index[], const size_t key_index_count, cJSON *root,
+                                     netvars_nvs_mgr_t *mngr);
+bool NetVars_parse_json_component_indexed(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count,
+                                          const uint16_t key_index[], const size_t key_index_count, cJSON *root,
+                                          netvars_nvs_mgr_t *mngr);
+// True if `key_index` lists every descriptor with a json_key exactly once,
+// sorted as the lookup above expects. Logs the first mismatch otherwise: an
+// index fragment not regenerated after netvars.csv changed.
+bool NetVars_key_index_check(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count,
+                             const uint16_t key_index[], const size_t key_index_count);
+
+// ------------------ BEGIN Streaming JSON writer ------------------
+// Serialises descriptor tables straight into a caller buffer. The output is
+// byte-identical to NetVars_append_json() + cJSON_PrintUnformatted(), but no
+// tree is built and nothing is allocated. With a flush callback the buffer is
+// handed over every time it fills, so a small buffer can stream any document;
+// without one, output that does not fit sets `overflow`.
+#define NETVARS_JW_MAX_DEPTH 8
+
+typedef void (*NetVars_jw_flush_t)(const char *data, size_t len, void *ctx);
+
+typedef struct {
+    char               *buf;
+    size_t              size;      // capacity, one byte is kept for the NUL
+    size_t              len;       // bytes pending in buf
+    size_t              total;     // bytes emitted since init
+    NetVars_jw_flush_t  flush;
+    void               *ctx;
+    uint8_t             depth;
+    uint8_t             has_items; // bit n: object at depth n has a member
+    bool                overflow;
+} NetVars_json_writer_t;
+
+void NetVars_jw_init(NetVars_json_writer_t *w, char *buf, size_t size, NetVars_jw_flush_t flush, void *ctx);
+void NetVars_jw_begin_object(NetVars_json_writer_t *w, const char *key);
+void NetVars_jw_end_object(NetVars_json_writer_t *w);
+// Flushes what is pending and NUL-terminates buf. Returns false on overflow.
+bool NetVars_jw_finish(NetVars_json_writer_t *w);
+
+void NetVars_write_json(const NetVars_desc_t netvars_desc[], const size_t netvars_count, NetVars_json_writer_t *w);
+void NetVars_write_json_component(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count, NetVars_json_writer_t *w);
+// ------------------ END   Streaming JSON writer ------------------
+
 void NetVars_nvs_set_dirty(netvars_nvs_mgr_t *mngr);
+// Marks only descriptor `index` of the component for the next flush.
+void NetVars_nvs_set_dirty_index(netvars_nvs_mgr_t *mngr, size_t index);
 bool NetVars_nvs_spin(netvars_nvs_mgr_t *mngr);
+// Debounced flush: once the batch is due, writes only the dirty keys of the
+// component (all of them after NetVars_nvs_set_dirty()) and commits once.
+// Returns true if a commit was issued.
+bool NetVars_nvs_spin_component(const char *ident, const NetVars_desc_t netvars_desc[], const size_t netvars_count,
+                                netvars_nvs_mgr_t *mngr);
+
+// CONFIG_NETVARS_PARSE_BENCH: parses a synthetic config message `messages`
+// times, once per component (old path) and once for all of them (new path),
+// and logs time, cJSON allocations and bytes per message. No-op when disabled.
+void NetVars_config_parse_benchmark(uint32_t messages);
 
 #ifdef __cplusplus
 }
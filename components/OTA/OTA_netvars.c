@@ -1,3 +1,4 @@
+#include <assert.h>
 #include <string.h>
 #include <OTA.h>
 #include "OTA_netvars.h"
@@ -10,6 +11,13 @@ const NetVars_desc_t OTA_netvars_desc[] = {
 
 const size_t OTA_netvars_count = sizeof(OTA_netvars_desc) / sizeof(OTA_netvars_desc[0]);
 
+#include "OTA_netvars_index_fragment.c_"
+
+const size_t OTA_netvars_key_index_count = sizeof(OTA_netvars_key_index) / sizeof(OTA_netvars_key_index[0]);
+
+_Static_assert(sizeof(OTA_netvars_desc) / sizeof(OTA_netvars_desc[0]) == OTA_NETVARS_POS_COUNT,
+               "OTA_netvars_index_fragment.c_ is out of date; rerun poris/gen_netvars.py OTA");
+
 void OTA_netvars_append_json(cJSON *root)
 {
     if (OTA_netvars_count > 0)
@@ -18,11 +26,21 @@ void OTA_netvars_append_json(cJSON *root)
     }
 }
 
+void OTA_netvars_write_json(NetVars_json_writer_t *w)
+{
+    if (OTA_netvars_count > 0)
+    {
+        NetVars_write_json_component("OTA", OTA_netvars_desc, OTA_netvars_count, w);
+    }
+}
+
 bool OTA_netvars_parse_json_dict(cJSON *root)
 {
     if (OTA_netvars_count > 0)
     {
-        return NetVars_parse_json_dict(OTA_netvars_desc, OTA_netvars_count, root);
+        return NetVars_parse_json_dict_indexed(OTA_netvars_desc, OTA_netvars_count,
+                                               OTA_netvars_key_index, OTA_netvars_key_index_count, root,
+                                               &OTA_nvs_mgr);
     }
     else
     {
@@ -32,6 +50,10 @@ bool OTA_netvars_parse_json_dict(cJSON *root)
 
 void OTA_netvars_nvs_load(void)
 {
+    // Runs once at component init: a stale index fragment would make lookups
+    // miss keys silently, so debug builds stop here instead.
+    assert(NetVars_key_index_check("OTA", OTA_netvars_desc, OTA_netvars_count,
+                                   OTA_netvars_key_index, OTA_netvars_key_index_count));
     if (OTA_netvars_count > 0)
     {
         NetVars_nvs_load_component("OTA", OTA_netvars_desc, OTA_netvars_count);
@@ -46,14 +68,26 @@ void OTA_netvars_nvs_save(void)
     }
 }
 
-void OTA_config_parse_json(const char *data)
+void OTA_config_parse_json_root(cJSON *root)
 {
     if (OTA_netvars_count > 0)
     {
-        bool nvs_cfg_changed = NetVars_parse_json_component_data("OTA", OTA_netvars_desc, OTA_netvars_count, data);
-        if (nvs_cfg_changed)
+        // Changed NVS-backed descriptors are marked dirty one by one.
+        (void)NetVars_parse_json_component_indexed("OTA", OTA_netvars_desc, OTA_netvars_count,
+                                                   OTA_netvars_key_index, OTA_netvars_key_index_count, root,
+                                                   &OTA_nvs_mgr);
+    }
+}
+
+void OTA_config_parse_json(const char *data)
+{
+    if (OTA_netvars_count > 0 && data)
+    {
+        cJSON *root = cJSON_Parse(data);
+        if (root)
         {
-            OTA_nvs_set_dirty();
+            OTA_config_parse_json_root(root);
+            cJSON_Delete(root);
         }
     }
 }
@@ -65,8 +99,13 @@ void OTA_nvs_set_dirty(void)
 
 void OTA_nvs_spin(void)
 {
-    if (NetVars_nvs_spin(&OTA_nvs_mgr))
+    if (OTA_netvars_count > 0)
     {
-        OTA_netvars_nvs_save();
+        (void)NetVars_nvs_spin_component("OTA", OTA_netvars_desc, OTA_netvars_count, &OTA_nvs_mgr);
     }
 }
+
+const netvars_nvs_stats_t *OTA_nvs_stats(void)
+{
+    return &OTA_nvs_mgr.stats;
+}
@@ -16,12 +16,16 @@ void OTA_netvars_nvs_load(void);
 void OTA_netvars_nvs_save(void);
 
 void OTA_netvars_append_json(cJSON *root);
+void OTA_netvars_write_json(NetVars_json_writer_t *w);
 bool OTA_netvars_parse_json_dict(cJSON *root);
 
+// Apply this component's section of an already parsed config document.
+void OTA_config_parse_json_root(cJSON *root);
 void OTA_config_parse_json(const char *data);
 
 void OTA_nvs_set_dirty(void);
 void OTA_nvs_spin(void);
+const netvars_nvs_stats_t *OTA_nvs_stats(void);
 
 #ifdef __cplusplus
 }
@@ -7,12 +7,19 @@
 #include <sdkconfig.h>
 // END   --- SDK config section---
 
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+#include <stdatomic.h>
+#endif
+
 // BEGIN --- FreeRTOS headers section ---
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #if CONFIG_PPINJECTORUI_USE_THREAD
 #include <freertos/semphr.h>
 #endif
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+#include <freertos/queue.h>
+#endif
 // END   --- FreeRTOS headers section ---
 
 // BEGIN --- ESP-IDF headers section ---
@@ -27,10 +34,14 @@
 
 // BEGIN --- Other project modules section ---
 #include <TouchScreen.h>
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+#include <lvgl.h>
+#endif
 // END   --- Other project modules section ---
 
 // BEGIN --- Self-includes section ---
 #include "PPInjectorUI.h"
+#include "PPInjectorUI_binproto.h"
 #include "PPInjectorUI_netvars.h"
 // END --- Self-includes section ---
 
@@ -52,6 +63,10 @@ extern void PPInjectorUI_comms_inject_line_bridge(const char *line);
 extern void PPInjectorUI_comms_set_tx_callback_bridge(void (*cb)(const char *,
                                                                  void *),
                                                       void *ctx);
+extern void PPInjectorUI_comms_inject_frame_bridge(const uint8_t *frame,
+                                                   size_t len);
+extern void PPInjectorUI_comms_set_tx_bytes_callback_bridge(
+    void (*cb)(const uint8_t *, size_t, void *), void *ctx);
 extern void PPInjectorUI_storage_selftest_bridge(void);
 extern void PPInjectorUI_storage_read_dump_bridge(void);
 // END   --- C++ bridge symbols ---
@@ -59,10 +74,39 @@ extern void PPInjectorUI_storage_read_dump_bridge(void);
 static bool s_ui_initialized = false;
 static uint32_t s_spin_log_last_ms = 0;
 
+#if CONFIG_PPINJECTORUI_BINARY_PROTOCOL
+#define PPINJECTORUI_ALLOW_BINARY true
+#else
+#define PPINJECTORUI_ALLOW_BINARY false
+#endif
+
 #if CONFIG_PPINJECTORUI_UART_ENABLE
 static bool s_uart_inited = false;
-static char s_uart_line_buf[256];
-static size_t s_uart_line_len = 0;
+#if !CONFIG_PPINJECTORUI_UART_RX_TASK
+static PPInjectorUI_link_framer_t s_uart_framer;
+#endif
+#endif
+
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+// Lines (and, once binary framing is negotiated, frames) taken by the RX task
+// are handed over through a single-producer / single-consumer ring: the RX
+// task only advances head, the consumer (spin before the UI exists, then an
+// LVGL timer) only advances tail.
+#define PPINJECTORUI_UART_LINE_MAX PPINJECTORUI_LINK_LINE_MAX
+#define PPINJECTORUI_UART_LINE_DEPTH CONFIG_PPINJECTORUI_UART_LINE_QUEUE_DEPTH
+typedef struct {
+  uint16_t len;
+  bool binary;
+  char data[PPINJECTORUI_UART_LINE_MAX];
+} PPInjectorUI_uart_slot_t;
+static QueueHandle_t s_uart_event_queue = NULL;
+static TaskHandle_t s_uart_rx_task = NULL;
+static PPInjectorUI_uart_slot_t s_uart_slots[PPINJECTORUI_UART_LINE_DEPTH];
+static PPInjectorUI_link_framer_t s_uart_rx_framer;
+static atomic_uint s_uart_line_head = 0;
+static atomic_uint s_uart_line_tail = 0;
+static PPInjectorUI_uart_rx_stats_t s_uart_rx_stats = {0};
+static lv_timer_t *s_uart_drain_timer = NULL;
 #endif
 
 #if CONFIG_PPINJECTORUI_UART_ENABLE
@@ -78,6 +122,244 @@ static void PPInjectorUI_uart_tx_callback(const char *line, void *ctx) {
   ESP_LOGD(TAG, "TX> %s", line);
 }
 
+#if CONFIG_PPINJECTORUI_BINARY_PROTOCOL
+static void PPInjectorUI_uart_tx_bytes_callback(const uint8_t *data, size_t len,
+                                                void *ctx) {
+  (void)ctx;
+  if (!s_uart_inited || !data || len == 0) {
+    return;
+  }
+  uart_write_bytes(CONFIG_PPINJECTORUI_UART_PORT, data, len);
+}
+#endif
+
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+static void PPInjectorUI_uart_discard(int port, size_t len) {
+  uint8_t tmp[64];
+  while (len > 0) {
+    size_t chunk = len < sizeof(tmp) ? len : sizeof(tmp);
+    int got = uart_read_bytes(port, tmp, chunk, pdMS_TO_TICKS(10));
+    if (got <= 0) {
+      break;
+    }
+    len -= (size_t)got;
+  }
+}
+
+static void PPInjectorUI_uart_rx_flush(int port) {
+  uart_flush_input(port);
+  uart_pattern_queue_reset(port, CONFIG_PPINJECTORUI_UART_EVENT_QUEUE_LEN);
+  xQueueReset(s_uart_event_queue);
+  PPInjectorUI_link_framer_set_binary(&s_uart_rx_framer,
+                                      s_uart_rx_framer.binary);
+  s_uart_rx_stats.overruns++;
+}
+
+// Reserves the next free ring slot, or counts a drop if the UI is behind.
+static PPInjectorUI_uart_slot_t *PPInjectorUI_uart_slot_claim(void) {
+  const unsigned head =
+      atomic_load_explicit(&s_uart_line_head, memory_order_relaxed);
+  const unsigned tail =
+      atomic_load_explicit(&s_uart_line_tail, memory_order_acquire);
+  if (head - tail >= PPINJECTORUI_UART_LINE_DEPTH) {
+    s_uart_rx_stats.dropped++;
+    return NULL;
+  }
+  return &s_uart_slots[head % PPINJECTORUI_UART_LINE_DEPTH];
+}
+
+static void PPInjectorUI_uart_slot_publish(bool binary) {
+  const unsigned head =
+      atomic_load_explicit(&s_uart_line_head, memory_order_relaxed);
+  const unsigned tail =
+      atomic_load_explicit(&s_uart_line_tail, memory_order_acquire);
+  atomic_store_explicit(&s_uart_line_head, head + 1, memory_order_release);
+  if (binary) {
+    s_uart_rx_stats.frames++;
+  } else {
+    s_uart_rx_stats.lines++;
+  }
+  const uint32_t depth = (head + 1) - tail;
+  if (depth > s_uart_rx_stats.max_depth) {
+    s_uart_rx_stats.max_depth = depth;
+  }
+}
+
+static void PPInjectorUI_uart_rx_enter_binary(int port);
+
+// Pulls one '\n'-terminated line out of the driver buffer straight into the
+// next free ring slot, or discards it if the ring is full or the line does
+// not fit.
+static void PPInjectorUI_uart_rx_take_line(int port) {
+  const int pos = uart_pattern_pop_pos(port);
+  if (pos < 0) {
+    // Pattern position queue overflowed: line boundaries are lost.
+    PPInjectorUI_uart_rx_flush(port);
+    return;
+  }
+
+  const size_t len = (size_t)pos + 1; // include the '\n'
+  if (len >= PPINJECTORUI_UART_LINE_MAX) {
+    PPInjectorUI_uart_discard(port, len);
+    s_uart_rx_stats.oversize++;
+    return;
+  }
+
+  PPInjectorUI_uart_slot_t *slot = PPInjectorUI_uart_slot_claim();
+  if (!slot) {
+    PPInjectorUI_uart_discard(port, len);
+    return;
+  }
+
+  int got = uart_read_bytes(port, slot->data, len, pdMS_TO_TICKS(10));
+  if (got != (int)len) {
+    // The pattern position says the whole line is buffered. Whatever was not
+    // read would otherwise be taken for the start of the next line.
+    PPInjectorUI_uart_discard(port, got > 0 ? len - (size_t)got : len);
+    s_uart_rx_stats.short_reads++;
+    return;
+  }
+  size_t n = (size_t)got;
+  while (n > 0 && (slot->data[n - 1] == '\n' || slot->data[n - 1] == '\r')) {
+    n--;
+  }
+  if (n == 0) {
+    return;
+  }
+  slot->data[n] = '\0';
+  slot->len = (uint16_t)n;
+  slot->binary = false;
+
+  // Decide before publishing: the slot belongs to the consumer afterwards.
+  const bool ack = PPINJECTORUI_ALLOW_BINARY &&
+                   strcmp(slot->data, PPINJECTORUI_PROTO_ACK) == 0;
+  PPInjectorUI_uart_slot_publish(false);
+  if (ack) {
+    PPInjectorUI_uart_rx_enter_binary(port);
+  }
+}
+
+// Binary mode: '\n' pattern detection is off and the RX task frames the raw
+// stream in software on 0x00, from UART_DATA events.
+static void PPInjectorUI_uart_rx_on_line(const char *line, void *ctx) {
+  (void)ctx;
+  PPInjectorUI_uart_slot_t *slot = PPInjectorUI_uart_slot_claim();
+  if (!slot) {
+    return;
+  }
+  const size_t n = strlen(line);
+  memcpy(slot->data, line, n + 1);
+  slot->len = (uint16_t)n;
+  slot->binary = false;
+  PPInjectorUI_uart_slot_publish(false);
+}
+
+static void PPInjectorUI_uart_rx_on_frame(const uint8_t *frame, size_t len,
+                                          void *ctx) {
+  (void)ctx;
+  PPInjectorUI_uart_slot_t *slot = PPInjectorUI_uart_slot_claim();
+  if (!slot) {
+    return;
+  }
+  memcpy(slot->data, frame, len);
+  slot->len = (uint16_t)len;
+  slot->binary = true;
+  PPInjectorUI_uart_slot_publish(true);
+}
+
+static void PPInjectorUI_uart_rx_on_mode(bool binary, void *ctx) {
+  (void)ctx;
+  const int port = CONFIG_PPINJECTORUI_UART_PORT;
+  if (binary) {
+    uart_disable_pattern_det_intr(port);
+    ESP_LOGI(TAG, "UART link switched to binary frames");
+  } else {
+    // Peer stopped sending frames; whatever is still buffered ends up in
+    // the first line after pattern detection resumes.
+    uart_enable_pattern_det_baud_intr(port, '\n', 1, 9, 0, 0);
+    ESP_LOGW(TAG, "UART binary framing lost, back to text lines");
+  }
+  uart_pattern_queue_reset(port, CONFIG_PPINJECTORUI_UART_EVENT_QUEUE_LEN);
+}
+
+static const PPInjectorUI_link_sink_t s_uart_rx_sink = {
+    .on_line = PPInjectorUI_uart_rx_on_line,
+    .on_frame = PPInjectorUI_uart_rx_on_frame,
+    .on_mode = PPInjectorUI_uart_rx_on_mode,
+    .ctx = NULL,
+};
+
+static void PPInjectorUI_uart_rx_read_binary(int port) {
+  uint8_t tmp[64];
+  size_t avail = 0;
+  uart_get_buffered_data_len(port, &avail);
+  while (avail > 0 && s_uart_rx_framer.binary) {
+    size_t chunk = avail < sizeof(tmp) ? avail : sizeof(tmp);
+    int got = uart_read_bytes(port, tmp, chunk, 0);
+    if (got <= 0) {
+      break;
+    }
+    PPInjectorUI_link_framer_push(&s_uart_rx_framer, tmp, (size_t)got,
+                                  &s_uart_rx_sink);
+    avail -= (size_t)got;
+  }
+}
+
+static void PPInjectorUI_uart_rx_enter_binary(int port) {
+  PPInjectorUI_link_framer_set_binary(&s_uart_rx_framer, true);
+  PPInjectorUI_uart_rx_on_mode(true, NULL);
+  // Frames may already be queued right behind the acknowledge line.
+  PPInjectorUI_uart_rx_read_binary(port);
+}
+
+static void PPInjectorUI_uart_rx_task(void *arg) {
+  (void)arg;
+  const int port = CONFIG_PPINJECTORUI_UART_PORT;
+  uart_event_t event;
+
+  while (true) {
+    if (xQueueReceive(s_uart_event_queue, &event, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    switch (event.type) {
+    case UART_PATTERN_DET:
+      if (s_uart_rx_framer.binary) {
+        uart_pattern_pop_pos(port); // stale, raised before the switch
+      } else {
+        PPInjectorUI_uart_rx_take_line(port);
+      }
+      break;
+    case UART_DATA:
+      if (s_uart_rx_framer.binary) {
+        PPInjectorUI_uart_rx_read_binary(port);
+      }
+      break;
+    case UART_FIFO_OVF:
+    case UART_BUFFER_FULL:
+      ESP_LOGW(TAG, "UART RX overrun (event=%d), flushing", (int)event.type);
+      PPInjectorUI_uart_rx_flush(port);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+static void PPInjectorUI_uart_rx_task_start(void) {
+  if (s_uart_rx_task) {
+    return;
+  }
+  BaseType_t ok = xTaskCreate(PPInjectorUI_uart_rx_task, "PPInjectorUI_rx",
+                              CONFIG_PPINJECTORUI_UART_RX_TASK_STACK, NULL,
+                              CONFIG_PPINJECTORUI_UART_RX_TASK_PRIO,
+                              &s_uart_rx_task);
+  if (ok != pdPASS) {
+    s_uart_rx_task = NULL;
+    ESP_LOGE(TAG, "UART RX task creation failed");
+  }
+}
+#endif
+
 static void PPInjectorUI_uart_init_once(void) {
   if (s_uart_inited) {
     return;
@@ -97,16 +379,35 @@ static void PPInjectorUI_uart_init_once(void) {
   ESP_ERROR_CHECK(uart_set_pin(port, CONFIG_PPINJECTORUI_UART_TX_GPIO,
                                CONFIG_PPINJECTORUI_UART_RX_GPIO,
                                UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+  ESP_ERROR_CHECK(uart_driver_install(
+      port, CONFIG_PPINJECTORUI_UART_RX_BUF_SIZE,
+      CONFIG_PPINJECTORUI_UART_TX_BUF_SIZE,
+      CONFIG_PPINJECTORUI_UART_EVENT_QUEUE_LEN, &s_uart_event_queue, 0));
+  ESP_ERROR_CHECK(uart_enable_pattern_det_baud_intr(port, '\n', 1, 9, 0, 0));
+  ESP_ERROR_CHECK(
+      uart_pattern_queue_reset(port, CONFIG_PPINJECTORUI_UART_EVENT_QUEUE_LEN));
+  PPInjectorUI_link_framer_init(&s_uart_rx_framer, PPINJECTORUI_ALLOW_BINARY);
+#else
   ESP_ERROR_CHECK(
       uart_driver_install(port, CONFIG_PPINJECTORUI_UART_RX_BUF_SIZE,
                           CONFIG_PPINJECTORUI_UART_TX_BUF_SIZE, 0, NULL, 0));
+  PPInjectorUI_link_framer_init(&s_uart_framer, PPINJECTORUI_ALLOW_BINARY);
+#endif
 
-  s_uart_line_len = 0;
   s_uart_inited = true;
   PPInjectorUI_set_machine_tx_callback(PPInjectorUI_uart_tx_callback, NULL);
+#if CONFIG_PPINJECTORUI_BINARY_PROTOCOL
+  PPInjectorUI_set_machine_tx_bytes_callback(PPInjectorUI_uart_tx_bytes_callback,
+                                             NULL);
+#endif
   ESP_LOGI(TAG, "UART ready: uart=%d tx=%d rx=%d baud=%d", port,
            CONFIG_PPINJECTORUI_UART_TX_GPIO, CONFIG_PPINJECTORUI_UART_RX_GPIO,
            CONFIG_PPINJECTORUI_UART_BAUD);
+
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+  PPInjectorUI_uart_rx_task_start();
+#endif
 }
 
 static inline void PPInjectorUI_uart_handle_line(const char *line) {
@@ -117,35 +418,91 @@ static inline void PPInjectorUI_uart_handle_line(const char *line) {
   PPInjectorUI_feed_machine_line(line);
 }
 
+#if !CONFIG_PPINJECTORUI_UART_RX_TASK
+static void PPInjectorUI_uart_on_line(const char *line, void *ctx) {
+  (void)ctx;
+  PPInjectorUI_uart_handle_line(line);
+}
+
+static void PPInjectorUI_uart_on_frame(const uint8_t *frame, size_t len,
+                                       void *ctx) {
+  (void)ctx;
+  PPInjectorUI_feed_machine_frame(frame, len);
+}
+
+static void PPInjectorUI_uart_on_mode(bool binary, void *ctx) {
+  (void)ctx;
+  if (binary) {
+    ESP_LOGI(TAG, "UART link switched to binary frames");
+  } else {
+    ESP_LOGW(TAG, "UART binary framing lost, back to text lines");
+  }
+}
+
 static void PPInjectorUI_uart_poll(void) {
   if (!s_uart_inited) {
     return;
   }
 
+  static const PPInjectorUI_link_sink_t sink = {
+      .on_line = PPInjectorUI_uart_on_line,
+      .on_frame = PPInjectorUI_uart_on_frame,
+      .on_mode = PPInjectorUI_uart_on_mode,
+      .ctx = NULL,
+  };
   const int port = CONFIG_PPINJECTORUI_UART_PORT;
   uint8_t rx_tmp[64];
   int got = 0;
 
   while ((got = uart_read_bytes(port, rx_tmp, sizeof(rx_tmp), 0)) > 0) {
-    for (int i = 0; i < got; ++i) {
-      const char c = (char)rx_tmp[i];
-      if (c == '\n' || c == '\r') {
-        if (s_uart_line_len > 0) {
-          s_uart_line_buf[s_uart_line_len] = '\0';
-          PPInjectorUI_uart_handle_line(s_uart_line_buf);
-          s_uart_line_len = 0;
-        }
-        continue;
-      }
+    const uint32_t overflows = s_uart_framer.overflows;
+    PPInjectorUI_link_framer_push(&s_uart_framer, rx_tmp, (size_t)got, &sink);
+    if (s_uart_framer.overflows != overflows && !s_uart_framer.binary) {
+      ESP_LOGW(TAG, "UART RX line overflow, dropping partial line");
+    }
+  }
+}
+#endif
+#endif
 
-      if (s_uart_line_len < sizeof(s_uart_line_buf) - 1) {
-        s_uart_line_buf[s_uart_line_len++] = c;
-      } else {
-        ESP_LOGW(TAG, "UART RX line overflow, dropping partial line");
-        s_uart_line_len = 0;
-      }
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+static int PPInjectorUI_uart_drain_lines(void) {
+  unsigned tail = atomic_load_explicit(&s_uart_line_tail, memory_order_relaxed);
+  const unsigned head =
+      atomic_load_explicit(&s_uart_line_head, memory_order_acquire);
+  int count = 0;
+  while (tail != head) {
+    const PPInjectorUI_uart_slot_t *slot =
+        &s_uart_slots[tail % PPINJECTORUI_UART_LINE_DEPTH];
+    if (slot->binary) {
+      PPInjectorUI_feed_machine_frame((const uint8_t *)slot->data, slot->len);
+    } else {
+      PPInjectorUI_uart_handle_line(slot->data);
     }
+    tail++;
+    count++;
+    atomic_store_explicit(&s_uart_line_tail, tail, memory_order_release);
+  }
+  return count;
+}
+
+// Runs inside lv_timer_handler(), i.e. in the LVGL task with the LVGL lock
+// held, so fresh lines reach the screen on the next refresh rather than on
+// the next spin().
+static void PPInjectorUI_uart_drain_timer_cb(lv_timer_t *timer) {
+  (void)timer;
+  if (PPInjectorUI_uart_drain_lines() > 0) {
+    PPInjectorUI_ui_tick_bridge();
+  }
+}
+
+void PPInjectorUI_get_uart_rx_stats(PPInjectorUI_uart_rx_stats_t *dst) {
+  if (!dst) {
+    return;
   }
+  memcpy(dst, &s_uart_rx_stats, sizeof(*dst));
+  dst->depth = atomic_load_explicit(&s_uart_line_head, memory_order_relaxed) -
+               atomic_load_explicit(&s_uart_line_tail, memory_order_relaxed);
 }
 #endif
 
@@ -161,6 +518,11 @@ static void PPInjectorUI_try_init_ui(void) {
   }
 
   PPInjectorUI_ui_init_bridge();
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+  // From here on the LVGL task is the only consumer of the line ring.
+  s_uart_drain_timer =
+      lv_timer_create(PPInjectorUI_uart_drain_timer_cb, LV_DEF_REFR_PERIOD, NULL);
+#endif
   TouchScreen_lvgl_unlock();
   s_ui_initialized = true;
   ESP_LOGI(TAG, "EEZ UI initialized");
@@ -359,7 +721,11 @@ static
     return PPInjectorUI_ret_ok;
   }
 
-#if CONFIG_PPINJECTORUI_UART_ENABLE
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+  if (!s_uart_drain_timer) {
+    PPInjectorUI_uart_drain_lines();
+  }
+#elif CONFIG_PPINJECTORUI_UART_ENABLE
   PPInjectorUI_uart_poll();
 #endif
 
@@ -380,6 +746,18 @@ static
   if ((now_ms - s_spin_log_last_ms) >= 1000U) {
     s_spin_log_last_ms = now_ms;
     ESP_LOGI(TAG, "UI Heartbeat (1s)");
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+    ESP_LOGD(TAG,
+             "UART RX lines=%u frames=%u overruns=%u dropped=%u "
+             "oversize=%u short=%u max_depth=%u",
+             (unsigned)s_uart_rx_stats.lines,
+             (unsigned)s_uart_rx_stats.frames,
+             (unsigned)s_uart_rx_stats.overruns,
+             (unsigned)s_uart_rx_stats.dropped,
+             (unsigned)s_uart_rx_stats.oversize,
+             (unsigned)s_uart_rx_stats.short_reads,
+             (unsigned)s_uart_rx_stats.max_depth);
+#endif
   }
 
   return PPInjectorUI_ret_ok;
@@ -421,6 +799,18 @@ void PPInjectorUI_set_machine_tx_callback(PPInjectorUI_machine_tx_cb_t cb,
   PPInjectorUI_comms_set_tx_callback_bridge(cb, ctx);
 }
 
+void PPInjectorUI_feed_machine_frame(const uint8_t *frame, size_t len) {
+  if (!frame || len == 0) {
+    return;
+  }
+  PPInjectorUI_comms_inject_frame_bridge(frame, len);
+}
+
+void PPInjectorUI_set_machine_tx_bytes_callback(
+    PPInjectorUI_machine_tx_bytes_cb_t cb, void *ctx) {
+  PPInjectorUI_comms_set_tx_bytes_callback_bridge(cb, ctx);
+}
+
 void PPInjectorUI_request_system_action(PPInjectorUI_system_action_t action) {
   if (action <= PPInjectorUI_system_action_none) {
     return;
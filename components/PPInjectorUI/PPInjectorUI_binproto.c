@@ -0,0 +1,215 @@
+// BEGIN --- Standard C headers section ---
+#include <string.h>
+// END   --- Standard C headers section ---
+
+// BEGIN --- Self-includes section ---
+#include "PPInjectorUI_binproto.h"
+// END --- Self-includes section ---
+
+uint16_t PPInjectorUI_crc16(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int b = 0; b < 8; ++b) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021)
+                           : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+size_t PPInjectorUI_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst,
+                                size_t dst_len) {
+  if (!src || !dst || dst_len == 0) {
+    return 0;
+  }
+  size_t code_idx = 0;
+  size_t out = 1;
+  uint8_t code = 1;
+
+  for (size_t i = 0; i < len; ++i) {
+    if (src[i] != 0) {
+      if (out >= dst_len) {
+        return 0;
+      }
+      dst[out++] = src[i];
+      code++;
+    }
+    if (src[i] == 0 || code == 0xFF) {
+      dst[code_idx] = code;
+      code = 1;
+      code_idx = out;
+      if (out >= dst_len) {
+        return 0;
+      }
+      out++;
+    }
+  }
+  dst[code_idx] = code;
+  return out;
+}
+
+size_t PPInjectorUI_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst,
+                                size_t dst_len) {
+  if (!src || !dst) {
+    return 0;
+  }
+  size_t in = 0;
+  size_t out = 0;
+
+  while (in < len) {
+    uint8_t code = src[in++];
+    if (code == 0 || in + (size_t)(code - 1) > len) {
+      return 0;
+    }
+    for (uint8_t i = 1; i < code; ++i) {
+      if (out >= dst_len || src[in] == 0) {
+        return 0;
+      }
+      dst[out++] = src[in++];
+    }
+    if (code != 0xFF && in < len) {
+      if (out >= dst_len) {
+        return 0;
+      }
+      dst[out++] = 0;
+    }
+  }
+  return out;
+}
+
+size_t PPInjectorUI_binproto_encode(uint8_t type, const uint8_t *payload,
+                                    size_t payload_len, uint8_t *out,
+                                    size_t out_len) {
+  if (payload_len > PPINJECTORUI_BINPROTO_MAX_PAYLOAD || !out) {
+    return 0;
+  }
+  uint8_t raw[PPINJECTORUI_BINPROTO_MAX_PAYLOAD + 3];
+  raw[0] = type;
+  if (payload_len > 0) {
+    memcpy(&raw[1], payload, payload_len);
+  }
+  uint16_t crc = PPInjectorUI_crc16(raw, payload_len + 1);
+  PPInjectorUI_put_u16(&raw[payload_len + 1], crc);
+
+  size_t n = PPInjectorUI_cobs_encode(raw, payload_len + 3, out, out_len);
+  if (n == 0 || n >= out_len) {
+    return 0;
+  }
+  out[n++] = 0x00;
+  return n;
+}
+
+int PPInjectorUI_binproto_decode(const uint8_t *frame, size_t len,
+                                 uint8_t *type, uint8_t *payload,
+                                 size_t payload_len) {
+  uint8_t raw[PPINJECTORUI_BINPROTO_MAX_PAYLOAD + 3];
+  size_t n = PPInjectorUI_cobs_decode(frame, len, raw, sizeof(raw));
+  if (n < 3) {
+    return -1;
+  }
+  uint16_t crc = PPInjectorUI_get_u16(&raw[n - 2]);
+  if (PPInjectorUI_crc16(raw, n - 2) != crc) {
+    return -1;
+  }
+  size_t body = n - 3;
+  if (body > payload_len) {
+    return -1;
+  }
+  if (type) {
+    *type = raw[0];
+  }
+  if (body > 0) {
+    memcpy(payload, &raw[1], body);
+  }
+  return (int)body;
+}
+
+void PPInjectorUI_put_f32(uint8_t *p, float v) {
+  uint32_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  PPInjectorUI_put_u32(p, bits);
+}
+
+float PPInjectorUI_get_f32(const uint8_t *p) {
+  uint32_t bits = PPInjectorUI_get_u32(p);
+  float v;
+  memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+void PPInjectorUI_link_framer_init(PPInjectorUI_link_framer_t *f,
+                                   bool allow_binary) {
+  if (!f) {
+    return;
+  }
+  memset(f, 0, sizeof(*f));
+  f->allow_binary = allow_binary;
+}
+
+void PPInjectorUI_link_framer_set_binary(PPInjectorUI_link_framer_t *f,
+                                         bool binary) {
+  if (!f) {
+    return;
+  }
+  f->binary = binary && f->allow_binary;
+  f->len = 0;
+}
+
+static void PPInjectorUI_link_framer_switch(PPInjectorUI_link_framer_t *f,
+                                            bool binary,
+                                            const PPInjectorUI_link_sink_t *sink) {
+  PPInjectorUI_link_framer_set_binary(f, binary);
+  if (sink->on_mode) {
+    sink->on_mode(f->binary, sink->ctx);
+  }
+}
+
+void PPInjectorUI_link_framer_push(PPInjectorUI_link_framer_t *f,
+                                   const uint8_t *data, size_t len,
+                                   const PPInjectorUI_link_sink_t *sink) {
+  if (!f || !data || !sink) {
+    return;
+  }
+
+  for (size_t i = 0; i < len; ++i) {
+    const uint8_t c = data[i];
+
+    if (f->binary) {
+      if (c == 0x00) {
+        if (f->len > 0 && sink->on_frame) {
+          sink->on_frame(f->buf, f->len, sink->ctx);
+        }
+        f->len = 0;
+      } else if (f->len < PPINJECTORUI_BINPROTO_MAX_FRAME) {
+        f->buf[f->len++] = c;
+      } else {
+        f->overflows++;
+        PPInjectorUI_link_framer_switch(f, false, sink);
+      }
+      continue;
+    }
+
+    if (c == '\n' || c == '\r') {
+      if (f->len > 0) {
+        f->buf[f->len] = '\0';
+        f->len = 0;
+        const char *line = (const char *)f->buf;
+        if (sink->on_line) {
+          sink->on_line(line, sink->ctx);
+        }
+        if (f->allow_binary && strcmp(line, PPINJECTORUI_PROTO_ACK) == 0) {
+          PPInjectorUI_link_framer_switch(f, true, sink);
+        }
+      }
+      continue;
+    }
+
+    if (f->len < sizeof(f->buf) - 1) {
+      f->buf[f->len++] = c;
+    } else {
+      f->overflows++;
+      f->len = 0;
+    }
+  }
+}
@@ -1,4 +1,5 @@
 #include "PPInjectorUI_display_comms.h"
+#include "PPInjectorUI_binproto.h"
 
 #include "ui/eez-flow.h"
 #include "ui/screens.h"
@@ -7,11 +8,15 @@
 #include "ui/vars.h"
 
 #include <esp_log.h>
+#include <esp_timer.h>
+#include <sdkconfig.h>
 
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string_view>
 #include <strings.h>
 
 namespace DisplayComms {
@@ -28,10 +33,79 @@ static bool s_mock_has_temp = false;
 static float s_mock_pos = 0.0f;
 static float s_mock_temp = 0.0f;
 static char s_mock_state[24] = {0};
+static MachineState s_mock_state_id = MachineState::Unknown;
 static Status s_status_view = {};
 
+static constexpr int CHANGE_FIELD_COUNT = 7;
+static uint32_t s_generation = 0;
+static uint32_t s_field_generation[CHANGE_FIELD_COUNT] = {};
+
+static ParseStats s_parse_stats = {};
+
 static tx_callback_t s_tx_cb = nullptr;
 static void *s_tx_ctx = nullptr;
+static tx_bytes_callback_t s_tx_bytes_cb = nullptr;
+static void *s_tx_bytes_ctx = nullptr;
+
+#if CONFIG_PPINJECTORUI_BINARY_PROTOCOL
+static constexpr bool BINARY_PROTOCOL_ENABLED = true;
+#else
+static constexpr bool BINARY_PROTOCOL_ENABLED = false;
+#endif
+static constexpr int PROTO_REQ_ATTEMPTS = 5;
+static constexpr int64_t PROTO_REQ_INTERVAL_US = 2000000;
+static bool s_binary_tx = false;
+static int s_proto_attempts = 0;
+static int64_t s_proto_last_us = 0;
+
+#if CONFIG_PPINJECTORUI_TELEMETRY_SUBSCRIBE
+static constexpr bool TELEMETRY_SUBSCRIBE = true;
+#if CONFIG_PPINJECTORUI_ENC_SUB_RATE_HZ > 0
+static constexpr uint16_t ENC_SUB_RATE_HZ = CONFIG_PPINJECTORUI_ENC_SUB_RATE_HZ;
+#else
+// Match the display: more samples than frames would never be seen.
+static constexpr uint16_t ENC_SUB_RATE_HZ = 1000 / LV_DEF_REFR_PERIOD;
+#endif
+static constexpr float ENC_SUB_DEADBAND =
+    CONFIG_PPINJECTORUI_ENC_SUB_DEADBAND_MTURNS / 1000.0f;
+static constexpr uint16_t TEMP_SUB_RATE_HZ = CONFIG_PPINJECTORUI_TEMP_SUB_RATE_HZ;
+static constexpr float TEMP_SUB_DEADBAND =
+    CONFIG_PPINJECTORUI_TEMP_SUB_DEADBAND_CDEG / 100.0f;
+#else
+static constexpr bool TELEMETRY_SUBSCRIBE = false;
+static constexpr uint16_t ENC_SUB_RATE_HZ = 0;
+static constexpr float ENC_SUB_DEADBAND = 0.0f;
+static constexpr uint16_t TEMP_SUB_RATE_HZ = 0;
+static constexpr float TEMP_SUB_DEADBAND = 0.0f;
+#endif
+static constexpr int64_t SUB_RETRY_INTERVAL_US = 500000;
+static bool s_sub_pending = true;
+static int64_t s_sub_last_us = 0;
+
+// ENCD decoding: deltas are integers in ENC_DELTA_UNIT turns, accumulated
+// against the last sequence-numbered ENC keyframe so rounding never drifts.
+static constexpr float ENC_DELTA_UNIT = 0.001f;
+static bool s_enc_seq_valid = false;
+static uint8_t s_enc_seq = 0;
+static float s_enc_base = 0.0f;
+static int32_t s_enc_delta_acc = 0;
+
+// Plunger motion estimate, fed by every encoder sample. A plain stream
+// repeats the position when the plunger stops; a subscribed one goes quiet
+// within the deadband, and the silence is what tells the filter it stopped.
+#if CONFIG_PPINJECTORUI_PLUNGER_SMOOTHING
+static constexpr uint32_t MOTION_HORIZON_US =
+    CONFIG_PPINJECTORUI_PLUNGER_HORIZON_MS * 1000u;
+#else
+static constexpr uint32_t MOTION_HORIZON_US = 0;
+#endif
+#if CONFIG_PPINJECTORUI_TELEMETRY_SUBSCRIBE
+static constexpr uint32_t MOTION_SILENCE_US =
+    PPINJECTORUI_MOTION_SILENCE_US(ENC_SUB_RATE_HZ);
+#else
+static constexpr uint32_t MOTION_SILENCE_US = 0;
+#endif
+static PPInjectorUI_motion_t s_motion = {};
 
 static float turnsToCm3(float turns) {
   static const float TURNS_PER_CM3 = 0.99925f;
@@ -41,44 +115,351 @@ static float turnsToCm3(float turns) {
   return turns / TURNS_PER_CM3;
 }
 
-static const char *nextToken(const char *str, char *out, size_t outLen,
-                             char delim) {
-  if (!str || !out || outLen == 0) {
-    return nullptr;
+static void markChanged(uint32_t fields) {
+  if (!fields) {
+    return;
   }
-  const char *p = strchr(str, delim);
-  if (p) {
-    size_t len = (size_t)(p - str);
-    if (len >= outLen) {
-      len = outLen - 1;
+  s_generation++;
+  for (int i = 0; i < CHANGE_FIELD_COUNT; i++) {
+    if (fields & (1u << i)) {
+      s_field_generation[i] = s_generation;
     }
-    memcpy(out, str, len);
-    out[len] = '\0';
-    return p + 1;
   }
-  strncpy(out, str, outLen - 1);
-  out[outLen - 1] = '\0';
-  return nullptr;
 }
 
-static void trimInPlace(char *text) {
-  if (!text) {
+static void setFloatField(float &field, float value, uint32_t change) {
+  if (field != value) {
+    field = value;
+    markChanged(change);
+  }
+}
+
+// Samples are stamped when parsed; UART latency is near constant, so it
+// shifts the estimate in time without skewing its velocity.
+static void applyEncoderTurns(float turns) {
+  setFloatField(status.encoderTurns, turns, CHANGED_POSITION);
+  PPInjectorUI_motion_update(&s_motion, turns, esp_timer_get_time());
+}
+
+// ---------------------------------------------------------------------------
+// Line tokenising and number parsing. Fields are returned as views into the
+// received line (no copies, no trimming memmove) and numbers are converted
+// with bounded, locale-free parsers instead of atof/atol.
+// ---------------------------------------------------------------------------
+
+static inline bool isBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' ||
+         c == '\f';
+}
+
+static std::string_view trimView(std::string_view text) {
+  while (!text.empty() && isBlank(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && isBlank(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+// Splits a '|' separated line in place. Each call to next() yields the next
+// trimmed field; hasMore() tells whether anything (even an empty field) is
+// left after the last separator.
+class FieldReader {
+public:
+  explicit FieldReader(std::string_view line) : rest_(line), more_(true) {}
+
+  bool hasMore() const { return more_; }
+  std::string_view remainder() const { return trimView(rest_); }
+
+  std::string_view next() {
+    if (!more_) {
+      return {};
+    }
+    size_t pos = rest_.find('|');
+    std::string_view field;
+    if (pos == std::string_view::npos) {
+      field = rest_;
+      rest_ = {};
+      more_ = false;
+    } else {
+      field = rest_.substr(0, pos);
+      rest_.remove_prefix(pos + 1);
+    }
+    return trimView(field);
+  }
+
+private:
+  std::string_view rest_;
+  bool more_;
+};
+
+static bool equalsIgnoreCase(std::string_view a, const char *b) {
+  size_t n = strlen(b);
+  return a.size() == n && strncasecmp(a.data(), b, n) == 0;
+}
+
+// One row per MachineState, in enum order.
+static const MachineStateInfo MACHINE_STATES[] = {
+    {"", 0, 2, StateAction::None}, // Unknown
+    {"HOME", STATE_RESETS_REFILL, 2, StateAction::None},
+    {"INIT_HEATING", STATE_SAFE_FOR_UPDATE | STATE_RESETS_REFILL, 2,
+     StateAction::None},
+    {"INIT_HOT_WAIT", STATE_SAFE_FOR_UPDATE, 2, StateAction::GotoHome},
+    {"INIT_HOMED_ENCODER_ZEROED", 0, 1, StateAction::GotoHome},
+    {"REFILL", STATE_SAFE_FOR_UPDATE | STATE_EOD_BUTTON, 1,
+     StateAction::GotoCompression},
+    {"COMPRESSION", 0, 2, StateAction::GotoRefill},
+    {"READY_TO_INJECT",
+     STATE_SAFE_FOR_UPDATE | STATE_SUCTION | STATE_ABORT_BUTTON, 3,
+     StateAction::GotoPurge},
+    {"INJECT", STATE_CONSUMES_VOLUME, 1, StateAction::None},
+    {"HOLD_INJECTION", STATE_CONSUMES_VOLUME, 2, StateAction::None},
+    {"PURGE_ZERO", STATE_SAFE_FOR_UPDATE | STATE_CONSUMES_VOLUME, 3,
+     StateAction::GotoReady},
+    {"ANTIDRIP", STATE_SUCTION, 3, StateAction::None},
+    {"RELEASE", STATE_SUCTION, 3, StateAction::None},
+    {"CONFIRM_REMOVAL", STATE_SAFE_FOR_UPDATE, 2, StateAction::None},
+    {"CONFIRM_MOULD_REMOVAL", 0, 3, StateAction::None},
+};
+static_assert(sizeof(MACHINE_STATES) / sizeof(MACHINE_STATES[0]) ==
+                  static_cast<size_t>(MachineState::Count),
+              "MACHINE_STATES must have one row per MachineState");
+
+const MachineStateInfo &machineStateInfo(MachineState state) {
+  const size_t i = static_cast<size_t>(state);
+  return MACHINE_STATES[i < static_cast<size_t>(MachineState::Count) ? i : 0];
+}
+
+MachineState parseMachineState(const char *name, size_t len) {
+  if (!name || len == 0) {
+    return MachineState::Unknown;
+  }
+  for (size_t i = 1; i < static_cast<size_t>(MachineState::Count); i++) {
+    if (equalsIgnoreCase(std::string_view(name, len), MACHINE_STATES[i].name)) {
+      return static_cast<MachineState>(i);
+    }
+  }
+  return MachineState::Unknown;
+}
+
+static void copyField(char *dst, size_t dstLen, std::string_view value) {
+  if (!dst || dstLen == 0) {
     return;
   }
+  size_t n = value.size() < dstLen - 1 ? value.size() : dstLen - 1;
+  memcpy(dst, value.data(), n);
+  dst[n] = '\0';
+}
 
-  size_t len = strlen(text);
-  while (len > 0 && isspace((unsigned char)text[len - 1])) {
-    text[--len] = '\0';
+// Decimal float parser for the protocol's "%.3f"-style fields. Accepts an
+// optional sign, digits, fraction and exponent; like atof() it converts the
+// longest valid prefix and yields 0 when there is none. Mantissa digits past
+// 18 are dropped (only the decimal exponent is tracked) so it cannot overflow.
+static float parseFloat(std::string_view text) {
+  static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+                                 1e15, 1e16, 1e17, 1e18};
+  constexpr int MAX_DIGITS = 18;
+
+  size_t i = 0;
+  const size_t n = text.size();
+  bool negative = false;
+  if (i < n && (text[i] == '+' || text[i] == '-')) {
+    negative = (text[i] == '-');
+    i++;
   }
 
-  size_t start = 0;
-  while (text[start] != '\0' && isspace((unsigned char)text[start])) {
-    start++;
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exp10 = 0;
+  bool any = false;
+  while (i < n && text[i] >= '0' && text[i] <= '9') {
+    if (digits < MAX_DIGITS) {
+      mantissa = mantissa * 10 + (uint64_t)(text[i] - '0');
+      if (mantissa) {
+        digits++;
+      }
+    } else {
+      exp10++;
+    }
+    any = true;
+    i++;
+  }
+  if (i < n && text[i] == '.') {
+    i++;
+    while (i < n && text[i] >= '0' && text[i] <= '9') {
+      if (digits < MAX_DIGITS) {
+        mantissa = mantissa * 10 + (uint64_t)(text[i] - '0');
+        if (mantissa) {
+          digits++;
+        }
+        exp10--;
+      }
+      any = true;
+      i++;
+    }
+  }
+  if (!any) {
+    return 0.0f;
+  }
+  if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+    size_t j = i + 1;
+    bool expNegative = false;
+    if (j < n && (text[j] == '+' || text[j] == '-')) {
+      expNegative = (text[j] == '-');
+      j++;
+    }
+    int e = 0;
+    bool expAny = false;
+    while (j < n && text[j] >= '0' && text[j] <= '9') {
+      if (e < 1000) {
+        e = e * 10 + (text[j] - '0');
+      }
+      expAny = true;
+      j++;
+    }
+    if (expAny) {
+      exp10 += expNegative ? -e : e;
+    }
   }
 
-  if (start > 0) {
-    memmove(text, text + start, strlen(text + start) + 1);
+  // Fast path: mantissa and 10^|exp10| are both exact in a float, so a single
+  // float multiply/divide is correctly rounded and avoids soft-double math.
+  static const float POW10F[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+  if (mantissa <= (1u << 24) && exp10 >= -10 && exp10 <= 10) {
+    float value = (float)mantissa;
+    value = exp10 < 0 ? value / POW10F[-exp10] : value * POW10F[exp10];
+    return negative ? -value : value;
+  }
+
+  double value = (double)mantissa;
+  while (exp10 > 0) {
+    int step = exp10 > MAX_DIGITS ? MAX_DIGITS : exp10;
+    value *= POW10[step];
+    exp10 -= step;
+  }
+  while (exp10 < 0) {
+    int step = -exp10 > MAX_DIGITS ? MAX_DIGITS : -exp10;
+    value /= POW10[step];
+    exp10 += step;
   }
+  return (float)(negative ? -value : value);
+}
+
+// Unsigned integer parser with the same prefix semantics; saturates instead
+// of wrapping. A leading '-' negates modulo 2^32, as atol()+cast did.
+static uint32_t parseU32(std::string_view text, int base = 10) {
+  size_t i = 0;
+  const size_t n = text.size();
+  bool negative = false;
+  if (i < n && (text[i] == '+' || text[i] == '-')) {
+    negative = (text[i] == '-');
+    i++;
+  }
+  if (base == 16 && i + 1 < n && text[i] == '0' &&
+      (text[i + 1] == 'x' || text[i + 1] == 'X')) {
+    i += 2;
+  }
+  uint64_t value = 0;
+  for (; i < n; i++) {
+    char c = text[i];
+    int d;
+    if (c >= '0' && c <= '9') {
+      d = c - '0';
+    } else if (base == 16 && c >= 'a' && c <= 'f') {
+      d = c - 'a' + 10;
+    } else if (base == 16 && c >= 'A' && c <= 'F') {
+      d = c - 'A' + 10;
+    } else {
+      break;
+    }
+    value = value * (uint64_t)base + (uint64_t)d;
+    if (value > UINT32_MAX) {
+      value = UINT32_MAX;
+    }
+  }
+  return negative ? (uint32_t)(0u - (uint32_t)value) : (uint32_t)value;
+}
+
+enum class Command : uint8_t {
+  Unknown,
+  Enc,
+  Temp,
+  State,
+  Eod,
+  Error,
+  MouldOk,
+  CommonOk,
+  Mock,
+  ProtoOk,
+  EncDelta,
+};
+
+static inline char upper(char c) {
+  return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+}
+
+// The command set is fixed, so length plus one or two characters already
+// identify the candidate uniquely; a single case-insensitive compare then
+// confirms it.
+static Command classifyCommand(std::string_view cmd) {
+  Command candidate = Command::Unknown;
+  const char *name = nullptr;
+  switch (cmd.size()) {
+  case 3:
+    if (upper(cmd[0]) == 'E') {
+      if (upper(cmd[1]) == 'N') {
+        candidate = Command::Enc;
+        name = "ENC";
+      } else {
+        candidate = Command::Eod;
+        name = "EOD";
+      }
+    }
+    break;
+  case 4:
+    if (upper(cmd[0]) == 'T') {
+      candidate = Command::Temp;
+      name = "TEMP";
+    } else if (upper(cmd[0]) == 'E') {
+      candidate = Command::EncDelta;
+      name = "ENCD";
+    } else {
+      candidate = Command::Mock;
+      name = "MOCK";
+    }
+    break;
+  case 5:
+    if (upper(cmd[0]) == 'S') {
+      candidate = Command::State;
+      name = "STATE";
+    } else {
+      candidate = Command::Error;
+      name = "ERROR";
+    }
+    break;
+  case 8:
+    if (upper(cmd[0]) == 'M') {
+      candidate = Command::MouldOk;
+      name = "MOULD_OK";
+    } else {
+      candidate = Command::ProtoOk;
+      name = "PROTO_OK";
+    }
+    break;
+  case 9:
+    candidate = Command::CommonOk;
+    name = "COMMON_OK";
+    break;
+  default:
+    break;
+  }
+  if (!name || strncasecmp(cmd.data(), name, cmd.size()) != 0) {
+    return Command::Unknown;
+  }
+  return candidate;
 }
 
 static const Status &effectiveStatus(void) {
@@ -96,233 +477,561 @@ static const Status &effectiveStatus(void) {
   if (s_mock_state[0] != '\0') {
     strncpy(s_status_view.state, s_mock_state, sizeof(s_status_view.state) - 1);
     s_status_view.state[sizeof(s_status_view.state) - 1] = '\0';
+    s_status_view.stateId = s_mock_state_id;
   }
   return s_status_view;
 }
 
-static void parseMessage(const char *msg) {
-  char cmd[24] = {0};
-  const char *rest = nextToken(msg, cmd, sizeof(cmd), '|');
-  trimInPlace(cmd);
+// Field updates shared by the text and binary decoders.
+static void applyState(std::string_view value) {
+  if (value.size() > sizeof(status.state) - 1) {
+    value = value.substr(0, sizeof(status.state) - 1);
+  }
+  if (value.size() != strlen(status.state) ||
+      memcmp(status.state, value.data(), value.size()) != 0) {
+    copyField(status.state, sizeof(status.state), value);
+    status.stateId = parseMachineState(value.data(), value.size());
+    // A new state starts or stops a move: do not carry the old velocity.
+    PPInjectorUI_motion_snap(&s_motion, status.encoderTurns,
+                             esp_timer_get_time());
+    markChanged(CHANGED_STATE);
+  }
+}
 
-  if (strcasecmp(cmd, "ENC") == 0) {
-    if (rest) {
-      status.encoderTurns = (float)atof(rest);
+static void applyEod(bool eod) {
+  if (eod != status.endOfDayFlag) {
+    status.endOfDayFlag = eod;
+    markChanged(CHANGED_EOD);
+  }
+}
+
+static void applyError(uint16_t code, const std::string_view *msg) {
+  bool changed = (code != status.errorCode);
+  status.errorCode = code;
+  if (msg) {
+    const size_t n = msg->size() < sizeof(status.errorMsg) - 1
+                         ? msg->size()
+                         : sizeof(status.errorMsg) - 1;
+    if (n != strlen(status.errorMsg) ||
+        memcmp(status.errorMsg, msg->data(), n) != 0) {
+      copyField(status.errorMsg, sizeof(status.errorMsg), *msg);
+      changed = true;
     }
+  }
+  if (changed) {
+    markChanged(CHANGED_ERROR);
+  }
+}
+
+// Absolute position. With a sequence number it also becomes the base for the
+// ENCD deltas that follow it.
+static void applyEncoderKeyframe(float turns, const uint8_t *seq) {
+  applyEncoderTurns(turns);
+  s_enc_base = turns;
+  s_enc_delta_acc = 0;
+  s_enc_seq_valid = (seq != nullptr);
+  if (seq) {
+    s_enc_seq = *seq;
+  }
+}
+
+static void applyEncoderDelta(uint8_t seq, int32_t delta) {
+  if (!s_enc_seq_valid || seq != (uint8_t)(s_enc_seq + 1)) {
+    // Lost a sample (or never had a base): wait for a keyframe, and
+    // resubscribing makes the controller send one right away.
+    s_enc_seq_valid = false;
+    s_sub_pending = TELEMETRY_SUBSCRIBE;
+    s_parse_stats.encDeltaDropped++;
     return;
   }
+  s_enc_seq = seq;
+  s_enc_delta_acc += delta;
+  applyEncoderTurns(s_enc_base + (float)s_enc_delta_acc * ENC_DELTA_UNIT);
+  s_parse_stats.encDeltas++;
+}
 
-  if (strcasecmp(cmd, "TEMP") == 0) {
-    if (rest) {
-      status.tempC = (float)atof(rest);
+static void parseMessage(std::string_view msg) {
+  FieldReader fields(msg);
+  const std::string_view cmd = fields.next();
+
+  switch (classifyCommand(cmd)) {
+  case Command::Enc:
+    if (fields.hasMore()) {
+      const float turns = parseFloat(fields.next());
+      if (fields.hasMore()) {
+        const uint8_t seq = (uint8_t)parseU32(fields.next());
+        applyEncoderKeyframe(turns, &seq);
+      } else {
+        applyEncoderKeyframe(turns, nullptr);
+      }
     }
     return;
-  }
 
-  if (strcasecmp(cmd, "STATE") == 0) {
-    char field[32] = {0};
-    if (rest) {
-      rest = nextToken(rest, field, sizeof(field), '|');
-      trimInPlace(field);
-      strncpy(status.state, field, sizeof(status.state) - 1);
-      status.state[sizeof(status.state) - 1] = '\0';
+  case Command::EncDelta:
+    if (fields.hasMore()) {
+      const uint8_t seq = (uint8_t)parseU32(fields.next());
+      if (fields.hasMore()) {
+        applyEncoderDelta(seq, (int32_t)parseU32(fields.next()));
+        return;
+      }
+    }
+    break;
+
+  case Command::Temp:
+    if (fields.hasMore()) {
+      setFloatField(status.tempC, parseFloat(fields.remainder()),
+                    CHANGED_TEMP);
     }
     return;
-  }
 
-  if (strcasecmp(cmd, "EOD") == 0) {
-    if (rest) {
-      status.endOfDayFlag = (atoi(rest) != 0);
+  case Command::State:
+    if (fields.hasMore()) {
+      applyState(fields.next());
     }
     return;
-  }
 
-  if (strcasecmp(cmd, "ERROR") == 0) {
-    char field[64] = {0};
-    if (rest) {
-      rest = nextToken(rest, field, sizeof(field), '|');
-      trimInPlace(field);
-      status.errorCode = (uint16_t)strtoul(field, nullptr, 16);
-      if (rest) {
-        strncpy(status.errorMsg, rest, sizeof(status.errorMsg) - 1);
-        status.errorMsg[sizeof(status.errorMsg) - 1] = '\0';
-        trimInPlace(status.errorMsg);
+  case Command::Eod:
+    if (fields.hasMore()) {
+      applyEod(parseU32(fields.remainder()) != 0);
+    }
+    return;
+
+  case Command::Error:
+    if (fields.hasMore()) {
+      const uint16_t code = (uint16_t)parseU32(fields.next(), 16);
+      if (fields.hasMore()) {
+        const std::string_view msgField = fields.remainder();
+        applyError(code, &msgField);
+      } else {
+        applyError(code, nullptr);
       }
     }
     return;
-  }
 
-  if (strcasecmp(cmd, "MOULD_OK") == 0) {
-    char field[64] = {0};
-    int idx = 0;
-    while (rest) {
-      rest = nextToken(rest, field, sizeof(field), '|');
-      trimInPlace(field);
+  case Command::MouldOk: {
+    const MouldParams prev = mould;
+    for (int idx = 0; fields.hasMore(); idx++) {
+      const std::string_view field = fields.next();
       switch (idx) {
       case 0:
-        strncpy(mould.name, field, sizeof(mould.name) - 1);
-        mould.name[sizeof(mould.name) - 1] = '\0';
+        copyField(mould.name, sizeof(mould.name), field);
         break;
       case 1:
-        mould.fillVolume = atof(field);
+        mould.fillVolume = parseFloat(field);
         break;
       case 2:
-        mould.fillSpeed = atof(field);
+        mould.fillSpeed = parseFloat(field);
         break;
       case 3:
-        mould.fillPressure = atof(field);
+        mould.fillPressure = parseFloat(field);
         break;
       case 4:
-        mould.packVolume = atof(field);
+        mould.packVolume = parseFloat(field);
         break;
       case 5:
-        mould.packSpeed = atof(field);
+        mould.packSpeed = parseFloat(field);
         break;
       case 6:
-        mould.packPressure = atof(field);
+        mould.packPressure = parseFloat(field);
         break;
       case 7:
-        mould.packTime = atof(field);
+        mould.packTime = parseFloat(field);
         break;
       case 8:
-        mould.fillAccel = atof(field);
+        mould.fillAccel = parseFloat(field);
         break;
       case 9:
-        mould.fillDecel = atof(field);
+        mould.fillDecel = parseFloat(field);
         break;
       case 10:
-        mould.packAccel = atof(field);
+        mould.packAccel = parseFloat(field);
         break;
       case 11:
-        mould.packDecel = atof(field);
+        mould.packDecel = parseFloat(field);
         break;
       case 12:
-        strncpy(mould.mode, field, sizeof(mould.mode) - 1);
-        mould.mode[sizeof(mould.mode) - 1] = '\0';
+        copyField(mould.mode, sizeof(mould.mode), field);
         break;
       case 13:
-        mould.injectTorque = atof(field);
+        mould.injectTorque = parseFloat(field);
         break;
       default:
         break;
       }
-      idx++;
+    }
+    if (memcmp(&prev, &mould, sizeof(mould)) != 0) {
+      markChanged(CHANGED_MOULD);
     }
     return;
   }
 
-  if (strcasecmp(cmd, "COMMON_OK") == 0) {
-    char field[64] = {0};
-    int idx = 0;
-    while (rest) {
-      rest = nextToken(rest, field, sizeof(field), '|');
-      trimInPlace(field);
+  case Command::CommonOk: {
+    const CommonParams prev = common;
+    for (int idx = 0; fields.hasMore(); idx++) {
+      const std::string_view field = fields.next();
       switch (idx) {
       case 0:
-        common.trapAccel = atof(field);
+        common.trapAccel = parseFloat(field);
         break;
       case 1:
-        common.compressTorque = atof(field);
+        common.compressTorque = parseFloat(field);
         break;
       case 2:
-        common.microIntervalMs = (uint32_t)atol(field);
+        common.microIntervalMs = parseU32(field);
         break;
       case 3:
-        common.microDurationMs = (uint32_t)atol(field);
+        common.microDurationMs = parseU32(field);
         break;
       case 4:
-        common.purgeUp = atof(field);
+        common.purgeUp = parseFloat(field);
         break;
       case 5:
-        common.purgeDown = atof(field);
+        common.purgeDown = parseFloat(field);
         break;
       case 6:
-        common.purgeCurrent = atof(field);
+        common.purgeCurrent = parseFloat(field);
         break;
       case 7:
-        common.antidripVel = atof(field);
+        common.antidripVel = parseFloat(field);
         break;
       case 8:
-        common.antidripCurrent = atof(field);
+        common.antidripCurrent = parseFloat(field);
         break;
       case 9:
-        common.releaseDist = atof(field);
+        common.releaseDist = parseFloat(field);
         break;
       case 10:
-        common.releaseTrapVel = atof(field);
+        common.releaseTrapVel = parseFloat(field);
         break;
       case 11:
-        common.releaseCurrent = atof(field);
+        common.releaseCurrent = parseFloat(field);
         break;
       case 12:
-        common.contactorCycles = (uint32_t)atol(field);
+        common.contactorCycles = parseU32(field);
         break;
       case 13:
-        common.contactorLimit = (uint32_t)atol(field);
+        common.contactorLimit = parseU32(field);
         break;
       default:
         break;
       }
-      idx++;
+    }
+    if (memcmp(&prev, &common, sizeof(common)) != 0) {
+      markChanged(CHANGED_COMMON);
     }
     return;
   }
 
-  if (strcasecmp(cmd, "MOCK") == 0) {
-    char action[16] = {0};
-    char field[32] = {0};
-    if (!rest) {
+  case Command::Mock: {
+    if (!fields.hasMore()) {
       return;
     }
+    const std::string_view action = fields.next();
 
-    rest = nextToken(rest, action, sizeof(action), '|');
-    trimInPlace(action);
-
-    if (strcasecmp(action, "OFF") == 0) {
+    if (equalsIgnoreCase(action, "OFF")) {
       s_mock_enabled = false;
       s_mock_has_pos = false;
       s_mock_has_temp = false;
       s_mock_pos = 0.0f;
       s_mock_temp = 0.0f;
       s_mock_state[0] = '\0';
+      markChanged(CHANGED_POSITION | CHANGED_TEMP | CHANGED_STATE);
       ESP_LOGI(TAG, "MOCK mode disabled");
       return;
     }
 
-    if (!rest) {
+    if (!fields.hasMore()) {
       return;
     }
 
     s_mock_enabled = true;
-    nextToken(rest, field, sizeof(field), '|');
-    trimInPlace(field);
+    const std::string_view field = fields.next();
 
-    if (strcasecmp(action, "STATE") == 0) {
-      strncpy(s_mock_state, field, sizeof(s_mock_state) - 1);
-      s_mock_state[sizeof(s_mock_state) - 1] = '\0';
+    if (equalsIgnoreCase(action, "STATE")) {
+      copyField(s_mock_state, sizeof(s_mock_state), field);
+      s_mock_state_id = parseMachineState(s_mock_state, strlen(s_mock_state));
+      markChanged(CHANGED_STATE);
       ESP_LOGI(TAG, "MOCK state=%s", s_mock_state);
       return;
     }
 
-    if (strcasecmp(action, "POS") == 0) {
-      s_mock_pos = (float)atof(field);
+    if (equalsIgnoreCase(action, "POS")) {
+      s_mock_pos = parseFloat(field);
       s_mock_has_pos = true;
+      markChanged(CHANGED_POSITION);
       ESP_LOGI(TAG, "MOCK pos=%.3f", (double)s_mock_pos);
       return;
     }
 
-    if (strcasecmp(action, "TEMP") == 0) {
-      s_mock_temp = (float)atof(field);
+    if (equalsIgnoreCase(action, "TEMP")) {
+      s_mock_temp = parseFloat(field);
       s_mock_has_temp = true;
+      markChanged(CHANGED_TEMP);
       ESP_LOGI(TAG, "MOCK temp=%.3f", (double)s_mock_temp);
       return;
     }
 
-    ESP_LOGW(TAG, "Unknown MOCK action: %s", action);
+    ESP_LOGW(TAG, "Unknown MOCK action: %.*s", (int)action.size(),
+             action.data());
+    return;
+  }
+
+  case Command::ProtoOk: {
+    const std::string_view kind = fields.next();
+    const std::string_view version = fields.next();
+    if (BINARY_PROTOCOL_ENABLED && s_tx_bytes_cb &&
+        equalsIgnoreCase(kind, "BIN") && version == "1") {
+      s_binary_tx = true;
+      ESP_LOGI(TAG, "Binary protocol negotiated");
+    }
+    return;
+  }
+
+  case Command::Unknown:
+    break;
+  }
+
+  s_parse_stats.unknown++;
+  ESP_LOGW(TAG, "Unknown RX message: %.*s", (int)msg.size(), msg.data());
+}
+
+// ---------------------------------------------------------------------------
+// Binary records (see PPInjectorUI_binproto.h for the wire layout).
+// ---------------------------------------------------------------------------
+
+class ByteWriter {
+public:
+  explicit ByteWriter(uint8_t *out) : start_(out), p_(out) {}
+
+  size_t size() const { return (size_t)(p_ - start_); }
+
+  void u8(uint8_t v) { *p_++ = v; }
+  void u16(uint16_t v) {
+    PPInjectorUI_put_u16(p_, v);
+    p_ += 2;
+  }
+  void u32(uint32_t v) {
+    PPInjectorUI_put_u32(p_, v);
+    p_ += 4;
+  }
+  void f32(float v) {
+    PPInjectorUI_put_f32(p_, v);
+    p_ += 4;
+  }
+  // Fixed-width, NUL-padded text field.
+  void text(const char *value, size_t width) {
+    const size_t n = strnlen(value, width);
+    memcpy(p_, value, n);
+    memset(p_ + n, 0, width - n);
+    p_ += width;
+  }
+
+private:
+  uint8_t *start_;
+  uint8_t *p_;
+};
+
+class ByteReader {
+public:
+  explicit ByteReader(const uint8_t *in) : p_(in) {}
+
+  uint8_t u8() { return *p_++; }
+  uint16_t u16() {
+    const uint16_t v = PPInjectorUI_get_u16(p_);
+    p_ += 2;
+    return v;
+  }
+  uint32_t u32() {
+    const uint32_t v = PPInjectorUI_get_u32(p_);
+    p_ += 4;
+    return v;
+  }
+  float f32() {
+    const float v = PPInjectorUI_get_f32(p_);
+    p_ += 4;
+    return v;
+  }
+  std::string_view text(size_t width) {
+    const char *s = reinterpret_cast<const char *>(p_);
+    p_ += width;
+    return std::string_view(s, strnlen(s, width));
+  }
+
+private:
+  const uint8_t *p_;
+};
+
+static constexpr size_t MOULD_WIRE_NAME = 32;
+static constexpr size_t MOULD_WIRE_MODE = 2;
+static constexpr size_t STATUS_WIRE_STATE = 24;
+
+static float MouldParams::*const MOULD_WIRE_FLOATS[] = {
+    &MouldParams::fillVolume, &MouldParams::fillSpeed,
+    &MouldParams::fillPressure, &MouldParams::packVolume,
+    &MouldParams::packSpeed, &MouldParams::packPressure,
+    &MouldParams::packTime, &MouldParams::fillAccel,
+    &MouldParams::fillDecel, &MouldParams::packAccel,
+    &MouldParams::packDecel,
+};
+
+static float CommonParams::*const COMMON_WIRE_FLOATS[] = {
+    &CommonParams::purgeUp, &CommonParams::purgeDown,
+    &CommonParams::purgeCurrent, &CommonParams::antidripVel,
+    &CommonParams::antidripCurrent, &CommonParams::releaseDist,
+    &CommonParams::releaseTrapVel, &CommonParams::releaseCurrent,
+};
+
+size_t packMouldRecord(const MouldParams &params, uint8_t *out) {
+  ByteWriter w(out);
+  w.text(params.name, MOULD_WIRE_NAME);
+  for (float MouldParams::*field : MOULD_WIRE_FLOATS) {
+    w.f32(params.*field);
+  }
+  w.text(params.mode, MOULD_WIRE_MODE);
+  w.f32(params.injectTorque);
+  return w.size();
+}
+
+void unpackMouldRecord(const uint8_t *in, MouldParams &params) {
+  ByteReader r(in);
+  copyField(params.name, sizeof(params.name), r.text(MOULD_WIRE_NAME));
+  for (float MouldParams::*field : MOULD_WIRE_FLOATS) {
+    params.*field = r.f32();
+  }
+  copyField(params.mode, sizeof(params.mode), r.text(MOULD_WIRE_MODE));
+  params.injectTorque = r.f32();
+}
+
+static size_t packCommon(const CommonParams &params, uint8_t *out) {
+  ByteWriter w(out);
+  w.f32(params.trapAccel);
+  w.f32(params.compressTorque);
+  w.u32(params.microIntervalMs);
+  w.u32(params.microDurationMs);
+  for (float CommonParams::*field : COMMON_WIRE_FLOATS) {
+    w.f32(params.*field);
+  }
+  w.u32(params.contactorCycles);
+  w.u32(params.contactorLimit);
+  return w.size();
+}
+
+static void unpackCommon(const uint8_t *in, CommonParams &params) {
+  ByteReader r(in);
+  params.trapAccel = r.f32();
+  params.compressTorque = r.f32();
+  params.microIntervalMs = r.u32();
+  params.microDurationMs = r.u32();
+  for (float CommonParams::*field : COMMON_WIRE_FLOATS) {
+    params.*field = r.f32();
+  }
+  params.contactorCycles = r.u32();
+  params.contactorLimit = r.u32();
+}
+
+static void parseFrame(uint8_t type, const uint8_t *payload, size_t len) {
+  ByteReader r(payload);
+  const std::string_view text(reinterpret_cast<const char *>(payload), len);
+
+  switch (type) {
+  case PPINJECTORUI_MSG_ENC:
+    if (len >= 5) {
+      const float turns = r.f32();
+      const uint8_t seq = r.u8();
+      applyEncoderKeyframe(turns, &seq);
+      return;
+    }
+    if (len >= 4) {
+      applyEncoderKeyframe(r.f32(), nullptr);
+      return;
+    }
+    break;
+
+  case PPINJECTORUI_MSG_ENC_DELTA:
+    if (len >= 3) {
+      const uint8_t seq = r.u8();
+      applyEncoderDelta(seq, (int16_t)r.u16());
+      return;
+    }
+    break;
+
+  case PPINJECTORUI_MSG_TEMP:
+    if (len >= 4) {
+      setFloatField(status.tempC, r.f32(), CHANGED_TEMP);
+      return;
+    }
+    break;
+
+  case PPINJECTORUI_MSG_STATE:
+    applyState(trimView(text));
+    return;
+
+  case PPINJECTORUI_MSG_EOD:
+    if (len >= 1) {
+      applyEod(r.u8() != 0);
+      return;
+    }
+    break;
+
+  case PPINJECTORUI_MSG_ERROR:
+    if (len >= 2) {
+      const uint16_t code = r.u16();
+      const std::string_view msgField = text.substr(2);
+      applyError(code, &msgField);
+      return;
+    }
+    break;
+
+  case PPINJECTORUI_MSG_STATUS:
+    if (len == PPINJECTORUI_BINPROTO_STATUS_SIZE) {
+      applyEncoderTurns(r.f32());
+      setFloatField(status.tempC, r.f32(), CHANGED_TEMP);
+      // The message text only travels in MSG_ERROR.
+      applyError(r.u16(), nullptr);
+      applyEod((r.u8() & 0x01) != 0);
+      applyState(r.text(STATUS_WIRE_STATE));
+      return;
+    }
+    break;
+
+  case PPINJECTORUI_MSG_MOULD_OK:
+    if (len == PPINJECTORUI_BINPROTO_MOULD_SIZE) {
+      MouldParams next = mould;
+      unpackMouldRecord(payload, next);
+      if (memcmp(&next, &mould, sizeof(mould)) != 0) {
+        mould = next;
+        markChanged(CHANGED_MOULD);
+      }
+      return;
+    }
+    break;
+
+  case PPINJECTORUI_MSG_COMMON_OK:
+    if (len == PPINJECTORUI_BINPROTO_COMMON_SIZE) {
+      CommonParams next = common;
+      unpackCommon(payload, next);
+      if (memcmp(&next, &common, sizeof(common)) != 0) {
+        common = next;
+        markChanged(CHANGED_COMMON);
+      }
+      return;
+    }
+    break;
+
+  case PPINJECTORUI_MSG_TEXT: {
+    const std::string_view line = trimView(text);
+    if (!line.empty()) {
+      parseMessage(line);
+    }
     return;
   }
 
-  ESP_LOGW(TAG, "Unknown RX message: %s", msg ? msg : "(null)");
+  default:
+    break;
+  }
+
+  s_parse_stats.unknown++;
+  ESP_LOGW(TAG, "Unknown RX frame: type=0x%02x len=%u", type, (unsigned)len);
 }
 
 static void txLine(const char *line) {
@@ -346,10 +1055,64 @@ void init(void) {
   s_mock_pos = 0.0f;
   s_mock_temp = 0.0f;
   s_mock_state[0] = '\0';
+  s_enc_seq_valid = false;
+  s_sub_pending = TELEMETRY_SUBSCRIBE;
+  PPInjectorUI_motion_init(&s_motion, PPINJECTORUI_MOTION_ALPHA,
+                           PPINJECTORUI_MOTION_BETA, MOTION_HORIZON_US,
+                           MOTION_SILENCE_US);
+  markChanged(CHANGED_ALL);
+}
+
+static bool useBinaryTx(void) { return s_binary_tx && s_tx_bytes_cb; }
+
+static void txFrame(uint8_t type, const uint8_t *payload, size_t len) {
+  uint8_t frame[PPINJECTORUI_BINPROTO_MAX_FRAME];
+  const size_t n = PPInjectorUI_binproto_encode(type, payload, len, frame,
+                                                sizeof(frame));
+  if (n == 0) {
+    ESP_LOGW(TAG, "TX frame too large: type=0x%02x len=%u", type,
+             (unsigned)len);
+    return;
+  }
+  ESP_LOGD(TAG, "TX frame: type=0x%02x len=%u", type, (unsigned)len);
+  s_tx_bytes_cb(frame, n, s_tx_bytes_ctx);
+}
+
+// Asks the controller for binary framing a few times after start-up (or after
+// falling back); a controller that does not answer keeps the text protocol.
+static void updateNegotiation(int64_t now) {
+  if (!BINARY_PROTOCOL_ENABLED || s_binary_tx || !s_tx_bytes_cb ||
+      s_proto_attempts >= PROTO_REQ_ATTEMPTS) {
+    return;
+  }
+  if (s_proto_attempts > 0 && now - s_proto_last_us < PROTO_REQ_INTERVAL_US) {
+    return;
+  }
+  s_proto_attempts++;
+  s_proto_last_us = now;
+  txLine(PPINJECTORUI_PROTO_REQ);
+}
+
+// (Re)sends the telemetry subscription after start-up, a protocol fallback or
+// an ENCD sequence gap. Controllers that do not know SUB keep streaming full
+// ENC/TEMP lines, which are still accepted.
+static void updateSubscription(int64_t now) {
+  if (!TELEMETRY_SUBSCRIBE || !s_sub_pending || !s_tx_cb) {
+    return;
+  }
+  if (s_sub_last_us != 0 && now - s_sub_last_us < SUB_RETRY_INTERVAL_US) {
+    return;
+  }
+  s_sub_pending = false;
+  s_sub_last_us = now;
+  sendSubscribe(SubChannel::Enc, ENC_SUB_RATE_HZ, ENC_SUB_DEADBAND);
+  sendSubscribe(SubChannel::Temp, TEMP_SUB_RATE_HZ, TEMP_SUB_DEADBAND);
 }
 
 void update(void) {
-  // UART transport is intentionally deferred to next iteration.
+  const int64_t now = esp_timer_get_time();
+  updateNegotiation(now);
+  updateSubscription(now);
 }
 
 void injectRxLine(const char *line) {
@@ -357,15 +1120,47 @@ void injectRxLine(const char *line) {
     return;
   }
 
-  char local[256] = {0};
-  strncpy(local, line, sizeof(local) - 1);
-  trimInPlace(local);
-  if (!local[0]) {
+  const std::string_view local = trimView(std::string_view(line));
+  if (local.empty()) {
     return;
   }
 
-  // ESP_LOGD(TAG, "RX: %s", local);
+  if (s_binary_tx) {
+    // A bare text line while in binary mode means the transport lost the
+    // frame sync (typically a controller restart): talk text again and
+    // renegotiate.
+    s_binary_tx = false;
+    s_proto_attempts = 0;
+    s_sub_pending = TELEMETRY_SUBSCRIBE;
+    s_parse_stats.fallbacks++;
+    ESP_LOGW(TAG, "Text line in binary mode, falling back to text protocol");
+  }
+
+  // ESP_LOGD(TAG, "RX: %.*s", (int)local.size(), local.data());
+  const int64_t t0 = esp_timer_get_time();
   parseMessage(local);
+  s_parse_stats.lines++;
+  s_parse_stats.busyUs += (uint64_t)(esp_timer_get_time() - t0);
+}
+
+void injectRxFrame(const uint8_t *frame, size_t len) {
+  if (!frame || len == 0) {
+    return;
+  }
+
+  const int64_t t0 = esp_timer_get_time();
+  uint8_t type = 0;
+  uint8_t payload[PPINJECTORUI_BINPROTO_MAX_PAYLOAD];
+  const int n = PPInjectorUI_binproto_decode(frame, len, &type, payload,
+                                             sizeof(payload));
+  if (n < 0) {
+    s_parse_stats.badFrames++;
+    ESP_LOGD(TAG, "RX frame rejected (len=%u)", (unsigned)len);
+    return;
+  }
+  parseFrame(type, payload, (size_t)n);
+  s_parse_stats.frames++;
+  s_parse_stats.busyUs += (uint64_t)(esp_timer_get_time() - t0);
 }
 
 static void setLabelText(lv_obj_t *label, const char *text) {
@@ -390,31 +1185,44 @@ static void setLabelFloat(lv_obj_t *label, float value,
 }
 
 void applyUiUpdates(void) {
+  static uint32_t s_cursor = 0;
+  const uint32_t changed = takeChanges(s_cursor);
+  if (!changed) {
+    return;
+  }
   const Status &uiStatus = effectiveStatus();
 
-  eez::flow::setGlobalVariable(FLOW_GLOBAL_VARIABLE_PLUNGER_TIP_POSITION,
-                               FloatValue(turnsToCm3(uiStatus.encoderTurns)));
+  if (changed & (CHANGED_POSITION | CHANGED_TEMP)) {
+    eez::flow::setGlobalVariable(
+        FLOW_GLOBAL_VARIABLE_PLUNGER_TIP_POSITION,
+        FloatValue(turnsToCm3(uiStatus.encoderTurns)));
 
-  plunger_stateValue plungerStateValue(
-      eez::flow::getGlobalVariable(FLOW_GLOBAL_VARIABLE_PLUNGER_STATE));
-  if (plungerStateValue) {
-    plungerStateValue.temperature(uiStatus.tempC);
-    plungerStateValue.current_barrel_capacity(
-        turnsToCm3(uiStatus.encoderTurns));
+    plunger_stateValue plungerStateValue(
+        eez::flow::getGlobalVariable(FLOW_GLOBAL_VARIABLE_PLUNGER_STATE));
+    if (plungerStateValue) {
+      plungerStateValue.temperature(uiStatus.tempC);
+      plungerStateValue.current_barrel_capacity(
+          turnsToCm3(uiStatus.encoderTurns));
+    }
   }
 
-  const char *stateText = (uiStatus.state[0] != '\0') ? uiStatus.state : "--";
-  setLabelText(objects.obj1__machine_state_text, stateText);
-  setLabelText(objects.obj3__machine_state_text, stateText);
-  setLabelText(objects.obj6__machine_state_text, stateText);
+  if (changed & CHANGED_STATE) {
+    const char *stateText =
+        (uiStatus.state[0] != '\0') ? uiStatus.state : "--";
+    setLabelText(objects.obj1__machine_state_text, stateText);
+    setLabelText(objects.obj3__machine_state_text, stateText);
+    setLabelText(objects.obj6__machine_state_text, stateText);
+  }
 
-  setLabelText(objects.obj4__mould_name_value, mould.name);
-  setLabelFloat(objects.obj4__mould_fill_speed_value, mould.fillSpeed);
-  setLabelFloat(objects.obj4__mould_fill_dist_value, mould.fillVolume);
-  setLabelFloat(objects.obj4__mould_fill_accel_value, mould.fillAccel);
-  setLabelFloat(objects.obj4__mould_hold_speed_value, mould.packSpeed);
-  setLabelFloat(objects.obj4__mould_hold_dist_value, mould.packVolume);
-  setLabelFloat(objects.obj4__mould_hold_accel_value, mould.packAccel);
+  if (changed & CHANGED_MOULD) {
+    setLabelText(objects.obj4__mould_name_value, mould.name);
+    setLabelFloat(objects.obj4__mould_fill_speed_value, mould.fillSpeed);
+    setLabelFloat(objects.obj4__mould_fill_dist_value, mould.fillVolume);
+    setLabelFloat(objects.obj4__mould_fill_accel_value, mould.fillAccel);
+    setLabelFloat(objects.obj4__mould_hold_speed_value, mould.packSpeed);
+    setLabelFloat(objects.obj4__mould_hold_dist_value, mould.packVolume);
+    setLabelFloat(objects.obj4__mould_hold_accel_value, mould.packAccel);
+  }
 }
 
 void setTxCallback(tx_callback_t cb, void *ctx) {
@@ -422,28 +1230,87 @@ void setTxCallback(tx_callback_t cb, void *ctx) {
   s_tx_ctx = ctx;
 }
 
-void sendQueryMould(void) { txLine("QUERY_MOULD"); }
-void sendQueryCommon(void) { txLine("QUERY_COMMON"); }
-void sendQueryState(void) { txLine("QUERY_STATE"); }
-void sendQueryError(void) { txLine("QUERY_ERROR"); }
+void setTxBytesCallback(tx_bytes_callback_t cb, void *ctx) {
+  s_tx_bytes_cb = cb;
+  s_tx_bytes_ctx = ctx;
+  if (!cb) {
+    s_binary_tx = false;
+  }
+}
+
+bool binaryActive(void) { return useBinaryTx(); }
+
+static void txQuery(uint8_t type, const char *line) {
+  if (useBinaryTx()) {
+    txFrame(type, nullptr, 0);
+  } else {
+    txLine(line);
+  }
+}
+
+void sendQueryMould(void) {
+  txQuery(PPINJECTORUI_MSG_QUERY_MOULD, "QUERY_MOULD");
+}
+void sendQueryCommon(void) {
+  txQuery(PPINJECTORUI_MSG_QUERY_COMMON, "QUERY_COMMON");
+}
+void sendQueryState(void) {
+  txQuery(PPINJECTORUI_MSG_QUERY_STATE, "QUERY_STATE");
+}
+void sendQueryError(void) {
+  txQuery(PPINJECTORUI_MSG_QUERY_ERROR, "QUERY_ERROR");
+}
 
 void sendCmdGoto(const char *state) {
+  if (useBinaryTx() && state) {
+    txFrame(PPINJECTORUI_MSG_CMD_GOTO, reinterpret_cast<const uint8_t *>(state),
+            strnlen(state, 63));
+    return;
+  }
   char buf[64];
   snprintf(buf, sizeof(buf), "CMD|GOTO|%s", state);
   txLine(buf);
 }
 
 void sendCmdToggle(const char *feature) {
+  if (useBinaryTx() && feature) {
+    txFrame(PPINJECTORUI_MSG_CMD_TOGGLE,
+            reinterpret_cast<const uint8_t *>(feature), strnlen(feature, 63));
+    return;
+  }
   char buf[64];
   snprintf(buf, sizeof(buf), "CMD|TOGGLE|%s", feature);
   txLine(buf);
 }
 
+void sendSubscribe(SubChannel channel, uint16_t rateHz, float deadband) {
+  if (useBinaryTx()) {
+    uint8_t payload[7];
+    ByteWriter w(payload);
+    w.u8((uint8_t)channel);
+    w.u16(rateHz);
+    w.f32(deadband);
+    txFrame(PPINJECTORUI_MSG_SUB, payload, w.size());
+    return;
+  }
+  char buf[48];
+  snprintf(buf, sizeof(buf), "SUB|%s|%u|%.3f",
+           channel == SubChannel::Enc ? "ENC" : "TEMP", (unsigned)rateHz,
+           (double)deadband);
+  txLine(buf);
+}
+
 bool sendMould(const MouldParams &params) {
   if (!isSafeForUpdate()) {
     return false;
   }
 
+  if (useBinaryTx()) {
+    uint8_t payload[PPINJECTORUI_BINPROTO_MOULD_SIZE];
+    txFrame(PPINJECTORUI_MSG_MOULD, payload, packMouldRecord(params, payload));
+    return true;
+  }
+
   char message[320] = {0};
   snprintf(message, sizeof(message),
            "MOULD|%s|%.3f|%.3f|%.3f|%.3f|%.3f|%.3f|%.3f|%.3f|%.3f|%.3f|%."
@@ -462,6 +1329,12 @@ bool sendCommon(const CommonParams &params) {
     return false;
   }
 
+  if (useBinaryTx()) {
+    uint8_t payload[PPINJECTORUI_BINPROTO_COMMON_SIZE];
+    txFrame(PPINJECTORUI_MSG_COMMON, payload, packCommon(params, payload));
+    return true;
+  }
+
   char message[320] = {0};
   snprintf(message, sizeof(message),
            "COMMON|%.3f|%.3f|%lu|%lu|%.3f|%.3f|%.3f|%.3f|%.3f|%.3f|%.3f|%.3f|%"
@@ -478,23 +1351,220 @@ bool sendCommon(const CommonParams &params) {
 }
 
 const Status &getStatus(void) { return effectiveStatus(); }
+
+const ParseStats &getParseStats(void) { return s_parse_stats; }
+
+float predictEncoderTurns(int64_t nowUs) {
+  if (s_mock_enabled && s_mock_has_pos) {
+    return s_mock_pos;
+  }
+  return PPInjectorUI_motion_predict(&s_motion, nowUs);
+}
+
+const PPInjectorUI_motion_t &motionEstimate(void) { return s_motion; }
+
+uint32_t takeChanges(uint32_t &cursor) {
+  uint32_t changed = 0;
+  for (int i = 0; i < CHANGE_FIELD_COUNT; i++) {
+    if ((int32_t)(s_field_generation[i] - cursor) > 0) {
+      changed |= (1u << i);
+    }
+  }
+  cursor = s_generation;
+  return changed;
+}
 const MouldParams &getMould(void) { return mould; }
 const CommonParams &getCommon(void) { return common; }
 
-static bool stateEquals(const char *a, const char *b) {
-  if (!a || !b) {
-    return false;
+bool isSafeForUpdate(void) {
+  return (machineStateInfo(status.stateId).flags & STATE_SAFE_FOR_UPDATE) != 0;
+}
+
+// ------------------ BEGIN Parser benchmark ------------------
+#if CONFIG_PPINJECTORUI_PARSER_BENCH
+// The text parser as it was before the switch dispatch, kept only as the
+// baseline: every field is copied out and trimmed with memmove, commands
+// go through a strcasecmp chain and numbers through atof.
+namespace legacy {
+
+static const char *nextToken(const char *str, char *out, size_t outLen,
+                             char delim) {
+  if (!str || !out || outLen == 0) {
+    return nullptr;
+  }
+  const char *p = strchr(str, delim);
+  if (p) {
+    size_t len = (size_t)(p - str);
+    if (len >= outLen) {
+      len = outLen - 1;
+    }
+    memcpy(out, str, len);
+    out[len] = '\0';
+    return p + 1;
   }
-  return strcasecmp(a, b) == 0;
+  strncpy(out, str, outLen - 1);
+  out[outLen - 1] = '\0';
+  return nullptr;
 }
 
-bool isSafeForUpdate(void) {
-  return stateEquals(status.state, "INIT_HEATING") ||
-         stateEquals(status.state, "INIT_HOT_WAIT") ||
-         stateEquals(status.state, "REFILL") ||
-         stateEquals(status.state, "READY_TO_INJECT") ||
-         stateEquals(status.state, "PURGE_ZERO") ||
-         stateEquals(status.state, "CONFIRM_REMOVAL");
+static void trimInPlace(char *text) {
+  size_t len = strlen(text);
+  while (len > 0 && isspace((unsigned char)text[len - 1])) {
+    text[--len] = '\0';
+  }
+  size_t start = 0;
+  while (text[start] != '\0' && isspace((unsigned char)text[start])) {
+    start++;
+  }
+  if (start > 0) {
+    memmove(text, text + start, strlen(text + start) + 1);
+  }
 }
 
+// Only the telemetry branches are kept whole; the rest still costs their
+// strcasecmp, as an unknown command did.
+static void parseMessage(const char *msg, Status &st) {
+  char cmd[24] = {0};
+  const char *rest = nextToken(msg, cmd, sizeof(cmd), '|');
+  trimInPlace(cmd);
+
+  if (strcasecmp(cmd, "ENC") == 0) {
+    if (rest) {
+      st.encoderTurns = (float)atof(rest);
+    }
+    return;
+  }
+  if (strcasecmp(cmd, "TEMP") == 0) {
+    if (rest) {
+      st.tempC = (float)atof(rest);
+    }
+    return;
+  }
+  if (strcasecmp(cmd, "STATE") == 0) {
+    char field[32] = {0};
+    if (rest) {
+      nextToken(rest, field, sizeof(field), '|');
+      trimInPlace(field);
+      strncpy(st.state, field, sizeof(st.state) - 1);
+      st.state[sizeof(st.state) - 1] = '\0';
+    }
+    return;
+  }
+  static const char *const kOthers[] = {"EOD", "ERROR", "MOULD_OK",
+                                        "COMMON_OK", "MOCK"};
+  for (const char *other : kOthers) {
+    if (strcasecmp(cmd, other) == 0) {
+      return;
+    }
+  }
+}
+
+} // namespace legacy
+
+// One second of a busy cycle at 50 Hz telemetry: mostly position, some
+// temperature, a state change. The text stream is what older controllers
+// send; the subscribed one is ENC keyframes with ENCD deltas.
+static const char *const kBenchTextLines[] = {
+    "ENC|12.345",     "ENC|12.391", "ENC|12.440",   "ENC|12.502",
+    "TEMP|201.40",    "ENC|12.577", "ENC|12.660",   "ENC|12.751",
+    "ENC|12.849",     "TEMP|201.45", "STATE|INJECT", "ENC|12.952",
+    "ENC|13.060",     "ENC|13.171", "ENC|13.284",   "TEMP|201.50",
+};
+static const char *const kBenchSubLines[] = {
+    "ENC|12.345|0", "ENCD|1|46",  "ENCD|2|49",  "ENCD|3|62",
+    "TEMP|201.40",  "ENCD|4|75",  "ENCD|5|83",  "ENCD|6|91",
+    "ENCD|7|98",    "TEMP|201.45", "STATE|INJECT", "ENCD|8|103",
+    "ENCD|9|108",   "ENCD|10|111", "ENCD|11|113", "TEMP|201.50",
+};
+static constexpr size_t BENCH_STREAM_LINES =
+    sizeof(kBenchTextLines) / sizeof(kBenchTextLines[0]);
+static_assert(sizeof(kBenchSubLines) / sizeof(kBenchSubLines[0]) ==
+                  BENCH_STREAM_LINES,
+              "streams differ in length");
+
+static uint32_t benchLinesPerSecond(uint32_t lines, int64_t us) {
+  return us > 0 ? (uint32_t)((uint64_t)lines * 1000000u / (uint64_t)us) : 0;
+}
+
+void runParserBenchmark(uint32_t lines) {
+  const uint32_t reps = (lines + BENCH_STREAM_LINES - 1) / BENCH_STREAM_LINES;
+  const uint32_t total = reps * (uint32_t)BENCH_STREAM_LINES;
+
+  // The replay goes through the live decoder: keep what it overwrites.
+  const Status savedStatus = status;
+  const ParseStats savedStats = s_parse_stats;
+  const PPInjectorUI_motion_t savedMotion = s_motion;
+  const bool savedSeqValid = s_enc_seq_valid;
+  const uint8_t savedSeq = s_enc_seq;
+  const float savedBase = s_enc_base;
+  const int32_t savedAcc = s_enc_delta_acc;
+  const bool savedSubPending = s_sub_pending;
+
+  Status legacyStatus = {};
+  int64_t t0 = esp_timer_get_time();
+  for (uint32_t r = 0; r < reps; ++r) {
+    for (const char *line : kBenchTextLines) {
+      legacy::parseMessage(line, legacyStatus);
+    }
+  }
+  const int64_t legacyUs = esp_timer_get_time() - t0;
+
+  t0 = esp_timer_get_time();
+  for (uint32_t r = 0; r < reps; ++r) {
+    for (const char *line : kBenchTextLines) {
+      parseMessage(std::string_view(line));
+    }
+  }
+  const int64_t textUs = esp_timer_get_time() - t0;
+  const float textCheck = status.encoderTurns;
+
+  t0 = esp_timer_get_time();
+  for (uint32_t r = 0; r < reps; ++r) {
+    for (const char *line : kBenchSubLines) {
+      parseMessage(std::string_view(line));
+    }
+  }
+  const int64_t subUs = esp_timer_get_time() - t0;
+  const float subCheck = status.encoderTurns;
+
+  status = savedStatus;
+  s_parse_stats = savedStats;
+  s_motion = savedMotion;
+  s_enc_seq_valid = savedSeqValid;
+  s_enc_seq = savedSeq;
+  s_enc_base = savedBase;
+  s_enc_delta_acc = savedAcc;
+  s_sub_pending = savedSubPending;
+  markChanged(CHANGED_ALL);
+
+  ESP_LOGI(TAG,
+           "parser bench: %lu lines, legacy text %lu lines/s (%lu us), "
+           "text %lu lines/s (%lu us), subscribed %lu lines/s (%lu us)",
+           (unsigned long)total,
+           (unsigned long)benchLinesPerSecond(total, legacyUs),
+           (unsigned long)legacyUs,
+           (unsigned long)benchLinesPerSecond(total, textUs),
+           (unsigned long)textUs,
+           (unsigned long)benchLinesPerSecond(total, subUs),
+           (unsigned long)subUs);
+  // Both streams end on the same position; a mismatch means the decoders
+  // disagree, not that one of them is fast.
+  const auto differ = [](float a, float b) {
+    return a - b > 0.0005f || b - a > 0.0005f;
+  };
+  if (differ(legacyStatus.encoderTurns, textCheck) ||
+      differ(textCheck, subCheck)) {
+    ESP_LOGW(TAG, "parser bench: final positions differ (%.3f/%.3f/%.3f)",
+             (double)legacyStatus.encoderTurns, (double)textCheck,
+             (double)subCheck);
+  }
+}
+
+#else
+
+void runParserBenchmark(uint32_t lines) { (void)lines; }
+
+#endif
+// ------------------ END   Parser benchmark ------------------
+
 } // namespace DisplayComms
@@ -0,0 +1,246 @@
+// BEGIN --- Standard C headers section ---
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+// END   --- Standard C headers section ---
+
+// BEGIN --- SDK config section---
+#include <sdkconfig.h>
+// END   --- SDK config section---
+
+// BEGIN --- ESP-IDF headers section ---
+#include "esp_log.h"
+// END   --- ESP-IDF headers section ---
+
+// BEGIN --- Self-includes section ---
+#include "PPInjectorUI_motion.h"
+// END --- Self-includes section ---
+
+void PPInjectorUI_motion_init(PPInjectorUI_motion_t *m, float alpha,
+                              float beta, uint32_t horizon_us,
+                              uint32_t silence_us) {
+  *m = (PPInjectorUI_motion_t){0};
+  m->alpha = alpha;
+  m->beta = beta;
+  m->horizon_us = horizon_us;
+  m->silence_us = silence_us;
+}
+
+void PPInjectorUI_motion_snap(PPInjectorUI_motion_t *m, float turns,
+                              int64_t t_us) {
+  m->valid = true;
+  m->t_us = t_us;
+  m->turns = turns;
+  m->turns_per_s = 0.0f;
+  m->resets++;
+}
+
+void PPInjectorUI_motion_update(PPInjectorUI_motion_t *m, float turns,
+                                int64_t t_us) {
+  m->samples++;
+  const int64_t dt_us = t_us - m->t_us;
+  if (!m->valid || dt_us > PPINJECTORUI_MOTION_STALE_US || dt_us < 0) {
+    PPInjectorUI_motion_snap(m, turns, t_us);
+    return;
+  }
+  if (dt_us == 0) {
+    // Two samples in one timestamp (a burst drained at once): no time step
+    // to learn a velocity from, only move the position.
+    m->turns += m->alpha * (turns - m->turns);
+    return;
+  }
+
+  if (m->silence_us && dt_us > m->silence_us) {
+    // The stream went quiet, so the plunger stood still for most of the
+    // gap: its old velocity would be charged against all of it.
+    m->turns_per_s = 0.0f;
+  }
+
+  const float dt = (float)dt_us * 1e-6f;
+  const float predicted = m->turns + m->turns_per_s * dt;
+  const float residual = turns - predicted;
+  m->turns = predicted + m->alpha * residual;
+  m->turns_per_s += m->beta * residual / dt;
+  m->t_us = t_us;
+
+  const float err = fabsf(residual);
+  m->err_count++;
+  m->err_sq_sum += (double)err * err;
+  if (err > m->err_max) {
+    m->err_max = err;
+  }
+}
+
+float PPInjectorUI_motion_predict(const PPInjectorUI_motion_t *m,
+                                  int64_t t_us) {
+  const int64_t dt_us = t_us - m->t_us;
+  int64_t horizon = m->horizon_us;
+  if (m->silence_us && m->silence_us < horizon) {
+    horizon = m->silence_us; // no sample by then: it stopped
+  }
+  if (!m->valid || dt_us <= 0 || horizon == 0) {
+    return m->turns;
+  }
+  // Dead-reckon up to the horizon, then ease back to the last estimate.
+  const int64_t lead_us = dt_us <= horizon      ? dt_us
+                          : dt_us < 2 * horizon ? 2 * horizon - dt_us
+                                                : 0;
+  return m->turns + m->turns_per_s * ((float)lead_us * 1e-6f);
+}
+
+float PPInjectorUI_motion_err_rms(const PPInjectorUI_motion_t *m) {
+  return m->err_count ? (float)sqrt(m->err_sq_sum / m->err_count)
+                      : 0.0f;
+}
+
+// ------------------ BEGIN Benchmark ------------------
+#if CONFIG_PPINJECTORUI_MOTION_BENCH
+
+static const char *TAG = "PPInjectorUI_motion";
+
+// One injection cycle: park, fast approach, slow injection, hold, return.
+typedef struct {
+  float start_s;
+  float dur_s;
+  float from;
+  float to;
+} bench_move_t;
+
+static const bench_move_t kMoves[] = {
+    {0.5f, 2.0f, 10.0f, 30.0f},
+    {3.5f, 4.0f, 30.0f, 34.0f},
+    {8.5f, 1.5f, 34.0f, 10.0f},
+};
+#define BENCH_CYCLE_S 11.0f
+#define BENCH_CYCLES 3
+
+// True plunger position: cosine-eased moves, so velocity has no steps.
+static float bench_truth(float t_s) {
+  const float t = fmodf(t_s, BENCH_CYCLE_S);
+  float x = kMoves[0].from;
+  for (size_t i = 0; i < sizeof(kMoves) / sizeof(kMoves[0]); ++i) {
+    const bench_move_t *mv = &kMoves[i];
+    if (t < mv->start_s) {
+      break;
+    }
+    const float u = (t - mv->start_s) / mv->dur_s;
+    x = u >= 1.0f ? mv->to
+                  : mv->from + (mv->to - mv->from) *
+                                   (1.0f - cosf((float)M_PI * u)) * 0.5f;
+  }
+  return x;
+}
+
+static uint32_t bench_rand(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state >> 8;
+}
+
+// A stop is "still" once this far past the end of the move.
+#define BENCH_SETTLE_S 0.3f
+// The controller's ENC keyframe period (scripts/rs485_ppinjector_test.py).
+#define BENCH_KEYFRAME_US 1000000
+
+static bool bench_still(float t_s) {
+  const float t = fmodf(t_s, BENCH_CYCLE_S);
+  for (size_t i = 0; i < sizeof(kMoves) / sizeof(kMoves[0]); ++i) {
+    const bench_move_t *mv = &kMoves[i];
+    if (t >= mv->start_s && t < mv->start_s + mv->dur_s + BENCH_SETTLE_S) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PPInjectorUI_motion_benchmark(uint32_t sample_hz, uint32_t frame_hz,
+                                   uint32_t horizon_us,
+                                   uint32_t deadband_mturns,
+                                   PPInjectorUI_motion_bench_t *out) {
+  if (sample_hz == 0 || frame_hz == 0) {
+    return;
+  }
+  PPInjectorUI_motion_t m;
+  PPInjectorUI_motion_init(&m, PPINJECTORUI_MOTION_ALPHA,
+                           PPINJECTORUI_MOTION_BETA, horizon_us,
+                           deadband_mturns
+                               ? PPINJECTORUI_MOTION_SILENCE_US(sample_hz)
+                               : 0);
+
+  const int64_t end_us = (int64_t)(BENCH_CYCLE_S * BENCH_CYCLES * 1e6f);
+  const int64_t period_us = 1000000 / sample_hz;
+  uint32_t rng = 12345;
+  int64_t next_sample_us = 0;
+  int64_t last_key_us = -BENCH_KEYFRAME_US;
+  int32_t sent_mturns = 0;
+  float last_sample = bench_truth(0.0f);
+  double snap_sq = 0, pred_sq = 0;
+  float snap_max = 0, pred_max = 0, hold_max = 0;
+  uint32_t frames = 0;
+  uint32_t sent = 0;
+
+  for (int64_t t_us = 0; t_us < end_us;
+       t_us = (int64_t)(++frames) * 1000000 / frame_hz) {
+    while (next_sample_us <= t_us) {
+      // Quantised like the wire (1/1000 turn), period jittered by +-20%.
+      const int32_t mturns = (int32_t)lroundf(
+          bench_truth((float)next_sample_us * 1e-6f) * 1000.0f);
+      const bool key = next_sample_us - last_key_us >= BENCH_KEYFRAME_US;
+      if (key || (uint32_t)abs(mturns - sent_mturns) >= deadband_mturns) {
+        last_sample = (float)mturns / 1000.0f;
+        PPInjectorUI_motion_update(&m, last_sample, next_sample_us);
+        sent_mturns = mturns;
+        last_key_us = key ? next_sample_us : last_key_us;
+        sent++;
+      }
+      const int64_t jitter = (int64_t)(bench_rand(&rng) % 401) - 200;
+      next_sample_us += period_us + period_us * jitter / 1000;
+    }
+    const float truth = bench_truth((float)t_us * 1e-6f);
+    const float snap_err = fabsf(truth - last_sample);
+    const float pred_err =
+        fabsf(truth - PPInjectorUI_motion_predict(&m, t_us));
+    snap_sq += (double)snap_err * snap_err;
+    pred_sq += (double)pred_err * pred_err;
+    snap_max = snap_err > snap_max ? snap_err : snap_max;
+    pred_max = pred_err > pred_max ? pred_err : pred_max;
+    if (bench_still((float)t_us * 1e-6f) && pred_err > hold_max) {
+      hold_max = pred_err;
+    }
+  }
+
+  const PPInjectorUI_motion_bench_t r = {
+      .last_rms = (float)sqrt(snap_sq / frames),
+      .last_max = snap_max,
+      .pred_rms = (float)sqrt(pred_sq / frames),
+      .pred_max = pred_max,
+      .hold_max = hold_max,
+      .samples = sent,
+  };
+  ESP_LOGI(TAG,
+           "bench: %lu Hz samples, deadband %lu mturn, %lu Hz frames, "
+           "horizon %lu ms: last sample rms=%.3f max=%.3f, predicted "
+           "rms=%.3f max=%.3f, at rest max=%.3f turns (%lu samples sent)",
+           (unsigned long)sample_hz, (unsigned long)deadband_mturns,
+           (unsigned long)frame_hz, (unsigned long)(horizon_us / 1000),
+           (double)r.last_rms, (double)r.last_max, (double)r.pred_rms,
+           (double)r.pred_max, (double)r.hold_max, (unsigned long)r.samples);
+  if (out) {
+    *out = r;
+  }
+}
+
+#else
+
+void PPInjectorUI_motion_benchmark(uint32_t sample_hz, uint32_t frame_hz,
+                                   uint32_t horizon_us,
+                                   uint32_t deadband_mturns,
+                                   PPInjectorUI_motion_bench_t *out) {
+  (void)sample_hz;
+  (void)frame_hz;
+  (void)horizon_us;
+  (void)deadband_mturns;
+  (void)out;
+}
+
+#endif
+// ------------------ END   Benchmark ------------------
@@ -0,0 +1,465 @@
+// BEGIN --- Standard C headers section ---
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+// END   --- Standard C headers section ---
+
+// BEGIN --- SDK config section---
+#include <sdkconfig.h>
+// END   --- SDK config section---
+
+// BEGIN --- ESP-IDF headers section ---
+#include "esp_log.h"
+#include "esp_timer.h"
+// END   --- ESP-IDF headers section ---
+
+// BEGIN --- Self-includes section ---
+#include "PPInjectorUI_binproto.h"
+#include "PPInjectorUI_mould_index.h"
+// END --- Self-includes section ---
+
+static const char *TAG = "PPInjectorUI_idx";
+
+#define INDEX_FLAG_DIRTY 0x0001
+#define SCAN_CHUNK 64
+
+static char fold_char(char c) { return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c; }
+
+static size_t fold(const char *in, char *out, size_t out_len) {
+  size_t n = 0;
+  while (in && in[n] != '\0' && n + 1 < out_len) {
+    out[n] = fold_char(in[n]);
+    n++;
+  }
+  out[n] = '\0';
+  return n;
+}
+
+static uint64_t trigram_sig(const char *folded, size_t len) {
+  uint64_t sig = 0;
+  for (size_t i = 0; i + 3 <= len; ++i) {
+    uint32_t h = ((uint32_t)(uint8_t)folded[i] << 16) | ((uint32_t)(uint8_t)folded[i + 1] << 8) |
+                 (uint8_t)folded[i + 2];
+    sig |= 1ull << ((h * 0x9E3779B1u) >> 26);
+  }
+  return sig;
+}
+
+static void encode_entry(uint8_t *p, const char *name) {
+  char folded[PPINJECTORUI_MOULD_NAME_LEN];
+  size_t len = fold(name, folded, sizeof(folded));
+  uint64_t sig = trigram_sig(folded, len);
+  PPInjectorUI_put_u32(p, (uint32_t)sig);
+  PPInjectorUI_put_u32(p + 4, (uint32_t)(sig >> 32));
+  memset(p + 8, 0, PPINJECTORUI_MOULD_INDEX_HEAD_LEN);
+  memcpy(p + 8, folded, len < PPINJECTORUI_MOULD_INDEX_HEAD_LEN ? len : PPINJECTORUI_MOULD_INDEX_HEAD_LEN);
+}
+
+static long entry_offset(uint32_t row) {
+  return PPINJECTORUI_MOULD_INDEX_HEADER_SIZE + (long)row * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE;
+}
+
+static bool write_header(PPInjectorUI_mould_index_t *idx, FILE *f) {
+  uint8_t hdr[PPINJECTORUI_MOULD_INDEX_HEADER_SIZE];
+  PPInjectorUI_put_u32(hdr, PPINJECTORUI_MOULD_INDEX_MAGIC);
+  PPInjectorUI_put_u16(hdr + 4, PPINJECTORUI_MOULD_INDEX_VERSION);
+  PPInjectorUI_put_u16(hdr + 6, PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE);
+  PPInjectorUI_put_u32(hdr + 8, idx->count);
+  PPInjectorUI_put_u32(hdr + 12, idx->tag);
+  PPInjectorUI_put_u16(hdr + 16, idx->dirty ? INDEX_FLAG_DIRTY : 0);
+  PPInjectorUI_put_u16(hdr + 18, PPInjectorUI_crc16(hdr, 18));
+  return fseek(f, 0, SEEK_SET) == 0 && fwrite(hdr, 1, sizeof(hdr), f) == sizeof(hdr) && fflush(f) == 0 &&
+         fsync(fileno(f)) == 0;
+}
+
+static bool update_header(PPInjectorUI_mould_index_t *idx) {
+  FILE *f = fopen(idx->path, "r+b");
+  if (!f) {
+    return false;
+  }
+  bool ok = write_header(idx, f);
+  fclose(f);
+  return ok;
+}
+
+// Reads a clean header; false if missing, damaged or left dirty.
+static bool read_clean_header(const char *path, uint32_t *count, uint32_t *tag) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    return false;
+  }
+  uint8_t hdr[PPINJECTORUI_MOULD_INDEX_HEADER_SIZE];
+  bool ok = fread(hdr, 1, sizeof(hdr), f) == sizeof(hdr) &&
+            PPInjectorUI_get_u32(hdr) == PPINJECTORUI_MOULD_INDEX_MAGIC &&
+            PPInjectorUI_get_u16(hdr + 4) == PPINJECTORUI_MOULD_INDEX_VERSION &&
+            PPInjectorUI_get_u16(hdr + 6) == PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE &&
+            PPInjectorUI_get_u16(hdr + 18) == PPInjectorUI_crc16(hdr, 18) &&
+            (PPInjectorUI_get_u16(hdr + 16) & INDEX_FLAG_DIRTY) == 0;
+  fclose(f);
+  if (ok) {
+    *count = PPInjectorUI_get_u32(hdr + 8);
+    *tag = PPInjectorUI_get_u32(hdr + 12);
+  }
+  return ok;
+}
+
+bool PPInjectorUI_mould_index_peek(const char *path, uint32_t *count, uint32_t *tag) {
+  return path && read_clean_header(path, count, tag);
+}
+
+bool PPInjectorUI_mould_index_open(PPInjectorUI_mould_index_t *idx, const char *path, uint32_t expected_count) {
+  memset(idx, 0, sizeof(*idx));
+  if (!path || strlen(path) >= sizeof(idx->path)) {
+    return false;
+  }
+  strcpy(idx->path, path);
+
+  uint32_t count = 0;
+  uint32_t tag = 0;
+  if (read_clean_header(path, &count, &tag) && count == expected_count) {
+    idx->count = count;
+    idx->tag = tag;
+    idx->open = true;
+    return true;
+  }
+  ESP_LOGW(TAG, "%s: missing, stale or damaged, rebuilding", path);
+
+  // Start over empty and dirty; the caller refills it.
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    ESP_LOGE(TAG, "cannot create %s", path);
+    return false;
+  }
+  idx->dirty = true;
+  bool ok = write_header(idx, f);
+  fclose(f);
+  idx->open = ok;
+  return false;
+}
+
+void PPInjectorUI_mould_index_close(PPInjectorUI_mould_index_t *idx) {
+  free(idx->map);
+  idx->map = NULL;
+  idx->map_cap = 0;
+  idx->open = false;
+}
+
+// ------------------ BEGIN RAM map ------------------
+// The whole entry table is read into RAM with one fread on first use and
+// then patched alongside every file write, so search and same() never go
+// back to flash. Without the memory the index just stays file-backed.
+static void drop_map(PPInjectorUI_mould_index_t *idx) {
+  free(idx->map);
+  idx->map = NULL;
+  idx->map_cap = 0;
+}
+
+static bool ensure_map(PPInjectorUI_mould_index_t *idx) {
+  if (idx->map || idx->map_failed) {
+    return idx->map != NULL;
+  }
+  uint32_t cap = idx->count + 16;
+  idx->map = malloc((size_t)cap * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE);
+  FILE *f = idx->map ? fopen(idx->path, "rb") : NULL;
+  size_t bytes = (size_t)idx->count * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE;
+  bool ok = f && fseek(f, entry_offset(0), SEEK_SET) == 0 && fread(idx->map, 1, bytes, f) == bytes;
+  if (f) {
+    fclose(f);
+  }
+  if (!ok) {
+    drop_map(idx);
+    idx->map_failed = true;
+    ESP_LOGW(TAG, "%s: not mapped, searching from flash", idx->path);
+    return false;
+  }
+  idx->map_cap = cap;
+  return true;
+}
+
+static void map_set(PPInjectorUI_mould_index_t *idx, uint32_t row, const uint8_t *entry) {
+  if (!idx->map) {
+    return;
+  }
+  if (row >= idx->map_cap) {
+    uint32_t cap = idx->map_cap * 2;
+    uint8_t *grown = realloc(idx->map, (size_t)cap * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE);
+    if (!grown) {
+      drop_map(idx); // reloaded from the file on next use
+      return;
+    }
+    idx->map = grown;
+    idx->map_cap = cap;
+  }
+  memcpy(idx->map + (size_t)row * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE, entry, PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE);
+}
+// ------------------ END   RAM map ------------------
+
+bool PPInjectorUI_mould_index_begin_update(PPInjectorUI_mould_index_t *idx) {
+  if (!idx->open) {
+    return false;
+  }
+  if (idx->dirty) {
+    return true;
+  }
+  idx->dirty = true;
+  return update_header(idx);
+}
+
+bool PPInjectorUI_mould_index_end_update(PPInjectorUI_mould_index_t *idx) {
+  if (!idx->open || !idx->dirty) {
+    return idx->open;
+  }
+  idx->dirty = false;
+  return update_header(idx);
+}
+
+bool PPInjectorUI_mould_index_same(PPInjectorUI_mould_index_t *idx, uint32_t row, const char *name) {
+  if (!idx->open || row >= idx->count) {
+    return false;
+  }
+  uint8_t want[PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE];
+  uint8_t have[PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE];
+  encode_entry(want, name);
+  if (ensure_map(idx)) {
+    return memcmp(want, idx->map + (size_t)row * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE, sizeof(want)) == 0;
+  }
+  FILE *f = fopen(idx->path, "rb");
+  if (!f) {
+    return false;
+  }
+  bool same = fseek(f, entry_offset(row), SEEK_SET) == 0 && fread(have, 1, sizeof(have), f) == sizeof(have) &&
+              memcmp(want, have, sizeof(want)) == 0;
+  fclose(f);
+  return same;
+}
+
+bool PPInjectorUI_mould_index_set(PPInjectorUI_mould_index_t *idx, uint32_t row, const char *name) {
+  if (!idx->open || row > idx->count || !PPInjectorUI_mould_index_begin_update(idx)) {
+    return false;
+  }
+  FILE *f = fopen(idx->path, "r+b");
+  if (!f) {
+    return false;
+  }
+  uint8_t entry[PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE];
+  encode_entry(entry, name);
+  bool ok = fseek(f, entry_offset(row), SEEK_SET) == 0 && fwrite(entry, 1, sizeof(entry), f) == sizeof(entry);
+  fclose(f);
+  if (!ok) {
+    drop_map(idx);
+    return false;
+  }
+  map_set(idx, row, entry);
+  if (row == idx->count) {
+    idx->count++;
+  }
+  return true;
+}
+
+// Shifts the tail down in place. Not atomic, which is fine: the dirty flag
+// is set for the duration and a torn shift just means a rebuild.
+bool PPInjectorUI_mould_index_remove(PPInjectorUI_mould_index_t *idx, uint32_t row) {
+  if (!idx->open || row >= idx->count || !PPInjectorUI_mould_index_begin_update(idx)) {
+    return false;
+  }
+  FILE *f = fopen(idx->path, "r+b");
+  if (!f) {
+    return false;
+  }
+  uint8_t buf[SCAN_CHUNK * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE];
+  bool ok = true;
+  for (uint32_t from = row + 1; ok && from < idx->count;) {
+    uint32_t n = idx->count - from;
+    if (n > SCAN_CHUNK) {
+      n = SCAN_CHUNK;
+    }
+    size_t bytes = (size_t)n * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE;
+    ok = fseek(f, entry_offset(from), SEEK_SET) == 0 && fread(buf, 1, bytes, f) == bytes &&
+         fseek(f, entry_offset(from - 1), SEEK_SET) == 0 && fwrite(buf, 1, bytes, f) == bytes;
+    from += n;
+  }
+  fclose(f);
+  if (!ok) {
+    drop_map(idx);
+    return false;
+  }
+  if (idx->map) {
+    memmove(idx->map + (size_t)row * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE,
+            idx->map + (size_t)(row + 1) * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE,
+            (size_t)(idx->count - row - 1) * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE);
+  }
+  idx->count--;
+  return true;
+}
+
+void PPInjectorUI_mould_search_begin(PPInjectorUI_mould_search_t *s, const char *query) {
+  memset(s, 0, sizeof(*s));
+  s->len = fold(query, s->query, sizeof(s->query));
+  if (s->len >= PPINJECTORUI_MOULD_SEARCH_MIN_TRIGRAM) {
+    s->sig = trigram_sig(s->query, s->len);
+  }
+}
+
+static bool entry_may_match(const uint8_t *p, const PPInjectorUI_mould_search_t *s) {
+  if (s->len < PPINJECTORUI_MOULD_SEARCH_MIN_TRIGRAM) {
+    return memcmp(p + 8, s->query, s->len) == 0;
+  }
+  uint64_t sig = (uint64_t)PPInjectorUI_get_u32(p) | ((uint64_t)PPInjectorUI_get_u32(p + 4) << 32);
+  return (sig & s->sig) == s->sig;
+}
+
+int PPInjectorUI_mould_search_step(PPInjectorUI_mould_index_t *idx, PPInjectorUI_mould_search_t *s,
+                                   uint32_t max_rows, uint32_t *rows, int cap) {
+  if (!idx->open) {
+    return -1;
+  }
+  uint32_t end = s->next + max_rows;
+  if (end > idx->count || end < s->next) {
+    end = idx->count;
+  }
+  if (s->next >= end || cap <= 0) {
+    return 0;
+  }
+  int found = 0;
+  if (ensure_map(idx)) {
+    for (; s->next < end && found < cap; s->next++) {
+      if (entry_may_match(idx->map + (size_t)s->next * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE, s)) {
+        rows[found++] = s->next;
+      }
+    }
+    return found;
+  }
+
+  FILE *f = fopen(idx->path, "rb");
+  if (!f) {
+    return -1;
+  }
+  uint8_t buf[SCAN_CHUNK * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE];
+  bool ok = fseek(f, entry_offset(s->next), SEEK_SET) == 0;
+  while (ok && s->next < end && found < cap) {
+    uint32_t n = end - s->next;
+    if (n > SCAN_CHUNK) {
+      n = SCAN_CHUNK;
+    }
+    size_t bytes = (size_t)n * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE;
+    ok = fread(buf, 1, bytes, f) == bytes;
+    for (uint32_t i = 0; ok && i < n; ++i) {
+      if (entry_may_match(buf + i * PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE, s)) {
+        rows[found++] = s->next + i;
+        if (found == cap) {
+          n = i + 1; // resume right after the last stored row
+          break;
+        }
+      }
+    }
+    if (ok) {
+      s->next += n;
+      ok = fseek(f, entry_offset(s->next), SEEK_SET) == 0;
+    }
+  }
+  fclose(f);
+  return ok ? found : -1;
+}
+
+bool PPInjectorUI_mould_name_matches(const char *name, const PPInjectorUI_mould_search_t *s) {
+  char folded[PPINJECTORUI_MOULD_NAME_LEN];
+  fold(name, folded, sizeof(folded));
+  if (s->len < PPINJECTORUI_MOULD_SEARCH_MIN_TRIGRAM) {
+    return strncmp(folded, s->query, s->len) == 0;
+  }
+  return strstr(folded, s->query) != NULL;
+}
+
+// ------------------ BEGIN Benchmark ------------------
+#if CONFIG_PPINJECTORUI_MOULD_INDEX_BENCH
+
+static void bench_name(uint32_t row, char *out, size_t out_len) {
+  static const char *const kParts[] = {"Cap", "Bottle", "Lid", "Gear", "Clip", "Hook", "Ring", "Knob"};
+  snprintf(out, out_len, "%s %s %lu", kParts[row % 8], kParts[(row / 8) % 8], (unsigned long)row);
+}
+
+static bool benchmark_query(PPInjectorUI_mould_index_t *idx, const char *query, const char *from) {
+  PPInjectorUI_mould_search_t s;
+  uint32_t rows[SCAN_CHUNK];
+  uint32_t candidates = 0;
+  uint32_t matches = 0;
+  uint32_t steps = 0;
+  uint32_t worst_us = 0;
+  char name[PPINJECTORUI_MOULD_NAME_LEN];
+
+  int64_t t0 = esp_timer_get_time();
+  PPInjectorUI_mould_search_begin(&s, query);
+  while (s.next < idx->count) {
+    int64_t ts = esp_timer_get_time();
+    int n = PPInjectorUI_mould_search_step(idx, &s, 256, rows, SCAN_CHUNK);
+    if (n < 0) {
+      return false;
+    }
+    for (int i = 0; i < n; ++i) {
+      bench_name(rows[i], name, sizeof(name));
+      matches += PPInjectorUI_mould_name_matches(name, &s) ? 1 : 0;
+    }
+    candidates += (uint32_t)n;
+    uint32_t us = (uint32_t)(esp_timer_get_time() - ts);
+    worst_us = us > worst_us ? us : worst_us;
+    steps++;
+  }
+  uint32_t total_us = (uint32_t)(esp_timer_get_time() - t0);
+  ESP_LOGI(TAG, "bench %s '%s': %lu matches / %lu candidates, %lu steps, worst step %lu us, full scan %lu us", from,
+           query, (unsigned long)matches, (unsigned long)candidates, (unsigned long)steps, (unsigned long)worst_us,
+           (unsigned long)total_us);
+  return true;
+}
+
+void PPInjectorUI_mould_index_benchmark(const char *path, uint32_t rows) {
+  PPInjectorUI_mould_index_t idx;
+  char name[PPINJECTORUI_MOULD_NAME_LEN];
+  remove(path);
+  PPInjectorUI_mould_index_open(&idx, path, 0);
+  int64_t t0 = esp_timer_get_time();
+  for (uint32_t row = 0; row < rows; ++row) {
+    bench_name(row, name, sizeof(name));
+    if (!PPInjectorUI_mould_index_set(&idx, row, name)) {
+      ESP_LOGE(TAG, "bench: build failed at row %lu", (unsigned long)row);
+      PPInjectorUI_mould_index_close(&idx);
+      remove(path);
+      return;
+    }
+  }
+  PPInjectorUI_mould_index_end_update(&idx);
+  ESP_LOGI(TAG, "bench: built %lu entries (%lu bytes) in %lu us", (unsigned long)rows,
+           (unsigned long)entry_offset(rows), (unsigned long)(esp_timer_get_time() - t0));
+
+  static const char *const kQueries[] = {"c", "ge", "hook", "lid ring", "9", "clip knob 6", "zzz"};
+  const size_t query_count = sizeof(kQueries) / sizeof(kQueries[0]);
+  idx.map_failed = true; // flash-backed scans first
+  for (size_t i = 0; i < query_count; ++i) {
+    benchmark_query(&idx, kQueries[i], "flash");
+  }
+  idx.map_failed = false;
+  t0 = esp_timer_get_time();
+  bool mapped = ensure_map(&idx);
+  ESP_LOGI(TAG, "bench: mapping %s in %lu us", mapped ? "loaded" : "FAILED",
+           (unsigned long)(esp_timer_get_time() - t0));
+  for (size_t i = 0; mapped && i < query_count; ++i) {
+    benchmark_query(&idx, kQueries[i], "ram");
+  }
+
+  t0 = esp_timer_get_time();
+  PPInjectorUI_mould_index_remove(&idx, 0);
+  PPInjectorUI_mould_index_end_update(&idx);
+  ESP_LOGI(TAG, "bench: remove of row 0 took %lu us", (unsigned long)(esp_timer_get_time() - t0));
+  PPInjectorUI_mould_index_close(&idx);
+  remove(path);
+}
+
+#else
+
+void PPInjectorUI_mould_index_benchmark(const char *path, uint32_t rows) {
+  (void)path;
+  (void)rows;
+}
+
+#endif
+// ------------------ END   Benchmark ------------------
@@ -0,0 +1,702 @@
+// BEGIN --- Standard C headers section ---
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// END   --- Standard C headers section ---
+
+// BEGIN --- SDK config section---
+#include <sdkconfig.h>
+// END   --- SDK config section---
+
+// BEGIN --- ESP-IDF headers section ---
+#include "esp_log.h"
+// END   --- ESP-IDF headers section ---
+
+// BEGIN --- Self-includes section ---
+#include "PPInjectorUI_mould_store.h"
+// END --- Self-includes section ---
+
+static const char *TAG = "PPInjectorUI_mst";
+
+#define SLOT_SIZE (2 * PPINJECTORUI_MOULD_STORE_COPY_SIZE)
+#define COPY_FLAG_LIVE 0x01
+
+typedef struct {
+  bool valid;
+  uint32_t seq;
+  bool live;
+  PPInjectorUI_mould_record_t rec;
+} copy_t;
+
+// ------------------ BEGIN Fault injection ------------------
+// The self-test simulates a power cut by letting only `s_fault_budget` more
+// bytes reach the file; the write that crosses it is truncated there and
+// every later write, rename or remove fails. Negative means disabled.
+#if CONFIG_PPINJECTORUI_STORAGE_SELFTEST
+static long s_fault_budget = -1;
+static long s_fault_written = 0;
+
+// Renames and removes cost one unit of budget each, so the replay also cuts
+// between them.
+static bool fault_step(void) {
+  if (s_fault_budget >= 0 && s_fault_written >= s_fault_budget) {
+    return false;
+  }
+  s_fault_written++;
+  return true;
+}
+
+static size_t store_fwrite(const void *buf, size_t len, FILE *f) {
+  size_t n = len;
+  if (s_fault_budget >= 0) {
+    long left = s_fault_budget - s_fault_written;
+    if (left <= 0) {
+      return 0;
+    }
+    if ((long)n > left) {
+      n = (size_t)left;
+    }
+  }
+  size_t done = fwrite(buf, 1, n, f);
+  s_fault_written += (long)done;
+  return done;
+}
+
+static int store_rename(const char *from, const char *to) { return fault_step() ? rename(from, to) : -1; }
+static int store_remove(const char *path) { return fault_step() ? remove(path) : -1; }
+#else
+static size_t store_fwrite(const void *buf, size_t len, FILE *f) { return fwrite(buf, 1, len, f); }
+static int store_rename(const char *from, const char *to) { return rename(from, to); }
+static int store_remove(const char *path) { return remove(path); }
+#endif
+// ------------------ END   Fault injection ------------------
+
+static bool write_all(FILE *f, const void *buf, size_t len) { return store_fwrite(buf, len, f) == len; }
+
+static bool sync_file(FILE *f) { return fflush(f) == 0 && fsync(fileno(f)) == 0; }
+
+static void tmp_path(const PPInjectorUI_mould_store_t *s, char *out, size_t out_len) {
+  snprintf(out, out_len, "%s.tmp", s->path);
+}
+
+static bool file_exists(const char *path) {
+  struct stat st;
+  return stat(path, &st) == 0;
+}
+
+static void encode_header(uint8_t *p) {
+  memset(p, 0, PPINJECTORUI_MOULD_STORE_HEADER_SIZE);
+  PPInjectorUI_put_u32(p, PPINJECTORUI_MOULD_STORE_MAGIC);
+  PPInjectorUI_put_u16(p + 4, PPINJECTORUI_MOULD_STORE_VERSION);
+  PPInjectorUI_put_u16(p + 6, PPINJECTORUI_MOULD_RECORD_SIZE);
+  PPInjectorUI_put_u16(p + 14, PPInjectorUI_crc16(p, 14));
+}
+
+static void encode_copy(uint8_t *p, uint32_t seq, bool live, const PPInjectorUI_mould_record_t *rec) {
+  memset(p, 0, PPINJECTORUI_MOULD_STORE_COPY_SIZE);
+  PPInjectorUI_put_u32(p, seq);
+  if (live) {
+    PPInjectorUI_put_u32(p + 4, rec->id);
+    PPInjectorUI_put_u32(p + 8, rec->modified);
+    p[12] = COPY_FLAG_LIVE;
+    memcpy(p + 14, rec->data, PPINJECTORUI_MOULD_RECORD_SIZE);
+  }
+  PPInjectorUI_put_u16(p + PPINJECTORUI_MOULD_STORE_COPY_SIZE - 2,
+                       PPInjectorUI_crc16(p, PPINJECTORUI_MOULD_STORE_COPY_SIZE - 2));
+}
+
+// A never-written copy (seq 0) counts as invalid but not as damaged.
+static void decode_copy(PPInjectorUI_mould_store_t *s, const uint8_t *p, copy_t *c) {
+  memset(c, 0, sizeof(*c));
+  c->seq = PPInjectorUI_get_u32(p);
+  if (c->seq == 0) {
+    return;
+  }
+  uint16_t crc = PPInjectorUI_get_u16(p + PPINJECTORUI_MOULD_STORE_COPY_SIZE - 2);
+  if (crc != PPInjectorUI_crc16(p, PPINJECTORUI_MOULD_STORE_COPY_SIZE - 2)) {
+    s->stats.bad_copies++;
+    return;
+  }
+  c->valid = true;
+  c->live = (p[12] & COPY_FLAG_LIVE) != 0;
+  c->rec.id = PPInjectorUI_get_u32(p + 4);
+  c->rec.modified = PPInjectorUI_get_u32(p + 8);
+  memcpy(c->rec.data, p + 14, PPINJECTORUI_MOULD_RECORD_SIZE);
+}
+
+static long slot_offset(uint32_t slot) { return PPINJECTORUI_MOULD_STORE_HEADER_SIZE + (long)slot * SLOT_SIZE; }
+
+// Reads both copies of `slot` and returns the index (0/1) of the current
+// one, or -1 if neither is valid.
+static int read_slot(PPInjectorUI_mould_store_t *s, FILE *f, uint32_t slot, copy_t c[2]) {
+  uint8_t buf[SLOT_SIZE];
+  if (fseek(f, slot_offset(slot), SEEK_SET) != 0 || fread(buf, 1, sizeof(buf), f) != sizeof(buf)) {
+    return -2;
+  }
+  decode_copy(s, buf, &c[0]);
+  decode_copy(s, buf + PPINJECTORUI_MOULD_STORE_COPY_SIZE, &c[1]);
+  if (!c[0].valid && !c[1].valid) {
+    return -1;
+  }
+  if (!c[1].valid) {
+    return 0;
+  }
+  if (!c[0].valid) {
+    return 1;
+  }
+  return (c[1].seq > c[0].seq) ? 1 : 0;
+}
+
+static bool write_copy(FILE *f, uint32_t slot, int which, uint32_t seq, bool live,
+                       const PPInjectorUI_mould_record_t *rec) {
+  uint8_t buf[PPINJECTORUI_MOULD_STORE_COPY_SIZE];
+  encode_copy(buf, seq, live, rec);
+  long off = slot_offset(slot) + (long)which * PPINJECTORUI_MOULD_STORE_COPY_SIZE;
+  return fseek(f, off, SEEK_SET) == 0 && write_all(f, buf, sizeof(buf)) && sync_file(f);
+}
+
+static bool read_header(const PPInjectorUI_mould_store_t *s, FILE *f) {
+  uint8_t hdr[PPINJECTORUI_MOULD_STORE_HEADER_SIZE];
+  bool ok = fread(hdr, 1, sizeof(hdr), f) == sizeof(hdr) &&
+            PPInjectorUI_get_u32(hdr) == PPINJECTORUI_MOULD_STORE_MAGIC &&
+            PPInjectorUI_get_u16(hdr + 14) == PPInjectorUI_crc16(hdr, 14);
+  if (!ok) {
+    ESP_LOGE(TAG, "%s: bad header", s->path);
+    return false;
+  }
+  uint16_t version = PPInjectorUI_get_u16(hdr + 4);
+  uint16_t rec_size = PPInjectorUI_get_u16(hdr + 6);
+  if (version != PPINJECTORUI_MOULD_STORE_VERSION || rec_size != PPINJECTORUI_MOULD_RECORD_SIZE) {
+    ESP_LOGE(TAG, "%s: unsupported version %u (record %u bytes)", s->path, version, rec_size);
+    return false;
+  }
+  return true;
+}
+
+static bool scan(PPInjectorUI_mould_store_t *s) {
+  FILE *f = fopen(s->path, "rb");
+  if (!f) {
+    return false;
+  }
+  if (!read_header(s, f)) {
+    fclose(f);
+    return false;
+  }
+
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  // A torn append leaves a partial slot at the end; it is ignored here and
+  // overwritten by the next append.
+  s->slots = (size > PPINJECTORUI_MOULD_STORE_HEADER_SIZE)
+                 ? (uint32_t)((size - PPINJECTORUI_MOULD_STORE_HEADER_SIZE) / SLOT_SIZE)
+                 : 0;
+  s->next_id = 1;
+  s->live = 0;
+  s->stats.scans++;
+  for (uint32_t i = 0; i < s->slots; ++i) {
+    copy_t c[2];
+    int cur = read_slot(s, f, i, c);
+    if (cur == -2) {
+      break;
+    }
+    if (cur >= 0 && c[cur].live) {
+      s->live++;
+    }
+    for (int k = 0; k < 2; ++k) {
+      if (c[k].valid && c[k].rec.id >= s->next_id) {
+        s->next_id = c[k].rec.id + 1;
+      }
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+// A temp file only replaces a missing store when it is whole: the exact
+// header and a size that ends on a slot boundary. On first creation there is
+// no old file to fall back on, so a cut while writing the header leaves a
+// partial temp file behind and nothing else.
+static bool tmp_is_complete(const char *tmp) {
+  FILE *f = fopen(tmp, "rb");
+  if (!f) {
+    return false;
+  }
+  uint8_t hdr[PPINJECTORUI_MOULD_STORE_HEADER_SIZE];
+  uint8_t want[PPINJECTORUI_MOULD_STORE_HEADER_SIZE];
+  encode_header(want);
+  bool ok = fread(hdr, 1, sizeof(hdr), f) == sizeof(hdr) && memcmp(hdr, want, sizeof(hdr)) == 0 &&
+            fseek(f, 0, SEEK_END) == 0;
+  long size = ok ? ftell(f) : -1;
+  fclose(f);
+  return ok && size >= PPINJECTORUI_MOULD_STORE_HEADER_SIZE &&
+         (size - PPINJECTORUI_MOULD_STORE_HEADER_SIZE) % SLOT_SIZE == 0;
+}
+
+// Temp-file rewrite: begin_tmp() writes the header, each record goes in as a
+// fresh slot, finish_tmp() swaps the file in.
+static FILE *begin_tmp(const PPInjectorUI_mould_store_t *s, char *tmp, size_t tmp_len) {
+  tmp_path(s, tmp, tmp_len);
+  FILE *f = fopen(tmp, "wb");
+  if (!f) {
+    ESP_LOGE(TAG, "cannot create %s", tmp);
+    return NULL;
+  }
+  uint8_t hdr[PPINJECTORUI_MOULD_STORE_HEADER_SIZE];
+  encode_header(hdr);
+  if (!write_all(f, hdr, sizeof(hdr))) {
+    fclose(f);
+    ESP_LOGE(TAG, "write %s failed", tmp);
+    return NULL;
+  }
+  return f;
+}
+
+static bool tmp_append(FILE *f, const PPInjectorUI_mould_record_t *rec) {
+  uint8_t buf[SLOT_SIZE];
+  encode_copy(buf, 1, true, rec);
+  memset(buf + PPINJECTORUI_MOULD_STORE_COPY_SIZE, 0, PPINJECTORUI_MOULD_STORE_COPY_SIZE);
+  return write_all(f, buf, sizeof(buf));
+}
+
+static bool finish_tmp(PPInjectorUI_mould_store_t *s, FILE *f, const char *tmp, bool ok) {
+  ok = ok && sync_file(f);
+  fclose(f);
+  if (!ok) {
+    ESP_LOGE(TAG, "write %s failed", tmp);
+    return false;
+  }
+
+  // SPIFFS rename() does not replace an existing file. The temp file is
+  // complete at this point, so open() finishes the job if we die between
+  // the remove and the rename.
+  if ((file_exists(s->path) && store_remove(s->path) != 0) || store_rename(tmp, s->path) != 0) {
+    ESP_LOGE(TAG, "replace %s failed", s->path);
+    return false;
+  }
+  s->stats.rewrites++;
+  return true;
+}
+
+bool PPInjectorUI_mould_store_rewrite(PPInjectorUI_mould_store_t *s, const PPInjectorUI_mould_record_t *recs,
+                                      uint32_t count) {
+  char tmp[PPINJECTORUI_MOULD_STORE_PATH_MAX + 4];
+  FILE *f = begin_tmp(s, tmp, sizeof(tmp));
+  if (!f) {
+    return false;
+  }
+  bool ok = true;
+  for (uint32_t i = 0; ok && i < count; ++i) {
+    ok = tmp_append(f, &recs[i]);
+  }
+  if (!finish_tmp(s, f, tmp, ok)) {
+    return false;
+  }
+  s->slots = count;
+  s->live = count;
+  s->next_id = 1;
+  for (uint32_t i = 0; i < count; ++i) {
+    if (recs[i].id >= s->next_id) {
+      s->next_id = recs[i].id + 1;
+    }
+  }
+  return true;
+}
+
+// Streams the live records into the temp file one slot at a time, so the
+// cost in RAM does not grow with the store.
+bool PPInjectorUI_mould_store_remove(PPInjectorUI_mould_store_t *s, uint32_t slot) {
+  if (!s->open) {
+    return false;
+  }
+  FILE *src = fopen(s->path, "rb");
+  if (!src) {
+    return false;
+  }
+  char tmp[PPINJECTORUI_MOULD_STORE_PATH_MAX + 4];
+  FILE *f = begin_tmp(s, tmp, sizeof(tmp));
+  if (!f) {
+    fclose(src);
+    return false;
+  }
+  bool ok = true;
+  uint32_t kept = 0;
+  for (uint32_t i = 0; ok && i < s->slots; ++i) {
+    copy_t c[2];
+    int cur = read_slot(s, src, i, c);
+    if (cur == -2) {
+      ok = false;
+    } else if (i != slot && cur >= 0 && c[cur].live) {
+      ok = tmp_append(f, &c[cur].rec);
+      kept++;
+    }
+  }
+  fclose(src);
+  if (!finish_tmp(s, f, tmp, ok)) {
+    return false;
+  }
+  s->slots = kept;
+  s->live = kept;
+  return true;
+}
+
+bool PPInjectorUI_mould_store_open(PPInjectorUI_mould_store_t *s, const char *path) {
+  memset(s, 0, sizeof(*s));
+  if (!path || strlen(path) >= sizeof(s->path)) {
+    return false;
+  }
+  strcpy(s->path, path);
+
+  char tmp[PPINJECTORUI_MOULD_STORE_PATH_MAX + 4];
+  tmp_path(s, tmp, sizeof(tmp));
+  if (file_exists(tmp)) {
+    if (file_exists(s->path)) {
+      // Rewrite died before the swap: the old file is still authoritative.
+      store_remove(tmp);
+    } else if (!tmp_is_complete(tmp)) {
+      // Creation died mid-header: start over from an empty store below.
+      ESP_LOGW(TAG, "%s: discarding partial %s", s->path, tmp);
+      store_remove(tmp);
+    } else if (store_rename(tmp, s->path) == 0) {
+      ESP_LOGW(TAG, "%s: completed interrupted rewrite", s->path);
+    }
+  }
+
+  if (!file_exists(s->path)) {
+    if (!PPInjectorUI_mould_store_rewrite(s, NULL, 0)) {
+      return false;
+    }
+    s->stats.rewrites = 0;
+  } else if (!scan(s)) {
+    return false;
+  }
+  s->open = true;
+  return true;
+}
+
+bool PPInjectorUI_mould_store_open_summary(PPInjectorUI_mould_store_t *s, const char *path, uint32_t slots,
+                                           uint32_t next_id) {
+  memset(s, 0, sizeof(*s));
+  if (!path || strlen(path) >= sizeof(s->path)) {
+    return false;
+  }
+  strcpy(s->path, path);
+
+  // Anything left to recover, or a size that disagrees, means the summary
+  // may be stale: take the scanning path.
+  char tmp[PPINJECTORUI_MOULD_STORE_PATH_MAX + 4];
+  tmp_path(s, tmp, sizeof(tmp));
+  FILE *f = (next_id > 0 && !file_exists(tmp)) ? fopen(path, "rb") : NULL;
+  if (f) {
+    bool ok = read_header(s, f) && fseek(f, 0, SEEK_END) == 0 && ftell(f) == slot_offset(slots);
+    fclose(f);
+    if (ok) {
+      s->slots = slots;
+      s->live = slots;
+      s->next_id = next_id;
+      s->open = true;
+      return true;
+    }
+  }
+  return PPInjectorUI_mould_store_open(s, path);
+}
+
+uint32_t PPInjectorUI_mould_store_slots(const PPInjectorUI_mould_store_t *s) { return s->open ? s->slots : 0; }
+
+int PPInjectorUI_mould_store_get(PPInjectorUI_mould_store_t *s, uint32_t slot, PPInjectorUI_mould_record_t *rec) {
+  if (!s->open || slot >= s->slots) {
+    return -1;
+  }
+  FILE *f = fopen(s->path, "rb");
+  if (!f) {
+    return -1;
+  }
+  copy_t c[2];
+  int cur = read_slot(s, f, slot, c);
+  fclose(f);
+  if (cur == -2) {
+    return -1;
+  }
+  if (cur < 0 || !c[cur].live) {
+    return 0;
+  }
+  *rec = c[cur].rec;
+  return 1;
+}
+
+int PPInjectorUI_mould_store_get_range(PPInjectorUI_mould_store_t *s, uint32_t first, uint32_t count,
+                                       PPInjectorUI_mould_record_t *recs) {
+  if (!s->open || first >= s->slots) {
+    return (s->open && first == s->slots) ? 0 : -1;
+  }
+  if (count > s->slots - first) {
+    count = s->slots - first;
+  }
+  FILE *f = fopen(s->path, "rb");
+  if (!f) {
+    return -1;
+  }
+  uint32_t n = 0;
+  for (; n < count; ++n) {
+    copy_t c[2];
+    int cur = read_slot(s, f, first + n, c);
+    if (cur == -2) {
+      break;
+    }
+    if (cur >= 0 && c[cur].live) {
+      recs[n] = c[cur].rec;
+    } else {
+      memset(&recs[n], 0, sizeof(recs[n]));
+    }
+  }
+  fclose(f);
+  return (n == count) ? (int)n : -1;
+}
+
+static int put_copy(PPInjectorUI_mould_store_t *s, uint32_t slot, bool live, PPInjectorUI_mould_record_t *rec) {
+  if (!s->open || slot > s->slots) {
+    return -1;
+  }
+  FILE *f = fopen(s->path, "r+b");
+  if (!f) {
+    return -1;
+  }
+
+  bool ok;
+  if (slot == s->slots) {
+    if (!live) {
+      fclose(f);
+      return 0;
+    }
+    if (rec->id == 0) {
+      rec->id = s->next_id;
+    }
+    // Copy B stays zero (never written) until the first update.
+    uint8_t buf[SLOT_SIZE];
+    encode_copy(buf, 1, true, rec);
+    memset(buf + PPINJECTORUI_MOULD_STORE_COPY_SIZE, 0, PPINJECTORUI_MOULD_STORE_COPY_SIZE);
+    ok = fseek(f, slot_offset(slot), SEEK_SET) == 0 && write_all(f, buf, sizeof(buf)) && sync_file(f);
+    if (ok) {
+      s->slots++;
+      s->live++;
+    }
+  } else {
+    copy_t c[2];
+    int cur = read_slot(s, f, slot, c);
+    if (cur == -2) {
+      fclose(f);
+      return -1;
+    }
+    bool was_live = cur >= 0 && c[cur].live;
+    if (live && rec->id == 0) {
+      rec->id = was_live ? c[cur].rec.id : s->next_id;
+    }
+    if (was_live == live &&
+        (!live || (c[cur].rec.id == rec->id && memcmp(c[cur].rec.data, rec->data, sizeof(rec->data)) == 0))) {
+      fclose(f);
+      s->stats.records_unchanged++;
+      return 0;
+    }
+    uint32_t seq = (cur >= 0) ? c[cur].seq + 1 : 1;
+    int target = (cur == 0) ? 1 : 0;
+    ok = write_copy(f, slot, target, seq, live, rec);
+    if (ok && was_live != live) {
+      s->live = live ? s->live + 1 : s->live - 1;
+    }
+  }
+  fclose(f);
+  if (!ok) {
+    ESP_LOGE(TAG, "%s: write slot %u failed", s->path, (unsigned)slot);
+    return -1;
+  }
+  if (live && rec->id >= s->next_id) {
+    s->next_id = rec->id + 1;
+  }
+  s->stats.records_written++;
+  return 1;
+}
+
+int PPInjectorUI_mould_store_put(PPInjectorUI_mould_store_t *s, uint32_t slot, PPInjectorUI_mould_record_t *rec) {
+  return put_copy(s, slot, true, rec);
+}
+
+int PPInjectorUI_mould_store_erase(PPInjectorUI_mould_store_t *s, uint32_t slot) {
+  if (slot >= s->slots) {
+    return 0;
+  }
+  PPInjectorUI_mould_record_t none = {0};
+  return put_copy(s, slot, false, &none);
+}
+
+// ------------------ BEGIN Power-cut self-test ------------------
+#if CONFIG_PPINJECTORUI_STORAGE_SELFTEST
+
+typedef enum { OP_APPEND, OP_UPDATE, OP_ERASE, OP_REMOVE, OP_REWRITE, OP_COUNT } selftest_op_t;
+
+static const char *const kOpNames[OP_COUNT] = {"append", "update", "erase", "remove", "rewrite"};
+
+static void selftest_record(PPInjectorUI_mould_record_t *rec, uint32_t id, uint8_t fill) {
+  rec->id = id;
+  rec->modified = 1000u + id;
+  memset(rec->data, fill, sizeof(rec->data));
+  snprintf((char *)rec->data, 32, "ST_%u_%02X", (unsigned)id, fill);
+}
+
+static bool same_record(const PPInjectorUI_mould_record_t *a, const PPInjectorUI_mould_record_t *b) {
+  return a->id == b->id && memcmp(a->data, b->data, sizeof(a->data)) == 0;
+}
+
+// Slot content after reopen: live record `rec` or empty (NULL).
+static bool slot_is(PPInjectorUI_mould_store_t *s, uint32_t slot, const PPInjectorUI_mould_record_t *rec) {
+  PPInjectorUI_mould_record_t got;
+  int r = (slot < PPInjectorUI_mould_store_slots(s)) ? PPInjectorUI_mould_store_get(s, slot, &got) : 0;
+  return rec ? (r == 1 && same_record(&got, rec)) : (r == 0);
+}
+
+static void selftest_apply(PPInjectorUI_mould_store_t *s, selftest_op_t op, const PPInjectorUI_mould_record_t *next) {
+  PPInjectorUI_mould_record_t rec = *next;
+  switch (op) {
+  case OP_APPEND:
+    PPInjectorUI_mould_store_put(s, 2, &rec);
+    break;
+  case OP_UPDATE:
+    PPInjectorUI_mould_store_put(s, 1, &rec);
+    break;
+  case OP_ERASE:
+    PPInjectorUI_mould_store_erase(s, 0);
+    break;
+  case OP_REMOVE:
+    PPInjectorUI_mould_store_remove(s, 0);
+    break;
+  default:
+    PPInjectorUI_mould_store_rewrite(s, &rec, 1);
+    break;
+  }
+}
+
+// Every slot must hold either its pre-op or its post-op content, and the
+// store must look entirely old or entirely new for a rewrite.
+static bool selftest_check(PPInjectorUI_mould_store_t *s, selftest_op_t op, const PPInjectorUI_mould_record_t base[2],
+                           const PPInjectorUI_mould_record_t *next) {
+  switch (op) {
+  case OP_APPEND:
+    return slot_is(s, 0, &base[0]) && slot_is(s, 1, &base[1]) && (slot_is(s, 2, NULL) || slot_is(s, 2, next));
+  case OP_UPDATE:
+    return slot_is(s, 0, &base[0]) && (slot_is(s, 1, &base[1]) || slot_is(s, 1, next));
+  case OP_ERASE:
+    return (slot_is(s, 0, &base[0]) || slot_is(s, 0, NULL)) && slot_is(s, 1, &base[1]);
+  case OP_REMOVE:
+    return (s->slots == 2 && slot_is(s, 0, &base[0]) && slot_is(s, 1, &base[1])) ||
+           (s->slots == 1 && slot_is(s, 0, &base[1]));
+  default: {
+    bool old_state = s->slots == 2 && slot_is(s, 0, &base[0]) && slot_is(s, 1, &base[1]);
+    bool new_state = s->slots == 1 && slot_is(s, 0, next);
+    return old_state || new_state;
+  }
+  }
+}
+
+bool PPInjectorUI_mould_store_selftest(const char *path) {
+  PPInjectorUI_mould_store_t s;
+  PPInjectorUI_mould_record_t base[2];
+  PPInjectorUI_mould_record_t next;
+  selftest_record(&base[0], 1, 0xA1);
+  selftest_record(&base[1], 2, 0xB2);
+  uint32_t failures = 0;
+  uint32_t cuts = 0;
+
+  for (int op = 0; op < OP_COUNT; ++op) {
+    selftest_record(&next, (op == OP_UPDATE) ? 2 : 3, 0xC3);
+    // Put the update on top of an already-updated slot too, so both copy
+    // positions get overwritten over the run.
+    for (int pre_updates = 0; pre_updates < ((op == OP_UPDATE) ? 2 : 1); ++pre_updates) {
+      long total = 0;
+      for (long budget = 0;; ++budget) {
+        if (!PPInjectorUI_mould_store_open(&s, path) || !PPInjectorUI_mould_store_rewrite(&s, base, 2)) {
+          ESP_LOGE(TAG, "selftest: cannot reset %s", path);
+          return false;
+        }
+        for (int i = 0; i < pre_updates; ++i) {
+          PPInjectorUI_mould_record_t again = base[1];
+          again.data[40] ^= 0xFF;
+          PPInjectorUI_mould_store_put(&s, 1, &again);
+          again.data[40] ^= 0xFF;
+          PPInjectorUI_mould_store_put(&s, 1, &again);
+        }
+        s_fault_written = 0;
+        s_fault_budget = budget;
+        selftest_apply(&s, (selftest_op_t)op, &next);
+        long written = s_fault_written;
+        bool complete = written < budget;
+        s_fault_budget = -1;
+
+        PPInjectorUI_mould_store_t reopened;
+        bool ok = PPInjectorUI_mould_store_open(&reopened, path) &&
+                  selftest_check(&reopened, (selftest_op_t)op, base, &next);
+        if (complete) {
+          // Uncut run: it must land on the new state exactly.
+          ok = ok && (op == OP_ERASE    ? slot_is(&reopened, 0, NULL)
+                      : op == OP_REMOVE ? reopened.slots == 1
+                      : op == OP_APPEND ? slot_is(&reopened, 2, &next)
+                      : op == OP_UPDATE ? slot_is(&reopened, 1, &next)
+                                        : reopened.slots == 1);
+        }
+        cuts++;
+        if (!ok) {
+          failures++;
+          ESP_LOGE(TAG, "selftest: %s cut after %ld bytes left an invalid store", kOpNames[op], budget);
+        }
+        if (complete) {
+          total = written;
+          break;
+        }
+      }
+      ESP_LOGI(TAG, "selftest: %s (%d prior updates): %ld cut points checked", kOpNames[op],
+               pre_updates * 2, total);
+    }
+  }
+
+  // First creation: no store yet, so open() writes an empty one through the
+  // temp file and a cut there has no old file to fall back on.
+  char tmp[PPINJECTORUI_MOULD_STORE_PATH_MAX + 4];
+  snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+  long total = 0;
+  for (long budget = 0;; ++budget) {
+    remove(path);
+    remove(tmp);
+    s_fault_written = 0;
+    s_fault_budget = budget;
+    PPInjectorUI_mould_store_open(&s, path);
+    long written = s_fault_written;
+    bool complete = written < budget;
+    s_fault_budget = -1;
+
+    PPInjectorUI_mould_store_t reopened;
+    bool ok = PPInjectorUI_mould_store_open(&reopened, path) && reopened.slots == 0;
+    cuts++;
+    if (!ok) {
+      failures++;
+      ESP_LOGE(TAG, "selftest: create cut after %ld bytes left an invalid store", budget);
+    }
+    if (complete) {
+      total = written;
+      break;
+    }
+  }
+  ESP_LOGI(TAG, "selftest: create: %ld cut points checked", total);
+
+  remove(path);
+  remove(tmp);
+  ESP_LOGI(TAG, "selftest: %u power cuts replayed, %u failures", (unsigned)cuts, (unsigned)failures);
+  return failures == 0;
+}
+
+#else
+
+bool PPInjectorUI_mould_store_selftest(const char *path) {
+  (void)path;
+  return true;
+}
+
+#endif
+// ------------------ END   Power-cut self-test ------------------
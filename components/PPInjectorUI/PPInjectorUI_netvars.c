@@ -1,3 +1,4 @@
+#include <assert.h>
 #include <string.h>
 #include <PPInjectorUI.h>
 #include "PPInjectorUI_netvars.h"
@@ -10,6 +11,13 @@ const NetVars_desc_t PPInjectorUI_netvars_desc[] = {
 
 const size_t PPInjectorUI_netvars_count = sizeof(PPInjectorUI_netvars_desc) / sizeof(PPInjectorUI_netvars_desc[0]);
 
+#include "PPInjectorUI_netvars_index_fragment.c_"
+
+const size_t PPInjectorUI_netvars_key_index_count = sizeof(PPInjectorUI_netvars_key_index) / sizeof(PPInjectorUI_netvars_key_index[0]);
+
+_Static_assert(sizeof(PPInjectorUI_netvars_desc) / sizeof(PPInjectorUI_netvars_desc[0]) == PPINJECTORUI_NETVARS_POS_COUNT,
+               "PPInjectorUI_netvars_index_fragment.c_ is out of date; rerun poris/gen_netvars.py PPInjectorUI");
+
 void PPInjectorUI_netvars_append_json(cJSON *root)
 {
     if (PPInjectorUI_netvars_count > 0)
@@ -18,11 +26,21 @@ void PPInjectorUI_netvars_append_json(cJSON *root)
     }
 }
 
+void PPInjectorUI_netvars_write_json(NetVars_json_writer_t *w)
+{
+    if (PPInjectorUI_netvars_count > 0)
+    {
+        NetVars_write_json_component("PPInjectorUI", PPInjectorUI_netvars_desc, PPInjectorUI_netvars_count, w);
+    }
+}
+
 bool PPInjectorUI_netvars_parse_json_dict(cJSON *root)
 {
     if (PPInjectorUI_netvars_count > 0)
     {
-        return NetVars_parse_json_dict(PPInjectorUI_netvars_desc, PPInjectorUI_netvars_count, root);
+        return NetVars_parse_json_dict_indexed(PPInjectorUI_netvars_desc, PPInjectorUI_netvars_count,
+                                               PPInjectorUI_netvars_key_index, PPInjectorUI_netvars_key_index_count, root,
+                                               &PPInjectorUI_nvs_mgr);
     }
     else
     {
@@ -32,6 +50,10 @@ bool PPInjectorUI_netvars_parse_json_dict(cJSON *root)
 
 void PPInjectorUI_netvars_nvs_load(void)
 {
+    // Runs once at component init: a stale index fragment would make lookups
+    // miss keys silently, so debug builds stop here instead.
+    assert(NetVars_key_index_check("PPInjectorUI", PPInjectorUI_netvars_desc, PPInjectorUI_netvars_count,
+                                   PPInjectorUI_netvars_key_index, PPInjectorUI_netvars_key_index_count));
     if (PPInjectorUI_netvars_count > 0)
     {
         NetVars_nvs_load_component("PPInjectorUI", PPInjectorUI_netvars_desc, PPInjectorUI_netvars_count);
@@ -46,14 +68,26 @@ void PPInjectorUI_netvars_nvs_save(void)
     }
 }
 
-void PPInjectorUI_config_parse_json(const char *data)
+void PPInjectorUI_config_parse_json_root(cJSON *root)
 {
     if (PPInjectorUI_netvars_count > 0)
     {
-        bool nvs_cfg_changed = NetVars_parse_json_component_data("PPInjectorUI", PPInjectorUI_netvars_desc, PPInjectorUI_netvars_count, data);
-        if (nvs_cfg_changed)
+        // Changed NVS-backed descriptors are marked dirty one by one.
+        (void)NetVars_parse_json_component_indexed("PPInjectorUI", PPInjectorUI_netvars_desc, PPInjectorUI_netvars_count,
+                                                   PPInjectorUI_netvars_key_index, PPInjectorUI_netvars_key_index_count, root,
+                                                   &PPInjectorUI_nvs_mgr);
+    }
+}
+
+void PPInjectorUI_config_parse_json(const char *data)
+{
+    if (PPInjectorUI_netvars_count > 0 && data)
+    {
+        cJSON *root = cJSON_Parse(data);
+        if (root)
         {
-            PPInjectorUI_nvs_set_dirty();
+            PPInjectorUI_config_parse_json_root(root);
+            cJSON_Delete(root);
         }
     }
 }
@@ -65,8 +99,13 @@ void PPInjectorUI_nvs_set_dirty(void)
 
 void PPInjectorUI_nvs_spin(void)
 {
-    if (NetVars_nvs_spin(&PPInjectorUI_nvs_mgr))
+    if (PPInjectorUI_netvars_count > 0)
     {
-        PPInjectorUI_netvars_nvs_save();
+        (void)NetVars_nvs_spin_component("PPInjectorUI", PPInjectorUI_netvars_desc, PPInjectorUI_netvars_count, &PPInjectorUI_nvs_mgr);
     }
 }
+
+const netvars_nvs_stats_t *PPInjectorUI_nvs_stats(void)
+{
+    return &PPInjectorUI_nvs_mgr.stats;
+}
@@ -0,0 +1,128 @@
+#include "PPInjectorUI_prd_theme.h"
+
+#include <esp_log.h>
+
+namespace PrdTheme {
+namespace {
+const char *TAG = "PPInjectorUI_THEME";
+
+// Heating gradient, one colour per stage (blue -> yellow -> red).
+const uint32_t REFILL_STAGE_COLORS[REFILL_STAGES] = {
+    0x0000FF, 0x2424DB, 0x4949B6, 0x6D6D92, 0x91916D, 0xB6B649,
+    0xDADA24, 0xFFFF00, 0xFFDF00, 0xFFBF00, 0xFFA000, 0xFF8000,
+    0xFF6000, 0xFF4000, 0xFF2000, 0xFF0000};
+
+Styles s_styles;
+bool s_inited = false;
+size_t s_heapBytes = 0;
+
+size_t lvglHeapUsed() {
+  lv_mem_monitor_t mon;
+  lv_mem_monitor(&mon);
+  return mon.total_size - mon.free_size;
+}
+} // namespace
+
+void init() {
+  if (s_inited) {
+    return;
+  }
+  const size_t usedBefore = lvglHeapUsed();
+  Styles &s = s_styles;
+
+  lv_style_init(&s.button);
+  lv_style_set_radius(&s.button, 8);
+  lv_style_set_bg_color(&s.button, lv_color_hex(0x1f5ea8));
+  lv_style_set_bg_opa(&s.button, LV_OPA_COVER);
+  lv_style_set_border_width(&s.button, 0);
+  lv_style_set_text_color(&s.button, lv_color_hex(0xffffff));
+  lv_style_set_text_align(&s.button, LV_TEXT_ALIGN_CENTER);
+
+  lv_style_init(&s.panel);
+  lv_style_set_bg_color(&s.panel, lv_color_hex(0x11151a));
+  lv_style_set_bg_opa(&s.panel, LV_OPA_COVER);
+  lv_style_set_border_width(&s.panel, 0);
+  lv_style_set_pad_all(&s.panel, 0);
+  lv_style_set_radius(&s.panel, 0);
+
+  lv_style_init(&s.errorFrame);
+  lv_style_set_border_width(&s.errorFrame, 4);
+  lv_style_set_border_color(&s.errorFrame, lv_color_hex(0xc62828));
+
+  lv_style_init(&s.mouldCurrent);
+  lv_style_set_border_width(&s.mouldCurrent, 1);
+  lv_style_set_bg_color(&s.mouldCurrent, lv_color_hex(0x1a3a2a));
+  lv_style_set_border_color(&s.mouldCurrent, lv_color_hex(0x2e6b44));
+  lv_style_set_text_color(&s.mouldCurrent, lv_color_hex(0x7fe8a0));
+
+  lv_style_init(&s.mouldPlaceholder);
+  lv_style_set_border_width(&s.mouldPlaceholder, 1);
+  lv_style_set_bg_color(&s.mouldPlaceholder, lv_color_hex(0x26303a));
+  lv_style_set_border_color(&s.mouldPlaceholder, lv_color_hex(0x41505f));
+  lv_style_set_text_color(&s.mouldPlaceholder, lv_color_hex(0xffffff));
+
+  lv_style_init(&s.eodIdle);
+  lv_style_set_bg_color(&s.eodIdle, lv_color_hex(0x2196F3));
+  lv_style_set_border_width(&s.eodIdle, 0);
+
+  lv_style_init(&s.eodActive);
+  lv_style_set_bg_color(&s.eodActive, lv_color_hex(0x000000));
+  lv_style_set_border_width(&s.eodActive, 2);
+  lv_style_set_border_color(&s.eodActive, lv_color_hex(0x0000FF));
+
+  lv_style_init(&s.refillBand);
+  lv_style_set_radius(&s.refillBand, 0);
+  lv_style_set_bg_opa(&s.refillBand, LV_OPA_COVER);
+  lv_style_set_border_side(&s.refillBand, LV_BORDER_SIDE_TOP);
+  lv_style_set_border_width(&s.refillBand, 1);
+  lv_style_set_border_color(&s.refillBand, lv_color_hex(0x000000));
+
+  lv_style_init(&s.refillBandLabel);
+  lv_style_set_text_font(&s.refillBandLabel, &lv_font_montserrat_14);
+  lv_style_set_text_color(&s.refillBandLabel, lv_color_hex(0xffffff));
+  lv_style_set_text_align(&s.refillBandLabel, LV_TEXT_ALIGN_CENTER);
+
+  for (int i = 0; i < REFILL_STAGES; i++) {
+    lv_style_init(&s.refillStage[i]);
+    lv_style_set_bg_color(&s.refillStage[i],
+                          lv_color_hex(REFILL_STAGE_COLORS[i]));
+  }
+
+  s_heapBytes = lvglHeapUsed() - usedBefore;
+  s_inited = true;
+  ESP_LOGI(TAG, "%u shared styles, %u B of LVGL heap",
+           (unsigned)(sizeof(Styles) / sizeof(lv_style_t)),
+           (unsigned)s_heapBytes);
+}
+
+const Styles &styles() { return s_styles; }
+
+size_t heapBytes() { return s_heapBytes; }
+
+void swap(lv_obj_t *obj, const lv_style_t *from, const lv_style_t *to) {
+  if (!obj || from == to) {
+    return;
+  }
+  if (from && to && lv_obj_replace_style(obj, from, to, LV_PART_MAIN)) {
+    return;
+  }
+  if (from) {
+    lv_obj_remove_style(obj, from, LV_PART_MAIN);
+  }
+  if (to) {
+    lv_obj_remove_style(obj, to, LV_PART_MAIN); // never attach it twice
+    lv_obj_add_style(obj, to, LV_PART_MAIN);
+  }
+}
+
+void adoptRefillBand(lv_obj_t *band) {
+  if (!band) {
+    return;
+  }
+  lv_obj_remove_local_style_prop(band, LV_STYLE_BG_COLOR, LV_PART_MAIN);
+  lv_obj_remove_local_style_prop(band, LV_STYLE_BORDER_WIDTH, LV_PART_MAIN);
+  lv_obj_remove_local_style_prop(band, LV_STYLE_RADIUS, LV_PART_MAIN);
+  lv_obj_add_style(band, &s_styles.refillBand, LV_PART_MAIN);
+}
+
+} // namespace PrdTheme
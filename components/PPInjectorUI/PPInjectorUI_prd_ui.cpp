@@ -1,17 +1,23 @@
 #include "PPInjectorUI_prd_ui.h"
 #include "PPInjectorUI.h"
 #include "PPInjectorUI_display_comms.h"
+#include "PPInjectorUI_mould_index.h"
+#include "PPInjectorUI_mould_store.h"
+#include "PPInjectorUI_prd_theme.h"
+#include "PPInjectorUI_storage.h"
+#include "TouchScreen.h"
 #include "ui/eez-flow.h"
 #include "ui/fonts.h"
 #include "ui/screens.h"
 
-#include <cerrno>
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <ctime>
+#include <esp_heap_caps.h>
 #include <esp_log.h>
-#include <esp_spiffs.h>
+#include <esp_system.h>
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -49,71 +55,269 @@ namespace Storage {
 static bool s_inited = false;
 static constexpr const char *kSpiffsBasePath = "/spiffs";
 static constexpr const char *kSpiffsPartition = "spiffs_storage";
-static constexpr const char *kMouldsPath = "/spiffs/moulds.bin";
+static constexpr const char *kMouldsPath = "/spiffs/moulds.db";
+static constexpr const char *kLegacyMouldsPath = "/spiffs/moulds.bin";
+static constexpr const char *kMouldIndexPath = "/spiffs/moulds.idx";
+// Boot timing, reported with the first interactive frame.
+static int64_t s_mountUs = 0;
+static int64_t s_libraryOpenUs = 0;
 
 void init() {
   if (s_inited)
     return;
 
-  const esp_vfs_spiffs_conf_t conf = {
-      .base_path = kSpiffsBasePath,
-      .partition_label = kSpiffsPartition,
-      .max_files = 8,
-      .format_if_mount_failed = true,
-  };
-
-  esp_err_t err = esp_vfs_spiffs_register(&conf);
+  // Both backends mount on the same partition and path, so every file path
+  // below stays "/spiffs/..." whichever one Kconfig picks. Ask for the
+  // backend after mounting: an unconvertible SPIFFS partition stays SPIFFS.
+  const int64_t t0 = esp_timer_get_time();
+  esp_err_t err =
+      PPInjectorUI_storage_mount(kSpiffsBasePath, kSpiffsPartition);
+  s_mountUs = esp_timer_get_time() - t0;
+  const PPInjectorUI_storage_backend_t *backend =
+      PPInjectorUI_storage_backend();
   if (err != ESP_OK) {
-    ESP_LOGE(TAG, "SPIFFS mount failed: %s", esp_err_to_name(err));
+    ESP_LOGE(TAG, "%s mount failed: %s", backend->name, esp_err_to_name(err));
     return;
   }
 
   size_t total = 0, used = 0;
-  err = esp_spiffs_info(kSpiffsPartition, &total, &used);
+  err = backend->info(kSpiffsPartition, &total, &used);
   if (err == ESP_OK) {
-    ESP_LOGI(TAG, "SPIFFS mounted (%u/%u bytes used)", (unsigned)used,
-             (unsigned)total);
+    ESP_LOGI(TAG, "%s mounted in %u ms (%u/%u bytes used)", backend->name,
+             (unsigned)(s_mountUs / 1000), (unsigned)used, (unsigned)total);
   } else {
-    ESP_LOGW(TAG, "SPIFFS info failed: %s", esp_err_to_name(err));
+    ESP_LOGW(TAG, "%s info failed: %s", backend->name, esp_err_to_name(err));
   }
 
   s_inited = true;
 }
 
-void loadMoulds(DisplayComms::MouldParams *moulds, int &count, int maxCount) {
-  count = 0;
-  if (!s_inited || !moulds || maxCount <= 0)
-    return;
+// Mould profiles live in a PPInjectorUI_mould_store file: one CRC-checked
+// record per slot, updated in place with an A/B copy so a power cut can only
+// lose the edit in flight. Slot i is library row i (slot 0 mirrors the
+// controller); deletes compact the file so there are no holes. Pre-store
+// firmware dumped raw MouldParams structs to kLegacyMouldsPath; that file is
+// migrated once and then removed.
+static PPInjectorUI_mould_store_t s_moulds;
+// Name search index, entry i for row i. Every store change below keeps it
+// in step; a crash in between leaves it marked dirty and it is rebuilt on
+// the next open. Its header also carries the store's next record id, so a
+// clean index lets the next boot open the store without scanning it.
+static PPInjectorUI_mould_index_t s_index;
+
+static bool finishIndexUpdate() {
+  s_index.tag = s_moulds.next_id;
+  return PPInjectorUI_mould_index_end_update(&s_index);
+}
 
-  FILE *f = fopen(kMouldsPath, "rb");
-  if (!f) {
-    ESP_LOGI(TAG, "Storage: %s not found, starting empty", kMouldsPath);
+// What the mould list needs per row, without the process parameters.
+struct MouldIndexEntry {
+  uint32_t row;
+  uint32_t id;
+  uint32_t modified;
+  char name[sizeof(DisplayComms::MouldParams::name)];
+};
+
+static void migrateLegacyMoulds() {
+  FILE *f = fopen(kLegacyMouldsPath, "rb");
+  if (!f)
     return;
-  }
 
   uint32_t storedCount = 0;
-  if (fread(&storedCount, sizeof(storedCount), 1, f) != 1) {
-    ESP_LOGW(TAG, "Storage: invalid header in %s", kMouldsPath);
-    fclose(f);
+  std::vector<PPInjectorUI_mould_record_t> recs;
+  if (fread(&storedCount, sizeof(storedCount), 1, f) == 1) {
+    DisplayComms::MouldParams p;
+    while (recs.size() < storedCount && fread(&p, sizeof(p), 1, f) == 1) {
+      p.name[sizeof(p.name) - 1] = '\0';
+      p.mode[sizeof(p.mode) - 1] = '\0';
+      PPInjectorUI_mould_record_t rec = {};
+      rec.id = (uint32_t)recs.size() + 1;
+      rec.modified = (uint32_t)time(nullptr);
+      DisplayComms::packMouldRecord(p, rec.data);
+      recs.push_back(rec);
+    }
+  }
+  fclose(f);
+
+  if (!PPInjectorUI_mould_store_rewrite(&s_moulds, recs.data(),
+                                        (uint32_t)recs.size())) {
+    ESP_LOGE(TAG, "Storage: migrating %s failed, keeping it",
+             kLegacyMouldsPath);
     return;
   }
+  remove(kLegacyMouldsPath);
+  ESP_LOGI(TAG, "Storage: migrated %u mould profiles from %s",
+           (unsigned)recs.size(), kLegacyMouldsPath);
+}
 
-  if (storedCount > (uint32_t)maxCount) {
-    ESP_LOGW(TAG, "Storage: truncating mould count %u -> %d",
-             (unsigned)storedCount, maxCount);
-    storedCount = (uint32_t)maxCount;
+int readMouldIndex(int first, int count, MouldIndexEntry *out);
+
+// Re-indexes every stored name; used when the index is missing or stale.
+static bool rebuildMouldIndex() {
+  const int64_t t0 = esp_timer_get_time();
+  PPInjectorUI_mould_index_close(&s_index);
+  remove(kMouldIndexPath);
+  PPInjectorUI_mould_index_open(&s_index, kMouldIndexPath, 0);
+  constexpr int kChunk = 4;
+  MouldIndexEntry entries[kChunk];
+  const int total = (int)s_moulds.slots;
+  for (int row = 0; row < total; row += kChunk) {
+    const int n = readMouldIndex(row, kChunk, entries);
+    if (n <= 0)
+      return false;
+    for (int i = 0; i < n; ++i) {
+      if (!PPInjectorUI_mould_index_set(&s_index, (uint32_t)(row + i),
+                                        entries[i].name))
+        return false;
+    }
   }
+  if (!finishIndexUpdate())
+    return false;
+  ESP_LOGI(TAG, "Storage: indexed %d mould names in %u ms", total,
+           (unsigned)((esp_timer_get_time() - t0) / 1000));
+  return true;
+}
 
-  size_t readCount =
-      fread(moulds, sizeof(DisplayComms::MouldParams), (size_t)storedCount, f);
-  fclose(f);
+static bool openMouldStore() {
+  if (s_moulds.open)
+    return true;
+  if (!s_inited)
+    return false;
+  const int64_t t0 = esp_timer_get_time();
+  uint32_t summaryRows = 0;
+  uint32_t summaryNextId = 0;
+  const bool haveSummary = PPInjectorUI_mould_index_peek(
+      kMouldIndexPath, &summaryRows, &summaryNextId);
+  if (!(haveSummary ? PPInjectorUI_mould_store_open_summary(
+                          &s_moulds, kMouldsPath, summaryRows, summaryNextId)
+                    : PPInjectorUI_mould_store_open(&s_moulds, kMouldsPath))) {
+    ESP_LOGE(TAG, "Storage: cannot open mould store %s", kMouldsPath);
+    return false;
+  }
+  if (PPInjectorUI_mould_store_slots(&s_moulds) == 0)
+    migrateLegacyMoulds();
+  // Rows are addressed by slot, so squeeze out slots left empty by older
+  // firmware that erased instead of removing.
+  if (s_moulds.live != s_moulds.slots) {
+    ESP_LOGI(TAG, "Storage: compacting %u empty mould slots",
+             (unsigned)(s_moulds.slots - s_moulds.live));
+    PPInjectorUI_mould_store_remove(&s_moulds, UINT32_MAX);
+  }
+  if (s_moulds.stats.bad_copies)
+    ESP_LOGW(TAG, "Storage: %u torn mould record copies ignored",
+             (unsigned)s_moulds.stats.bad_copies);
+  if (!PPInjectorUI_mould_index_open(&s_index, kMouldIndexPath,
+                                     s_moulds.slots) &&
+      !rebuildMouldIndex())
+    ESP_LOGE(TAG, "Storage: mould name index unavailable");
+  s_libraryOpenUs = esp_timer_get_time() - t0;
+  ESP_LOGI(TAG, "Storage: mould library has %u profiles (opened in %u ms, %s)",
+           (unsigned)s_moulds.slots, (unsigned)(s_libraryOpenUs / 1000),
+           s_moulds.stats.scans ? "full scan" : "from index summary");
+  return true;
+}
 
-  count = (int)readCount;
-  for (int i = 0; i < count; ++i) {
-    moulds[i].name[sizeof(moulds[i].name) - 1] = '\0';
-    moulds[i].mode[sizeof(moulds[i].mode) - 1] = '\0';
+int mouldCount() {
+  return openMouldStore() ? (int)PPInjectorUI_mould_store_slots(&s_moulds)
+                          : 0;
+}
+
+// Fills up to `count` index entries from row `first`. Reads a few records
+// at a time so the stack cost does not depend on `count`.
+int readMouldIndex(int first, int count, MouldIndexEntry *out) {
+  if (first < 0 || count <= 0 || !out || !openMouldStore())
+    return -1;
+
+  constexpr int kChunk = 4;
+  PPInjectorUI_mould_record_t recs[kChunk];
+  DisplayComms::MouldParams p;
+  int done = 0;
+  while (done < count) {
+    int want = count - done < kChunk ? count - done : kChunk;
+    int n = PPInjectorUI_mould_store_get_range(
+        &s_moulds, (uint32_t)(first + done), (uint32_t)want, recs);
+    if (n < 0)
+      return -1;
+    for (int i = 0; i < n; ++i) {
+      DisplayComms::unpackMouldRecord(recs[i].data, p);
+      MouldIndexEntry &e = out[done + i];
+      e.row = (uint32_t)(first + done + i);
+      e.id = recs[i].id;
+      e.modified = recs[i].modified;
+      memcpy(e.name, p.name, sizeof(e.name));
+    }
+    done += n;
+    if (n < want)
+      break;
+  }
+  return done;
+}
+
+bool readMould(int index, DisplayComms::MouldParams &out) {
+  PPInjectorUI_mould_record_t rec;
+  if (index < 0 || !openMouldStore() ||
+      PPInjectorUI_mould_store_get(&s_moulds, (uint32_t)index, &rec) != 1)
+    return false;
+  DisplayComms::unpackMouldRecord(rec.data, out);
+  return true;
+}
+
+// `index` == mouldCount() appends. Only a changed record touches flash.
+bool writeMould(int index, const DisplayComms::MouldParams &p) {
+  if (index < 0 || !openMouldStore())
+    return false;
+  PPInjectorUI_mould_record_t rec = {};
+  rec.modified = (uint32_t)time(nullptr);
+  DisplayComms::packMouldRecord(p, rec.data);
+  // Most writes (slot 0 refreshes, parameter edits) keep the name, so the
+  // index is only touched on a rename or append.
+  const bool reindex =
+      !PPInjectorUI_mould_index_same(&s_index, (uint32_t)index, p.name);
+  if (reindex)
+    PPInjectorUI_mould_index_begin_update(&s_index);
+  int r = PPInjectorUI_mould_store_put(&s_moulds, (uint32_t)index, &rec);
+  if (r < 0) {
+    ESP_LOGE(TAG, "Storage: failed writing mould %d", index);
+    return false;
   }
-  ESP_LOGI(TAG, "Storage: loaded %d mould profiles", count);
+  if (reindex &&
+      (!PPInjectorUI_mould_index_set(&s_index, (uint32_t)index, p.name) ||
+       !finishIndexUpdate()))
+    ESP_LOGW(TAG, "Storage: name index not updated for mould %d", index);
+  if (r > 0)
+    ESP_LOGD(TAG, "Storage: saved mould %d (id %u)", index,
+             (unsigned)rec.id);
+  return true;
+}
+
+bool removeMould(int index) {
+  if (index < 0 || !openMouldStore())
+    return false;
+  PPInjectorUI_mould_index_begin_update(&s_index);
+  if (!PPInjectorUI_mould_store_remove(&s_moulds, (uint32_t)index)) {
+    ESP_LOGE(TAG, "Storage: failed removing mould %d", index);
+    return false;
+  }
+  if (!PPInjectorUI_mould_index_remove(&s_index, (uint32_t)index) ||
+      !finishIndexUpdate())
+    ESP_LOGW(TAG, "Storage: name index not updated for removed mould %d",
+             index);
+  ESP_LOGI(TAG, "Storage: removed mould %d, %u left", index,
+           (unsigned)s_moulds.slots);
+  return true;
+}
+
+// Whole-library load/replace, kept for the storage self-test and dump.
+void loadMoulds(DisplayComms::MouldParams *moulds, int &count, int maxCount) {
+  count = 0;
+  if (!moulds || maxCount <= 0)
+    return;
+  int total = mouldCount();
+  for (int i = 0; i < total && count < maxCount; ++i) {
+    if (readMould(i, moulds[count]))
+      count++;
+  }
+  ESP_LOGI(TAG, "Storage: loaded %d of %d mould profiles", count, total);
   for (int i = 0; i < count; ++i) {
     const DisplayComms::MouldParams &p = moulds[i];
     ESP_LOGI(TAG,
@@ -125,35 +329,96 @@ void loadMoulds(DisplayComms::MouldParams *moulds, int &count, int maxCount) {
 }
 
 void saveMoulds(const DisplayComms::MouldParams *moulds, int count) {
-  if (!s_inited || !moulds || count < 0)
+  if (!moulds || count < 0 || !openMouldStore())
     return;
+  std::vector<PPInjectorUI_mould_record_t> recs((size_t)count);
+  for (int i = 0; i < count; ++i) {
+    recs[i].id = (uint32_t)i + 1;
+    recs[i].modified = (uint32_t)time(nullptr);
+    DisplayComms::packMouldRecord(moulds[i], recs[i].data);
+  }
+  if (PPInjectorUI_mould_store_rewrite(&s_moulds, recs.data(),
+                                       (uint32_t)count))
+    ESP_LOGI(TAG, "Storage: replaced library with %d mould profiles", count);
+  rebuildMouldIndex();
+}
 
-  FILE *f = fopen(kMouldsPath, "wb");
-  if (!f) {
-    ESP_LOGE(TAG, "Storage: cannot open %s for write (errno=%d: %s)",
-             kMouldsPath, errno, strerror(errno));
-    return;
-  }
+// Name search over the library. Row 0 mirrors the controller and may not be
+// stored yet, so the scan starts at row 1 and callers test row 0 themselves.
+void beginMouldSearch(PPInjectorUI_mould_search_t &search, const char *query) {
+  PPInjectorUI_mould_search_begin(&search, query);
+  search.next = 1;
+}
 
-  uint32_t storedCount = (uint32_t)count;
-  if (fwrite(&storedCount, sizeof(storedCount), 1, f) != 1) {
-    ESP_LOGE(TAG, "Storage: failed writing header");
-    fclose(f);
-    return;
-  }
+bool mouldSearchDone(const PPInjectorUI_mould_search_t &search) {
+  return !s_index.open || search.next >= s_index.count;
+}
 
-  size_t written =
-      fwrite(moulds, sizeof(DisplayComms::MouldParams), (size_t)count, f);
-  fclose(f);
+// Scans up to `maxRows` index entries and returns the rows whose stored name
+// really matches (at most `cap`), or -1 if the index cannot be read.
+int stepMouldSearch(PPInjectorUI_mould_search_t &search, uint32_t maxRows,
+                    MouldIndexEntry *out, int cap) {
+  if (!openMouldStore() || s_index.dirty)
+    return -1;
+  uint32_t rows[8];
+  const int want = cap < 8 ? cap : 8;
+  const int n =
+      PPInjectorUI_mould_search_step(&s_index, &search, maxRows, rows, want);
+  if (n < 0)
+    return -1;
+  int found = 0;
+  for (int i = 0; i < n; ++i) {
+    if (readMouldIndex((int)rows[i], 1, &out[found]) == 1 &&
+        PPInjectorUI_mould_name_matches(out[found].name, &search))
+      found++;
+  }
+  return found;
+}
 
-  if (written != (size_t)count) {
-    ESP_LOGE(TAG, "Storage: short write (%u/%u)", (unsigned)written,
-             (unsigned)count);
-    return;
+#if CONFIG_PPINJECTORUI_MOULD_LIST_BENCH
+// Points the library at a scratch store with `rows` synthetic profiles for
+// the list benchmark; endScratchMoulds() puts the real one back.
+static PPInjectorUI_mould_store_t s_savedMoulds;
+static PPInjectorUI_mould_index_t s_savedIndex;
+static constexpr const char *kScratchMouldsPath = "/spiffs/moulds_bench.db";
+static constexpr const char *kScratchIndexPath = "/spiffs/moulds_bench.idx";
+
+void endScratchMoulds();
+
+bool beginScratchMoulds(int rows) {
+  if (!openMouldStore())
+    return false;
+  s_savedMoulds = s_moulds;
+  s_savedIndex = s_index;
+  s_index = PPInjectorUI_mould_index_t{}; // the real mirror stays with s_savedIndex
+  remove(kScratchIndexPath);
+  PPInjectorUI_mould_index_open(&s_index, kScratchIndexPath, 0);
+  if (!PPInjectorUI_mould_store_open(&s_moulds, kScratchMouldsPath) ||
+      !PPInjectorUI_mould_store_rewrite(&s_moulds, nullptr, 0)) {
+    endScratchMoulds();
+    return false;
   }
+  DisplayComms::MouldParams p = {};
+  strncpy(p.mode, "2D", sizeof(p.mode) - 1);
+  for (int i = 0; i < rows; ++i) {
+    snprintf(p.name, sizeof(p.name), "Bench %04d", i);
+    p.fillVolume = (float)i;
+    if (!writeMould(i, p)) {
+      endScratchMoulds();
+      return false;
+    }
+  }
+  return true;
+}
 
-  ESP_LOGI(TAG, "Storage: saved %d mould profiles", count);
+void endScratchMoulds() {
+  s_moulds = s_savedMoulds;
+  PPInjectorUI_mould_index_close(&s_index);
+  s_index = s_savedIndex;
+  remove(kScratchMouldsPath);
+  remove(kScratchIndexPath);
 }
+#endif
 
 struct LocalSettings {
   float heatTimeMin;
@@ -223,11 +488,29 @@ constexpr lv_coord_t RIGHT_X = 130;
 constexpr lv_coord_t RIGHT_WIDTH = 350;
 constexpr lv_coord_t SCREEN_WIDTH = 480;
 constexpr lv_coord_t SCREEN_HEIGHT = 800;
-constexpr int MAX_MOULD_PROFILES = 16;
+// The mould list is virtual: the library stays on flash, MOULD_ROW_POOL
+// buttons are re-bound to whichever rows are in view and row names are paged
+// in MOULD_PAGE_ROWS at a time, so RAM use does not follow the library size.
+constexpr lv_coord_t MOULD_LIST_HEIGHT = 480;
+constexpr lv_coord_t MOULD_ROW_TOP = 8;
+constexpr lv_coord_t MOULD_ROW_PITCH = 54;
+constexpr int MOULD_ROW_POOL = MOULD_LIST_HEIGHT / MOULD_ROW_PITCH + 2;
+constexpr int MOULD_PAGE_ROWS = 16;
+constexpr int MOULD_PAGE_CACHE = 2;
+// Typing in the search box scans the name index from tick() in slices of
+// MOULD_SEARCH_STEP_ROWS entries until MOULD_SEARCH_BUDGET_US is used up, so
+// a long library is filtered over several frames instead of stalling one.
+constexpr int MOULD_SEARCH_MAX_HITS = 100;
+constexpr uint32_t MOULD_SEARCH_STEP_ROWS = 128;
+constexpr int MOULD_SEARCH_STEP_HITS = 4;
+constexpr int64_t MOULD_SEARCH_BUDGET_US = 4000;
 constexpr uint32_t DOUBLE_TAP_MS = 420;
 constexpr uint32_t NETWORK_HOLD_GRAY_MS = 3000;
 constexpr uint32_t NETWORK_HOLD_OTA_MS = 6000;
 constexpr uint32_t NETWORK_HOLD_REPROVISION_MS = 10000;
+// Three quick taps on the network gesture zone toggle the frame profiler HUD.
+constexpr int FRAME_HUD_TAPS = 3;
+constexpr uint32_t FRAME_HUD_REFRESH_MS = 500;
 
 // Shared geometry constants.
 constexpr float TURNS_TO_TOP = 22.53f;
@@ -246,11 +529,6 @@ constexpr float PLUNGER_PX_PER_TURN =
 constexpr float REFILL_PX_PER_TURN = PLUNGER_PX_PER_TURN;
 constexpr int REFILL_STACK_BOTTOM_Y = 770;
 
-const uint32_t REFILL_BLOCK_COLORS[] = {0x0000FF, 0x2424DB, 0x4949B6, 0x6D6D92,
-                                        0x91916D, 0xB6B649, 0xDADA24, 0xFFFF00,
-                                        0xFFDF00, 0xFFBF00, 0xFFA000, 0xFF8000,
-                                        0xFF6000, 0xFF4000, 0xFF2000, 0xFF0000};
-
 const char *COMMON_FIELD_NAMES[] = {
     "Trap Accel",          "Compress Torque",  "Micro Interval (ms)",
     "Micro Duration (ms)", "Purge Up",         "Purge Down",
@@ -291,6 +569,54 @@ struct RefillBlock {
       : volume(v), addedMs(a), active(act) {}
 };
 
+// What a pooled mould list button currently shows, kept so the list can be
+// patched in place instead of being rebuilt.
+struct MouldSlotView {
+  int row;   // library row bound to this button, -1 if none
+  int shown; // list position the button sits at, -1 if none
+  char text[sizeof(DisplayComms::MouldParams::name) + 12];
+  bool visible;
+  bool styled;
+  bool selected;
+  bool current; // styled as the slot-0 controller mould
+};
+
+// What a refill band currently shows, kept so a render only pushes the
+// properties that changed. Volume and age are kept as displayed: tenths of
+// a cm3 and whole minutes.
+struct RefillBandView {
+  bool shown = false; // the generated bands are hidden at init
+  int16_t y = INT16_MIN;
+  int16_t h = -1;
+  uint8_t stage = PrdTheme::NO_STAGE;
+  int32_t volume10 = -1;
+  uint32_t minutes = UINT32_MAX;
+};
+
+// A run of MOULD_PAGE_ROWS consecutive index entries read from flash.
+struct MouldIndexPage {
+  int first = -1;
+  int count = 0;
+  uint32_t lastUse = 0;
+  Storage::MouldIndexEntry entries[MOULD_PAGE_ROWS] = {};
+};
+
+// Screens carrying live widgets (readouts, plunger, refill bands).
+enum LiveScreen : uint8_t {
+  LIVE_MAIN,
+  LIVE_MOULD,
+  LIVE_COMMON,
+  LIVE_SCREEN_COUNT, // also "none of them is active"
+};
+
+// What a screen's live widgets still need, per LiveScreen.
+enum LiveDirty : uint8_t {
+  LIVE_READOUTS = 1u << 0,
+  LIVE_PLUNGER = 1u << 1,
+  LIVE_BANDS = 1u << 2,
+  LIVE_ALL = LIVE_READOUTS | LIVE_PLUNGER | LIVE_BANDS,
+};
+
 struct UiState {
   bool initialized = false;
 
@@ -314,21 +640,41 @@ struct UiState {
   lv_obj_t *globalEodFrame = nullptr;
   lv_obj_t *mainMouldDisplay =
       nullptr; // Display currently loaded mould on main
+  bool mainMouldLoaded = false; // mouldCurrent (not mouldPlaceholder) attached
 
   lv_obj_t *mouldList = nullptr;
   lv_obj_t *mouldNotice = nullptr;
+  lv_obj_t *mouldSearchBox = nullptr;
+  lv_obj_t *mouldSearchKeyboard = nullptr;
 
   lv_obj_t *mouldButtonBack = nullptr;
   lv_obj_t *mouldButtonSend = nullptr;
   lv_obj_t *mouldButtonEdit = nullptr;
   lv_obj_t *mouldButtonNew = nullptr;
   lv_obj_t *mouldButtonDelete = nullptr;
-  lv_obj_t *mouldProfileButtons[MAX_MOULD_PROFILES] = {};
-  DisplayComms::MouldParams mouldProfiles[MAX_MOULD_PROFILES] = {};
-  int mouldProfileCount = 0;
+  lv_obj_t *mouldListSpacer = nullptr; // sizes the scroll range
+  lv_obj_t *mouldRowButtons[MOULD_ROW_POOL] = {};
+  MouldSlotView mouldSlotViews[MOULD_ROW_POOL] = {};
+  MouldIndexPage mouldPages[MOULD_PAGE_CACHE];
+  uint32_t mouldPageClock = 0;
+  DisplayComms::MouldParams currentMould = {};  // row 0, controller mirror
+  DisplayComms::MouldParams selectedProfile = {}; // row selectedMould
+  int mouldProfileCount = 0;                      // library rows (>= 1)
+  int mouldRowsShown = 0;                         // rows the list scrolls over
   int selectedMould = -1;
   int lastTappedMould = -1;
   uint32_t lastTapMs = 0;
+  PrdUi::MouldListStats mouldListStats = {};
+  int64_t initStartUs = 0; // boot timing, see onFirstFrameRendered()
+  int64_t initDoneUs = 0;
+  // While the search box holds text the list shows mouldHits instead of the
+  // library; mouldSearchPending while the index scan is still running.
+  bool mouldSearchActive = false;
+  bool mouldSearchPending = false;
+  int64_t mouldSearchStartUs = 0;
+  PPInjectorUI_mould_search_t mouldSearch = {};
+  Storage::MouldIndexEntry mouldHits[MOULD_SEARCH_MAX_HITS] = {};
+  int mouldHitCount = 0;
 
   lv_obj_t *commonScroll = nullptr;
   lv_obj_t *commonNotice = nullptr;
@@ -338,6 +684,7 @@ struct UiState {
   lv_obj_t *commonInputs[COMMON_FIELD_COUNT] = {};
   lv_obj_t *commonDiscardOverlay = nullptr;
   bool commonDirty = false;
+  bool commonModelStale = false;
   bool suppressCommonEvents = false;
 
   int refillStage = 0; // 0=None, 1=Refill, 2=Compression
@@ -367,14 +714,30 @@ struct UiState {
   bool networkGestureActive = false;
   lv_point_t networkGestureStartPoint = {0, 0};
   uint32_t networkGestureStartMs = 0;
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+  lv_obj_t *frameHud = nullptr; // hidden until toggled, see noteFrameHudTap()
+  int frameHudTaps = 0;
+  uint32_t frameHudTapMs = 0;
+  uint32_t frameHudUpdateMs = 0;
+#endif
 
   RefillBlock refillBlocks[16];
   int blockCount = 0;
-  char lastState[24] = "";
+  DisplayComms::MachineState lastState = DisplayComms::MachineState::Unknown;
   float startRefillPos = 0;
   float lastFramePos = 0;
   bool isRefilling = false;
   bool refillSequenceActive = false;
+  uint32_t nextBandChangeMs = 0; // next heat stage or minute label change
+  int lastRenderedBlockCount = 0;
+
+  uint32_t commsCursor = 0; // DisplayComms::takeChanges() position
+
+  RefillBandView bandViews[4][16];           // per plunger instance
+  int plungerY = 0;                          // last mapped plunger offset
+  uint8_t liveStale[LIVE_SCREEN_COUNT] = {}; // LiveDirty bits per screen
+  uint32_t propWrites = 0;                   // running LVGL write count
+  PrdUi::LiveUpdateStats liveStats = {};
 };
 
 UiState ui;
@@ -388,8 +751,10 @@ void onMouldNew(lv_event_t *e);
 void onMouldDelete(lv_event_t *e);
 void onMouldSend(lv_event_t *e);
 void syncMouldSendEditEnablement();
-void rebuildMouldList();
+void syncMouldList();
+void applyMouldSlotSelection();
 void syncMainMouldDisplay();
+void updateMouldListFromComms(const DisplayComms::MouldParams &mould);
 
 void disablePlungerAreaScroll() {
   lv_obj_t *locked[] = {
@@ -471,6 +836,7 @@ void setLabelTextIfChanged(lv_obj_t *label, const char *text) {
   const char *current = lv_label_get_text(label);
   if (!current || strcmp(current, text) != 0) {
     lv_label_set_text(label, text);
+    ui.propWrites++;
   }
 }
 
@@ -597,14 +963,7 @@ lv_obj_t *createButton(lv_obj_t *parent, const char *text, lv_coord_t x,
                 (void *)button);
   lv_obj_set_pos(button, x, y);
   lv_obj_set_size(button, w, h);
-  lv_obj_set_style_radius(button, 8, LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_set_style_bg_color(button, lv_color_hex(0x1f5ea8),
-                            LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_set_style_bg_opa(button, LV_OPA_COVER,
-                          LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_set_style_border_width(button, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_set_style_text_color(button, lv_color_hex(0xffffff),
-                              LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_obj_add_style(button, &PrdTheme::styles().button, LV_PART_MAIN);
   if (cb) {
     Serial.println("PRD_UI: createButton before lv_obj_add_event_cb");
     lv_obj_add_event_cb(button, cb, LV_EVENT_CLICKED, userData);
@@ -616,8 +975,6 @@ lv_obj_t *createButton(lv_obj_t *parent, const char *text, lv_coord_t x,
   Serial.printf("PRD_UI: createButton after lv_label_create label=%p\n",
                 (void *)label);
   lv_label_set_text(label, text);
-  lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER,
-                              LV_PART_MAIN | LV_STATE_DEFAULT);
   lv_obj_center(label);
   Serial.println("PRD_UI: createButton end");
   return button;
@@ -678,6 +1035,9 @@ void hideLegacyWidgets() {
 
   for (lv_obj_t *band : legacy_refill_bands) {
     hideIfPresent(band);
+    if (isObjReady(band)) {
+      PrdTheme::adoptRefillBand(band);
+    }
   }
 
   // Redundant numeric labels on top of plungers (large 2-line legacy text).
@@ -687,6 +1047,84 @@ void hideLegacyWidgets() {
   hideIfPresent(objects.obj5__obj0);
 }
 
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+void updateFrameHud(uint32_t now) {
+  if (!isObjReady(ui.frameHud) ||
+      lv_obj_has_flag(ui.frameHud, LV_OBJ_FLAG_HIDDEN) ||
+      (now - ui.frameHudUpdateMs) < FRAME_HUD_REFRESH_MS) {
+    return;
+  }
+  ui.frameHudUpdateMs = now;
+
+  TouchScreen_frame_stats_t stats;
+  if (!TouchScreen_frame_stats(&stats)) {
+    lv_label_set_text(ui.frameHud, "frames: none yet");
+    return;
+  }
+  const uint32_t fpsX10 =
+      stats.window_ms ? (stats.frames - 1) * 10000U / stats.window_ms : 0;
+  char text[384];
+  int len = snprintf(text, sizeof(text),
+                     "%u frames, %u.%u fps\n p50 / p95 / max",
+                     (unsigned)stats.frames, (unsigned)(fpsX10 / 10),
+                     (unsigned)(fpsX10 % 10));
+  for (int m = 0; m < TouchScreen_frame_metric_count && len > 0 &&
+                  len < static_cast<int>(sizeof(text));
+       ++m) {
+    const TouchScreen_frame_percentiles_t &p = stats.metric[m];
+    len += snprintf(text + len, sizeof(text) - len, "\n%s: %u / %u / %u",
+                    TouchScreen_frame_metric_name(
+                        static_cast<TouchScreen_frame_metric_t>(m)),
+                    (unsigned)p.p50, (unsigned)p.p95, (unsigned)p.max);
+  }
+  const PrdUi::LiveUpdateStats &live = ui.liveStats;
+  if (len > 0 && len < static_cast<int>(sizeof(text))) {
+    snprintf(text + len, sizeof(text) - len, "\nwrites/tick: %u / %u max",
+             (unsigned)live.lastTickWrites, (unsigned)live.maxTickWrites);
+  }
+  lv_label_set_text(ui.frameHud, text);
+}
+
+void noteFrameHudTap(uint32_t now) {
+  if (!isObjReady(ui.frameHud)) {
+    return;
+  }
+  if (ui.frameHudTaps > 0 && (now - ui.frameHudTapMs) > DOUBLE_TAP_MS) {
+    ui.frameHudTaps = 0;
+  }
+  ui.frameHudTapMs = now;
+  if (++ui.frameHudTaps < FRAME_HUD_TAPS) {
+    return;
+  }
+  ui.frameHudTaps = 0;
+  if (lv_obj_has_flag(ui.frameHud, LV_OBJ_FLAG_HIDDEN)) {
+    lv_obj_clear_flag(ui.frameHud, LV_OBJ_FLAG_HIDDEN);
+    ui.frameHudUpdateMs = now - FRAME_HUD_REFRESH_MS;
+    updateFrameHud(now);
+  } else {
+    lv_obj_add_flag(ui.frameHud, LV_OBJ_FLAG_HIDDEN);
+  }
+}
+
+void createFrameHud(lv_obj_t *top) {
+  ui.frameHud = lv_label_create(top);
+  lv_obj_set_width(ui.frameHud, 300);
+  lv_obj_align(ui.frameHud, LV_ALIGN_TOP_RIGHT, -150, 4);
+  lv_obj_clear_flag(ui.frameHud, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_set_style_text_font(ui.frameHud, &lv_font_montserrat_14,
+                             LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_obj_set_style_text_color(ui.frameHud, lv_color_hex(0xffffff),
+                              LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_obj_set_style_bg_color(ui.frameHud, lv_color_hex(0x000000),
+                            LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_obj_set_style_bg_opa(ui.frameHud, LV_OPA_80,
+                          LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_obj_set_style_pad_all(ui.frameHud, 6, LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_label_set_text(ui.frameHud, "");
+  lv_obj_add_flag(ui.frameHud, LV_OBJ_FLAG_HIDDEN);
+}
+#endif
+
 void hideNetworkGestureIndicator() {
   if (!isObjReady(ui.networkGestureIndicator)) {
     return;
@@ -785,6 +1223,11 @@ void onNetworkGestureEvent(lv_event_t *event) {
         ESP_LOGW(TAG, "Gesture action: OTA requested");
         PPInjectorUI_request_system_action(PPInjectorUI_system_action_ota);
       }
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+      if (code == LV_EVENT_RELEASED && heldMs < DOUBLE_TAP_MS) {
+        noteFrameHudTap(millis());
+      }
+#endif
     }
     resetNetworkGesture();
     return;
@@ -816,6 +1259,9 @@ void createNetworkGestureUi() {
   lv_obj_set_style_bg_color(ui.networkGestureIndicator, lv_color_hex(0x909090),
                             LV_PART_MAIN | LV_STATE_DEFAULT);
   lv_obj_add_flag(ui.networkGestureIndicator, LV_OBJ_FLAG_HIDDEN);
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+  createFrameHud(top);
+#endif
 }
 
 lv_obj_t *createRightPanel(lv_obj_t *screen) {
@@ -826,12 +1272,7 @@ lv_obj_t *createRightPanel(lv_obj_t *screen) {
   lv_obj_t *panel = lv_obj_create(screen);
   lv_obj_set_pos(panel, RIGHT_X, 0);
   lv_obj_set_size(panel, RIGHT_WIDTH, SCREEN_HEIGHT);
-  lv_obj_set_style_bg_color(panel, lv_color_hex(0x11151a),
-                            LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_set_style_bg_opa(panel, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_set_style_border_width(panel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_set_style_pad_all(panel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_set_style_radius(panel, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_obj_add_style(panel, &PrdTheme::styles().panel, LV_PART_MAIN);
   lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
   return panel;
 }
@@ -855,14 +1296,13 @@ void updateErrorFrames(const DisplayComms::Status &status) {
   lv_obj_t *panels[] = {ui.rightPanelMain, ui.rightPanelMould,
                         ui.rightPanelCommon, ui.rightPanelMouldEdit};
 
+  const lv_style_t *frame = &PrdTheme::styles().errorFrame;
   for (lv_obj_t *panel : panels) {
     if (!panel) {
       continue;
     }
-    lv_obj_set_style_border_width(panel, hasError ? 4 : 0,
-                                  LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(panel, lv_color_hex(0xffc62828),
-                                  LV_PART_MAIN | LV_STATE_DEFAULT);
+    PrdTheme::swap(panel, hasError ? nullptr : frame,
+                   hasError ? frame : nullptr);
   }
 
   if (ui.mainErrorLabel) {
@@ -888,24 +1328,7 @@ void updateErrorFrames(const DisplayComms::Status &status) {
   }
 }
 
-void updateLeftReadouts(const DisplayComms::Status &status) {
-  char posText[40];
-  char tempText[40];
-
-  snprintf(posText, sizeof(posText), "%.2f cm3",
-           turnsToCm3(status.encoderTurns));
-  snprintf(tempText, sizeof(tempText), "%.1f C", status.tempC);
-
-  setLabelTextIfChanged(ui.posLabelMain, posText);
-  setLabelTextIfChanged(ui.posLabelMould, posText);
-  setLabelTextIfChanged(ui.posLabelCommon, posText);
-
-  setLabelTextIfChanged(ui.tempLabelMain, tempText);
-  setLabelTextIfChanged(ui.tempLabelMould, tempText);
-  setLabelTextIfChanged(ui.tempLabelCommon, tempText);
-}
-
-void updatePlungerPosition(float turns) {
+int plungerYOffset(float turns) {
   // Calibrated linear mapping from encoder turns to on-screen plunger Y.
   // This calibration is intentionally kept as the previously tuned plunger
   // behavior.
@@ -930,40 +1353,30 @@ void updatePlungerPosition(float turns) {
   if (yOffset > MAX_Y_OFFSET) {
     yOffset = MAX_Y_OFFSET;
   }
-
-  if (isObjReady(objects.plunger_tip__plunger)) {
-    lv_obj_set_y(objects.plunger_tip__plunger, yOffset);
-  }
-  if (isObjReady(objects.obj0__plunger)) {
-    lv_obj_set_y(objects.obj0__plunger, yOffset);
-  }
-  if (isObjReady(objects.obj2__plunger)) {
-    lv_obj_set_y(objects.obj2__plunger, yOffset);
-  }
-  if (isObjReady(objects.obj5__plunger)) {
-    lv_obj_set_y(objects.obj5__plunger, yOffset);
-  }
+  return yOffset;
 }
 
 void updateRefillBlocks(const DisplayComms::Status &status) {
+  using DisplayComms::MachineState;
   float currentTurns = status.encoderTurns;
-  const char *state = status.state;
+  const MachineState state = status.stateId;
+  const uint16_t stateFlags = DisplayComms::machineStateInfo(state).flags;
 
   // 3-Stage Registration: REFILL -> COMPRESSION -> READY_TO_INJECT
-  if (strcmp(state, "REFILL") == 0) {
+  if (state == MachineState::Refill) {
     ui.blockStackLift = 0; // Reset suction lift
     if (ui.refillStage != 1) {
       ui.refillStage = 1;
       Serial.println("PRD_UI: Refill Stage 1 (Refill)");
     }
     ui.isRefilling = true;
-  } else if (strcmp(state, "COMPRESSION") == 0) {
+  } else if (state == MachineState::Compression) {
     if (ui.refillStage == 1) {
       ui.refillStage = 2;
       Serial.println("PRD_UI: Refill Stage 2 (Compression)");
     }
     ui.isRefilling = false;
-  } else if (strcmp(state, "READY_TO_INJECT") == 0) {
+  } else if (state == MachineState::ReadyToInject) {
     if (ui.refillStage == 2) {
       // Stage 3: Entered READY_TO_INJECT from COMPRESSION
       // Initial addition: calculate space below plunger minus existing volume
@@ -1013,7 +1426,7 @@ void updateRefillBlocks(const DisplayComms::Status &status) {
         ui.refillBlocks[ui.blockCount - 1].volume = adjustedVol;
         ui.currentBlockVol = adjustedVol;
       }
-    } else if (strcmp(ui.lastState, "READY_TO_INJECT") != 0 &&
+    } else if (ui.lastState != MachineState::ReadyToInject &&
                ui.refillStage != 0 && ui.refillStage != 3) {
       // Interrupted sequence (if not in adjustment phase)
       ui.refillStage = 0;
@@ -1025,7 +1438,7 @@ void updateRefillBlocks(const DisplayComms::Status &status) {
       ui.refillStage = 0; // Lock volume
       Serial.println("PRD_UI: Refill block volume locked");
     }
-    if (strcmp(state, "HOME") == 0 || strcmp(state, "INIT_HEATING") == 0) {
+    if (stateFlags & DisplayComms::STATE_RESETS_REFILL) {
       ui.refillStage = 0;
       ui.blockStackLift = 0;
     }
@@ -1038,8 +1451,7 @@ void updateRefillBlocks(const DisplayComms::Status &status) {
     // Upward Movement (Suction)
     // Apply suction in states where the plunger lifts plastic (release,
     // antidrip)
-    if (strcmp(state, "READY_TO_INJECT") == 0 ||
-        strcmp(state, "ANTIDRIP") == 0 || strcmp(state, "RELEASE") == 0) {
+    if (stateFlags & DisplayComms::STATE_SUCTION) {
       ui.blockStackLift += (-deltaTurns);
     }
   } else if (deltaTurns > 0.0001f) {
@@ -1054,9 +1466,7 @@ void updateRefillBlocks(const DisplayComms::Status &status) {
 
     // If still moving down, consume from blocks (if in injection/purge states)
     if (deltaTurns > 0.0001f) {
-      if (strcmp(state, "INJECT") == 0 ||
-          strcmp(state, "HOLD_INJECTION") == 0 ||
-          strcmp(state, "PURGE_ZERO") == 0) {
+      if (stateFlags & DisplayComms::STATE_CONSUMES_VOLUME) {
 
         float consumedCm3 = deltaTurns;
         if (consumedCm3 < 100.0f) {
@@ -1079,11 +1489,41 @@ void updateRefillBlocks(const DisplayComms::Status &status) {
   }
 
   ui.lastFramePos = currentTurns;
-  strncpy(ui.lastState, state, sizeof(ui.lastState) - 1);
+  ui.lastState = state;
+}
+
+// Heat stage (16 stages from Blue -> Yellow -> Red) of a block `ageMs` old.
+int refillHeatStage(uint32_t ageMs) {
+  const float heatTotalMs = ui.heatTimeMin * 60.0f * 1000.0f;
+  int stage = (heatTotalMs > 0) ? (int)(ageMs * 16 / heatTotalMs) : 15;
+  return stage > 15 ? 15 : stage;
+}
+
+// When a shown band next changes by itself (heat stage or minute label), so
+// tick() re-renders the bands then rather than polling them.
+uint32_t nextRefillBandChangeMs(uint32_t now) {
+  const float heatTotalMs = ui.heatTimeMin * 60.0f * 1000.0f;
+  uint32_t wait = 60000;
+  for (int i = 0; i < ui.blockCount; i++) {
+    const uint32_t ageMs = now - ui.refillBlocks[i].addedMs;
+    uint32_t blockWait = 60000 - ageMs % 60000;
+    const int stage = refillHeatStage(ageMs);
+    if (stage < 15 && heatTotalMs > 0) {
+      const uint32_t stageAgeMs =
+          static_cast<uint32_t>((stage + 1) * heatTotalMs / 16) + 1;
+      const uint32_t stageWait = stageAgeMs > ageMs ? stageAgeMs - ageMs : 1;
+      blockWait = stageWait < blockWait ? stageWait : blockWait;
+    }
+    wait = blockWait < wait ? blockWait : wait;
+  }
+  return now + wait;
 }
 
-void renderRefillBlocksForBands(lv_obj_t **bands) {
-  if (!bands) {
+// Pushes the band model to one plunger's 16 bands. `views` remembers what
+// each band shows, so only changed geometry, stage style and label text
+// reach LVGL; an unchanged band costs nothing.
+void renderRefillBlocksForBands(lv_obj_t **bands, RefillBandView *views) {
+  if (!bands || !views) {
     return;
   }
 
@@ -1094,61 +1534,185 @@ void renderRefillBlocksForBands(lv_obj_t **bands) {
 
   for (int i = 0; i < 16; i++) {
     lv_obj_t *band = bands[i];
+    RefillBandView &view = views[i];
     if (!isObjReady(band)) {
       continue;
     }
 
-    if (i < ui.blockCount) {
-      int h = static_cast<int>(ui.refillBlocks[i].volume * pxPerTurn);
-      if (h < 1) {
-        h = 1;
+    if (i >= ui.blockCount) {
+      if (view.shown) {
+        lv_obj_add_flag(band, LV_OBJ_FLAG_HIDDEN);
+        view.shown = false;
+        ui.propWrites++;
       }
-      y -= h;
+      continue;
+    }
+
+    int h = static_cast<int>(ui.refillBlocks[i].volume * pxPerTurn);
+    if (h < 1) {
+      h = 1;
+    }
+    y -= h;
+    if (view.h != h) {
       lv_obj_set_size(band, 80, h);
+      view.h = static_cast<int16_t>(h);
+      ui.propWrites++;
+    }
+    if (view.y != y) {
       lv_obj_set_pos(band, -8, y);
+      view.y = static_cast<int16_t>(y);
+      ui.propWrites++;
+    }
+    if (!view.shown) {
       lv_obj_clear_flag(band, LV_OBJ_FLAG_HIDDEN);
+      view.shown = true;
+      ui.propWrites++;
+    }
 
-      // Fine black line at the top
-      lv_obj_set_style_border_side(band, LV_BORDER_SIDE_TOP, 0);
-      lv_obj_set_style_border_width(band, 1, 0);
-      lv_obj_set_style_border_color(band, lv_color_hex(0x000000), 0);
-
-      // Heating Gradient (16 stages from Blue -> Yellow -> Red)
-      uint32_t ageMs = now - ui.refillBlocks[i].addedMs;
-      float heatTotalMs = ui.heatTimeMin * 60.0f * 1000.0f;
-      int stage = (heatTotalMs > 0) ? (int)(ageMs * 16 / heatTotalMs) : 15;
-      if (stage > 15)
-        stage = 15;
-
-      lv_obj_set_style_bg_color(band, lv_color_hex(REFILL_BLOCK_COLORS[stage]),
-                                0);
-      lv_obj_set_style_bg_opa(band, LV_OPA_COVER, 0);
-
-      // Block Overlay: Volume and Age (2 lines)
-      lv_obj_t *label = lv_obj_get_child(band, 0);
-      if (!label) {
-        label = lv_label_create(band);
-        lv_obj_center(label);
-        lv_obj_set_style_text_font(label, &lv_font_montserrat_14, 0);
-        lv_obj_set_style_text_color(label, lv_color_hex(0xffffff), 0);
-        lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
-      }
-      char buf[32];
-      snprintf(buf, sizeof(buf), "%.1f\n%lum", ui.refillBlocks[i].volume,
-               (unsigned long)(ageMs / 60000));
-      lv_label_set_text(label, buf);
+    const uint32_t ageMs = now - ui.refillBlocks[i].addedMs;
+    const int stage = refillHeatStage(ageMs);
+    if (view.stage != stage) {
+      const PrdTheme::Styles &theme = PrdTheme::styles();
+      PrdTheme::swap(band,
+                     view.stage == PrdTheme::NO_STAGE
+                         ? nullptr
+                         : &theme.refillStage[view.stage],
+                     &theme.refillStage[stage]);
+      view.stage = static_cast<uint8_t>(stage);
+      ui.propWrites++;
+    }
+
+    // Block Overlay: Volume and Age (2 lines)
+    const int32_t volume10 =
+        static_cast<int32_t>(ui.refillBlocks[i].volume * 10.0f + 0.5f);
+    const uint32_t minutes = ageMs / 60000;
+    if (view.volume10 == volume10 && view.minutes == minutes) {
+      continue;
+    }
+    lv_obj_t *label = lv_obj_get_child(band, 0);
+    if (!label) {
+      label = lv_label_create(band);
+      lv_obj_center(label);
+      lv_obj_add_style(label, &PrdTheme::styles().refillBandLabel,
+                       LV_PART_MAIN);
+    }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%ld.%ld\n%lum", (long)(volume10 / 10),
+             (long)(volume10 % 10), (unsigned long)minutes);
+    lv_label_set_text(label, buf);
+    view.volume10 = volume10;
+    view.minutes = minutes;
+    ui.propWrites++;
+  }
+}
+
+// Live widgets of one screen; the main screen carries two plungers.
+struct LiveWidgets {
+  lv_obj_t *posLabel;
+  lv_obj_t *tempLabel;
+  lv_obj_t *plungers[2];
+  lv_obj_t **bands[2]; // 16 consecutive refill_band_N members
+  RefillBandView *bandViews[2];
+};
+
+LiveWidgets liveWidgets(LiveScreen screen) {
+  switch (screen) {
+  case LIVE_MAIN:
+    return {ui.posLabelMain,
+            ui.tempLabelMain,
+            {objects.plunger_tip__plunger, objects.obj0__plunger},
+            {&objects.plunger_tip__refill_band_0,
+             &objects.obj0__refill_band_0},
+            {ui.bandViews[0], ui.bandViews[1]}};
+  case LIVE_MOULD:
+    return {ui.posLabelMould,
+            ui.tempLabelMould,
+            {objects.obj2__plunger, nullptr},
+            {&objects.obj2__refill_band_0, nullptr},
+            {ui.bandViews[2], nullptr}};
+  case LIVE_COMMON:
+    return {ui.posLabelCommon,
+            ui.tempLabelCommon,
+            {objects.obj5__plunger, nullptr},
+            {&objects.obj5__refill_band_0, nullptr},
+            {ui.bandViews[3], nullptr}};
+  default:
+    return {};
+  }
+}
+
+LiveScreen activeLiveScreen() {
+  lv_obj_t *active = lv_screen_active();
+  if (active && active == objects.main) {
+    return LIVE_MAIN;
+  }
+  if (active && active == objects.mould_settings) {
+    return LIVE_MOULD;
+  }
+  if (active && active == objects.common_settings) {
+    return LIVE_COMMON;
+  }
+  return LIVE_SCREEN_COUNT;
+}
+
+void applyLiveWidgets(LiveScreen screen, uint8_t dirty) {
+  const LiveWidgets w = liveWidgets(screen);
+  if (dirty & LIVE_READOUTS) {
+    const DisplayComms::Status &status = DisplayComms::getStatus();
+    char posText[40];
+    char tempText[40];
+    snprintf(posText, sizeof(posText), "%.2f cm3",
+             turnsToCm3(status.encoderTurns));
+    snprintf(tempText, sizeof(tempText), "%.1f C", status.tempC);
+    setLabelTextIfChanged(w.posLabel, posText);
+    setLabelTextIfChanged(w.tempLabel, tempText);
+  }
+  for (int i = 0; i < 2; i++) {
+    if ((dirty & LIVE_PLUNGER) && isObjReady(w.plungers[i])) {
+      lv_obj_set_y(w.plungers[i], ui.plungerY);
+      ui.propWrites++;
+    }
+    if (dirty & LIVE_BANDS) {
+      renderRefillBlocksForBands(w.bands[i], w.bandViews[i]);
+    }
+  }
+}
+
+// Writes `dirty` to the active screen's live widgets only. The hidden
+// screens just remember it and are caught up by catchUpLiveScreen().
+void refreshLiveWidgets(uint8_t dirty) {
+  if (!dirty) {
+    return;
+  }
+  const LiveScreen active = activeLiveScreen();
+  for (int i = 0; i < LIVE_SCREEN_COUNT; i++) {
+    const LiveScreen screen = static_cast<LiveScreen>(i);
+    if (screen == active) {
+      applyLiveWidgets(screen, dirty | ui.liveStale[i]);
+      ui.liveStale[i] = 0;
     } else {
-      lv_obj_add_flag(band, LV_OBJ_FLAG_HIDDEN);
+      ui.liveStale[i] |= dirty;
+      ui.liveStats.deferred++;
     }
   }
 }
 
-void renderAllPlungers() {
-  lv_obj_t **allObjects = (lv_obj_t **)&objects;
-  renderRefillBlocksForBands(&allObjects[6]);
-  renderRefillBlocksForBands(&allObjects[29]);
-  renderRefillBlocksForBands(&allObjects[58]);
-  renderRefillBlocksForBands(&allObjects[104]);
+// Brings the active screen up to date if it went stale while hidden. Run
+// once a navigation lands and at the top of tick(), which also covers
+// screens loaded by EEZ flow actions.
+void catchUpLiveScreen() {
+  const LiveScreen active = activeLiveScreen();
+  if (active == LIVE_SCREEN_COUNT || !ui.liveStale[active]) {
+    return;
+  }
+  applyLiveWidgets(active, ui.liveStale[active]);
+  ui.liveStale[active] = 0;
+  ui.liveStats.catchUps++;
+}
+
+void updatePlungerPosition(float turns) {
+  ui.plungerY = plungerYOffset(turns);
+  refreshLiveWidgets(LIVE_PLUNGER);
 }
 
 void onNavigate(lv_event_t *event) {
@@ -1160,6 +1724,7 @@ void onNavigate(lv_event_t *event) {
     const intptr_t asyncTarget = reinterpret_cast<intptr_t>(userData);
     eez_flow_set_screen(static_cast<int16_t>(asyncTarget),
                         LV_SCR_LOAD_ANIM_NONE, 0, 0);
+    catchUpLiveScreen();
     Serial.printf("PRD_UI: onNavigate async applied target=%d now screen=%d\n",
                   static_cast<int>(asyncTarget),
                   static_cast<int>(g_currentScreen));
@@ -1192,30 +1757,71 @@ void onNavigate(lv_event_t *event) {
 void onStateActionQueryState(lv_event_t *) { DisplayComms::sendQueryState(); }
 void onStateActionQueryError(lv_event_t *) { DisplayComms::sendQueryError(); }
 
+void sendGotoState(DisplayComms::MachineState state) {
+  DisplayComms::sendCmdGoto(DisplayComms::machineStateInfo(state).name);
+}
+
 void onStateActionGotoReady(lv_event_t *) {
-  DisplayComms::sendCmdGoto("READY_TO_INJECT");
+  sendGotoState(DisplayComms::MachineState::ReadyToInject);
 }
 void onStateActionGotoRefill(lv_event_t *) {
-  DisplayComms::sendCmdGoto("REFILL");
+  sendGotoState(DisplayComms::MachineState::Refill);
 }
 void onStateActionGotoPurge(lv_event_t *) {
-  DisplayComms::sendCmdGoto("PURGE_ZERO");
+  sendGotoState(DisplayComms::MachineState::PurgeZero);
+}
+void onStateActionGotoHome(lv_event_t *) {
+  sendGotoState(DisplayComms::MachineState::Home);
 }
-void onStateActionGotoHome(lv_event_t *) { DisplayComms::sendCmdGoto("HOME"); }
 void onStateActionGotoCompression(lv_event_t *) {
-  DisplayComms::sendCmdGoto("COMPRESSION");
+  sendGotoState(DisplayComms::MachineState::Compression);
 }
 
+// Label and handler of the primary state button, indexed by StateAction.
+struct StateActionButton {
+  const char *label;
+  lv_event_cb_t onClick;
+};
+const StateActionButton STATE_ACTION_BUTTONS[] = {
+    {nullptr, nullptr}, // None
+    {"Compress", onStateActionGotoCompression},
+    {"Abort to Refill", onStateActionGotoRefill},
+    {"Purge Zero", onStateActionGotoPurge},
+    {"Stop Purge", onStateActionGotoReady},
+    {"HOME", onStateActionGotoHome},
+};
+
 void onStateActionToggleEndOfDay(lv_event_t *) {
   DisplayComms::sendCmdToggle("EOD");
 }
 
+// Loads the full parameters of library row `row` into ui.selectedProfile.
+bool loadSelectedProfile(int row) {
+  if (row < 0 || row >= ui.mouldProfileCount) {
+    return false;
+  }
+  if (row == 0) {
+    ui.selectedProfile = ui.currentMould;
+    return true;
+  }
+  return Storage::readMould(row, ui.selectedProfile);
+}
+
 void onMouldProfileSelect(lv_event_t *event) {
-  int index = static_cast<int>(
+  int slot = static_cast<int>(
       reinterpret_cast<intptr_t>(lv_event_get_user_data(event)));
+  if (slot < 0 || slot >= MOULD_ROW_POOL) {
+    return;
+  }
+  int index = ui.mouldSlotViews[slot].row;
   if (index < 0 || index >= ui.mouldProfileCount) {
     return;
   }
+  if (!loadSelectedProfile(index)) {
+    setNotice(ui.mouldNotice, "Cannot read profile from storage.",
+              lv_color_hex(0xffff7a));
+    return;
+  }
 
   uint32_t now = millis();
   bool isDoubleTap =
@@ -1224,21 +1830,6 @@ void onMouldProfileSelect(lv_event_t *event) {
   ui.lastTapMs = now;
   ui.selectedMould = index;
 
-  for (int i = 0; i < ui.mouldProfileCount; i++) {
-    if (!ui.mouldProfileButtons[i]) {
-      continue;
-    }
-    if (i == ui.selectedMould) {
-      lv_obj_set_style_bg_color(ui.mouldProfileButtons[i],
-                                lv_color_hex(0x2d7dd2),
-                                LV_PART_MAIN | LV_STATE_DEFAULT);
-    } else {
-      lv_obj_set_style_bg_color(ui.mouldProfileButtons[i],
-                                lv_color_hex(0x26303a),
-                                LV_PART_MAIN | LV_STATE_DEFAULT);
-    }
-  }
-
   if (isDoubleTap) {
     onMouldEdit(nullptr);
   }
@@ -1262,24 +1853,7 @@ void syncMouldSendEditEnablement() {
   setButtonEnabled(ui.mouldButtonSend, hasSelection && safeForUpdate);
   setButtonEnabled(ui.mouldButtonDelete, isDeletable);
 
-  // Re-apply selection highlight (can be lost after list rebuild)
-  for (int i = 0; i < ui.mouldProfileCount; i++) {
-    if (!ui.mouldProfileButtons[i])
-      continue;
-    if (i == ui.selectedMould) {
-      lv_obj_set_style_bg_color(ui.mouldProfileButtons[i],
-                                lv_color_hex(0x2d7dd2),
-                                LV_PART_MAIN | LV_STATE_DEFAULT);
-    } else if (i == 0) {
-      lv_obj_set_style_bg_color(ui.mouldProfileButtons[0],
-                                lv_color_hex(0x1a3a2a),
-                                LV_PART_MAIN | LV_STATE_DEFAULT);
-    } else {
-      lv_obj_set_style_bg_color(ui.mouldProfileButtons[i],
-                                lv_color_hex(0x26303a),
-                                LV_PART_MAIN | LV_STATE_DEFAULT);
-    }
-  }
+  applyMouldSlotSelection();
 }
 
 void syncMainMouldDisplay() {
@@ -1289,58 +1863,241 @@ void syncMainMouldDisplay() {
   lv_obj_t *lbl = lv_obj_get_child(ui.mainMouldDisplay, 0);
   if (!lbl)
     return;
+  const PrdTheme::Styles &theme = PrdTheme::styles();
 
-  if (ui.mouldProfileCount > 0 && ui.mouldProfiles[0].name[0] != '\0') {
-    char safeName[sizeof(ui.mouldProfiles[0].name) + 12];
-    char tmp[sizeof(ui.mouldProfiles[0].name)];
-    strncpy(tmp, ui.mouldProfiles[0].name, sizeof(tmp) - 1);
+  if (ui.mouldProfileCount > 0 && ui.currentMould.name[0] != '\0') {
+    char safeName[sizeof(ui.currentMould.name) + 12];
+    char tmp[sizeof(ui.currentMould.name)];
+    strncpy(tmp, ui.currentMould.name, sizeof(tmp) - 1);
     tmp[sizeof(tmp) - 1] = '\0';
     snprintf(safeName, sizeof(safeName), "(current) %s", tmp);
-    lv_label_set_text(lbl, safeName);
+    setLabelTextIfChanged(lbl, safeName);
     // Applied current style (green)
-    lv_obj_set_style_bg_color(ui.mainMouldDisplay, lv_color_hex(0x1a3a2a), 0);
-    lv_obj_set_style_border_color(ui.mainMouldDisplay, lv_color_hex(0x2e6b44),
-                                  0);
-    lv_obj_set_style_text_color(lbl, lv_color_hex(0x7fe8a0), 0);
+    if (!ui.mainMouldLoaded) {
+      PrdTheme::swap(ui.mainMouldDisplay, &theme.mouldPlaceholder,
+                     &theme.mouldCurrent);
+      ui.mainMouldLoaded = true;
+    }
   } else {
-    lv_label_set_text(lbl, "(current) ...");
-    lv_obj_set_style_bg_color(ui.mainMouldDisplay, lv_color_hex(0x26303a), 0);
-    lv_obj_set_style_border_color(ui.mainMouldDisplay, lv_color_hex(0x41505f),
-                                  0);
-    lv_obj_set_style_text_color(lbl, lv_color_hex(0xffffff), 0);
+    setLabelTextIfChanged(lbl, "(current) ...");
+    if (ui.mainMouldLoaded) {
+      PrdTheme::swap(ui.mainMouldDisplay, &theme.mouldCurrent,
+                     &theme.mouldPlaceholder);
+      ui.mainMouldLoaded = false;
+    }
   }
 }
 
-void rebuildMouldList() {
-  lv_mem_monitor_t mon_before;
-  lv_mem_monitor(&mon_before);
-  ESP_LOGD(
-      TAG,
-      "LVGL mem before rebuild: free=%u used_pct=%u frag_pct=%u largest=%u",
-      (unsigned)mon_before.free_size, (unsigned)mon_before.used_pct,
-      (unsigned)mon_before.frag_pct, (unsigned)mon_before.free_biggest_size);
+// Drops the cached index pages; call after the library changed on flash.
+void invalidateMouldPages() {
+  for (MouldIndexPage &page : ui.mouldPages) {
+    page.first = -1;
+    page.count = 0;
+  }
+}
+
+// Index entry for library row `row` (> 0), paging it in from flash on a
+// miss by evicting the least recently used page.
+const Storage::MouldIndexEntry *mouldIndexEntry(int row) {
+  const int first = row - row % MOULD_PAGE_ROWS;
+  MouldIndexPage *victim = &ui.mouldPages[0];
+  for (MouldIndexPage &page : ui.mouldPages) {
+    if (page.first == first) {
+      page.lastUse = ++ui.mouldPageClock;
+      return (row - first < page.count) ? &page.entries[row - first] : nullptr;
+    }
+    if (page.lastUse < victim->lastUse) {
+      victim = &page;
+    }
+  }
+
+  int n = Storage::readMouldIndex(first, MOULD_PAGE_ROWS, victim->entries);
+  ui.mouldListStats.pageLoads++;
+  if (n < 0) {
+    victim->first = -1;
+    victim->count = 0;
+    return nullptr;
+  }
+  victim->first = first;
+  victim->count = n;
+  victim->lastUse = ++ui.mouldPageClock;
+  return (row - first < n) ? &victim->entries[row - first] : nullptr;
+}
+
+// Library row shown at list position `shown`.
+int mouldLibraryRow(int shown) {
+  return ui.mouldSearchActive ? static_cast<int>(ui.mouldHits[shown].row)
+                              : shown;
+}
 
-  Serial.printf("PRD_UI: rebuildMouldList begin count=%d selected=%d\n",
-                ui.mouldProfileCount, ui.selectedMould);
-  if (!ui.mouldList) {
-    Serial.println("PRD_UI: rebuildMouldList aborted (mouldList null)");
+void formatMouldSlotText(int shown, char *out, size_t outSize) {
+  const int index = mouldLibraryRow(shown);
+  if (index == 0) {
+    // Slot 0 = current controller mould (read-only)
+    char tmp[sizeof(ui.currentMould.name)];
+    strncpy(tmp, ui.currentMould.name, sizeof(tmp) - 1);
+    tmp[sizeof(tmp) - 1] = '\0';
+    snprintf(out, outSize, "(current) %s", tmp[0] != '\0' ? tmp : "...");
     return;
   }
-  if (!isObjReady(ui.mouldList)) {
-    Serial.println("PRD_UI: rebuildMouldList aborted (mouldList invalid)");
+  // Search hits carry their name, so showing them never pages the index.
+  const Storage::MouldIndexEntry *entry =
+      ui.mouldSearchActive ? &ui.mouldHits[shown] : mouldIndexEntry(index);
+  out[0] = '\0';
+  if (entry) {
+    strncpy(out, entry->name, outSize - 1);
+    out[outSize - 1] = '\0';
+  }
+  if (out[0] == '\0')
+    strncpy(out, entry ? "Unnamed Mould" : "(unreadable)", outSize - 1);
+}
+
+lv_obj_t *createMouldSlotButton(int slot) {
+  lv_obj_t *button = createButton(
+      ui.mouldList, "", 8, MOULD_ROW_TOP, 286, 46, onMouldProfileSelect,
+      reinterpret_cast<void *>(static_cast<intptr_t>(slot)));
+  lv_obj_set_style_border_width(button, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_obj_clear_flag(button,
+                    LV_OBJ_FLAG_SCROLL_ON_FOCUS); // Prevent jump on tap
+  lv_obj_add_flag(button, LV_OBJ_FLAG_HIDDEN);
+
+  MouldSlotView &view = ui.mouldSlotViews[slot];
+  view = MouldSlotView{};
+  view.row = -1;
+  view.shown = -1;
+  ui.mouldRowButtons[slot] = button;
+  ui.mouldListStats.buttonsCreated++;
+  return button;
+}
+
+// Border and label tint only depend on whether the button shows row 0.
+void applyMouldSlotRowStyle(int slot, bool current) {
+  MouldSlotView &view = ui.mouldSlotViews[slot];
+  lv_obj_t *button = ui.mouldRowButtons[slot];
+  if (view.row >= 0 && view.current == current)
     return;
+  // Current mould: green tint, slightly different border
+  lv_obj_set_style_border_color(
+      button, lv_color_hex(current ? 0x2e6b44 : 0x41505f),
+      LV_PART_MAIN | LV_STATE_DEFAULT);
+  lv_obj_t *lbl = lv_obj_get_child(button, 0);
+  if (lbl)
+    lv_obj_set_style_text_color(
+        lbl, lv_color_hex(current ? 0x7fe8a0 : 0xffffff), 0);
+  view.current = current;
+  view.styled = false;
+  ui.mouldListStats.stylePatches++;
+}
+
+// Background only depends on selection and on the row being slot 0.
+void applyMouldSlotSelection() {
+  for (int k = 0; k < MOULD_ROW_POOL; k++) {
+    MouldSlotView &view = ui.mouldSlotViews[k];
+    if (!ui.mouldRowButtons[k] || !view.visible)
+      continue;
+    const bool selected = (view.row == ui.selectedMould);
+    if (view.styled && view.selected == selected)
+      continue;
+    uint32_t bg = selected ? 0x2d7dd2 : (view.row == 0 ? 0x1a3a2a : 0x26303a);
+    lv_obj_set_style_bg_color(ui.mouldRowButtons[k], lv_color_hex(bg),
+                              LV_PART_MAIN | LV_STATE_DEFAULT);
+    view.selected = selected;
+    view.styled = true;
+    ui.mouldListStats.stylePatches++;
+  }
+}
+
+// Points the pooled buttons at the rows in view. List position r always
+// lands on button r % MOULD_ROW_POOL, so scrolling by one row re-binds one
+// button. `refresh` also re-checks the labels of rows that did not move.
+void bindMouldRows(bool refresh) {
+  PrdUi::MouldListStats &stats = ui.mouldListStats;
+  const int count = ui.mouldRowsShown;
+  int first = (lv_obj_get_scroll_y(ui.mouldList) - MOULD_ROW_TOP) /
+              MOULD_ROW_PITCH;
+  if (first > count - MOULD_ROW_POOL)
+    first = count - MOULD_ROW_POOL;
+  if (first < 0)
+    first = 0;
+
+  for (int k = 0; k < MOULD_ROW_POOL; k++) {
+    MouldSlotView &view = ui.mouldSlotViews[k];
+    lv_obj_t *button = ui.mouldRowButtons[k];
+    const int shown =
+        first + (k - first % MOULD_ROW_POOL + MOULD_ROW_POOL) % MOULD_ROW_POOL;
+
+    if (shown >= count) {
+      if (view.visible) {
+        lv_obj_add_flag(button, LV_OBJ_FLAG_HIDDEN);
+        view.visible = false;
+        stats.visibilityPatches++;
+      }
+      view.row = -1;
+      view.shown = -1;
+      continue;
+    }
+
+    const int row = mouldLibraryRow(shown);
+    const bool moved = (view.row != row || view.shown != shown);
+    if (moved) {
+      applyMouldSlotRowStyle(k, row == 0);
+      if (view.shown != shown)
+        lv_obj_set_y(button, MOULD_ROW_TOP + MOULD_ROW_PITCH * shown);
+      view.row = row;
+      view.shown = shown;
+      view.styled = false;
+      stats.rowBinds++;
+    }
+    if (moved || refresh) {
+      char text[sizeof(view.text)];
+      formatMouldSlotText(shown, text, sizeof(text));
+      if (moved || strcmp(view.text, text) != 0) {
+        lv_obj_t *lbl = lv_obj_get_child(button, 0);
+        if (lbl)
+          lv_label_set_text(lbl, text);
+        strncpy(view.text, text, sizeof(view.text) - 1);
+        view.text[sizeof(view.text) - 1] = '\0';
+        stats.labelPatches++;
+      }
+    }
+    if (!view.visible) {
+      lv_obj_clear_flag(button, LV_OBJ_FLAG_HIDDEN);
+      view.visible = true;
+      stats.visibilityPatches++;
+    }
   }
+  applyMouldSlotSelection();
+}
 
-  lv_obj_clean(ui.mouldList);
-  Serial.println("PRD_UI: rebuildMouldList cleaned list");
+void onMouldListScroll(lv_event_t *) {
+  // Runs per scroll step; the pool is only created, never deleted, so a
+  // null check is enough (lv_obj_is_valid walks the whole tree).
+  if (!ui.mouldRowButtons[MOULD_ROW_POOL - 1])
+    return;
+  const int64_t t0 = esp_timer_get_time();
+  bindMouldRows(false);
+  const uint32_t us = static_cast<uint32_t>(esp_timer_get_time() - t0);
+  PrdUi::MouldListStats &stats = ui.mouldListStats;
+  stats.scrollEvents++;
+  stats.scrollBindUsTotal += us;
+  if (us > stats.scrollBindUsMax)
+    stats.scrollBindUsMax = us;
+}
 
-  for (int i = 0; i < MAX_MOULD_PROFILES; i++) {
-    ui.mouldProfileButtons[i] = nullptr;
+// Brings the virtual mould list in line with ui.mouldProfileCount (or the
+// search hits) and the index pages. The button pool is created once; after that a sync only moves
+// the spacer that sets the scroll range and patches the bound rows, so the
+// steady state does no LVGL allocations no matter how many profiles exist.
+void syncMouldList() {
+  if (!isObjReady(ui.mouldList)) {
+    Serial.println("PRD_UI: syncMouldList aborted (mouldList invalid)");
+    return;
   }
 
-  int renderCount = ui.mouldProfileCount;
+  int renderCount =
+      ui.mouldSearchActive ? ui.mouldHitCount : ui.mouldProfileCount;
 #if SCREEN_DIAG_SKIP_LAST_PROFILE_ON_RENDER
-  if (renderCount > 0) {
+  if (renderCount > 0 && !ui.mouldSearchActive) {
     Serial.printf("PRD_UI: SCREEN_DIAG_SKIP_LAST_PROFILE_ON_RENDER=1 -> "
                   "rendering %d/%d profiles\n",
                   renderCount - 1, renderCount);
@@ -1348,68 +2105,213 @@ void rebuildMouldList() {
   }
 #endif
 
-  int y = 8;
-  for (int i = 0; i < renderCount; i++) {
-    char safeName[sizeof(ui.mouldProfiles[i].name) + 12];
-    safeName[0] = '\0';
-    if (i == 0) {
-      // Slot 0 = current controller mould (read-only)
-      char tmp[sizeof(ui.mouldProfiles[0].name)];
-      strncpy(tmp, ui.mouldProfiles[0].name, sizeof(tmp) - 1);
-      tmp[sizeof(tmp) - 1] = '\0';
-      snprintf(safeName, sizeof(safeName), "(current) %s",
-               tmp[0] != '\0' ? tmp : "...");
-    } else {
-      strncpy(safeName, ui.mouldProfiles[i].name, sizeof(safeName) - 1);
-      safeName[sizeof(safeName) - 1] = '\0';
-      if (safeName[0] == '\0')
-        strncpy(safeName, "Unnamed Mould", sizeof(safeName) - 1);
-    }
-    lv_obj_t *button = createButton(
-        ui.mouldList, safeName, 8, y, 286, 46, onMouldProfileSelect,
-        reinterpret_cast<void *>(static_cast<intptr_t>(i)));
-    if (i == 0) {
-      // Current mould: green tint, slightly different border
-      lv_obj_set_style_bg_color(button, lv_color_hex(0x1a3a2a),
-                                LV_PART_MAIN | LV_STATE_DEFAULT);
-      lv_obj_set_style_border_color(button, lv_color_hex(0x2e6b44),
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
-      // Tint the label green
-      lv_obj_t *lbl = lv_obj_get_child(button, 0);
-      if (lbl)
-        lv_obj_set_style_text_color(lbl, lv_color_hex(0x7fe8a0), 0);
-    } else {
-      lv_obj_set_style_bg_color(button, lv_color_hex(0x26303a),
-                                LV_PART_MAIN | LV_STATE_DEFAULT);
-    }
-    lv_obj_set_style_border_width(button, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    if (i != 0) {
-      lv_obj_set_style_border_color(button, lv_color_hex(0x41505f),
-                                    LV_PART_MAIN | LV_STATE_DEFAULT);
-    }
-    lv_obj_clear_flag(button,
-                      LV_OBJ_FLAG_SCROLL_ON_FOCUS); // Prevent jump on tap
-    ui.mouldProfileButtons[i] = button;
-    y += 54;
-    if ((i & 1) == 1) {
-      uiYield();
+  PrdUi::MouldListStats &stats = ui.mouldListStats;
+  const PrdUi::MouldListStats before = stats;
+  stats.syncs++;
+
+  const bool needsCreate = !ui.mouldRowButtons[MOULD_ROW_POOL - 1];
+  lv_mem_monitor_t mon_before;
+  if (needsCreate) {
+    stats.rebuilds++;
+    lv_mem_monitor(&mon_before);
+    for (int k = 0; k < MOULD_ROW_POOL; k++) {
+      if (!ui.mouldRowButtons[k]) {
+        createMouldSlotButton(k);
+        if ((k & 1) == 1) {
+          uiYield();
+        }
+      }
     }
   }
 
+  // Transparent marker below the last row so LVGL scrolls over the whole
+  // library even though only the pool exists.
+  if (!ui.mouldListSpacer) {
+    ui.mouldListSpacer = lv_obj_create(ui.mouldList);
+    lv_obj_remove_style_all(ui.mouldListSpacer);
+    lv_obj_set_size(ui.mouldListSpacer, 1, MOULD_ROW_TOP);
+    lv_obj_clear_flag(ui.mouldListSpacer, LV_OBJ_FLAG_CLICKABLE);
+  }
+  lv_obj_set_y(ui.mouldListSpacer,
+               MOULD_ROW_TOP + MOULD_ROW_PITCH * renderCount);
+
+  ui.mouldRowsShown = renderCount;
+  lv_obj_update_layout(ui.mouldList);
+  lv_obj_readjust_scroll(ui.mouldList, LV_ANIM_OFF); // list may have shrunk
+  bindMouldRows(true);
+
   if (ui.selectedMould >= ui.mouldProfileCount) {
     ui.selectedMould = -1;
   }
-  Serial.println("PRD_UI: rebuild after loop before sync");
   syncMouldSendEditEnablement();
-  Serial.println("PRD_UI: rebuild after sync");
-  logUiState("rebuildMouldList");
-  lv_mem_monitor_t mon_after;
-  lv_mem_monitor(&mon_after);
-  ESP_LOGD(TAG,
-           "LVGL mem after rebuild: free=%u used_pct=%u frag_pct=%u largest=%u",
-           (unsigned)mon_after.free_size, (unsigned)mon_after.used_pct,
-           (unsigned)mon_after.frag_pct, (unsigned)mon_after.free_biggest_size);
-  Serial.println("PRD_UI: rebuild end");
+
+  if (stats.buttonsCreated != before.buttonsCreated ||
+      stats.labelPatches != before.labelPatches ||
+      stats.stylePatches != before.stylePatches ||
+      stats.visibilityPatches != before.visibilityPatches) {
+    ESP_LOGD(TAG,
+             "mould list sync: created=%u labels=%u styles=%u shown/hidden=%u "
+             "pages=%u (syncs=%u rebuilds=%u)",
+             (unsigned)(stats.buttonsCreated - before.buttonsCreated),
+             (unsigned)(stats.labelPatches - before.labelPatches),
+             (unsigned)(stats.stylePatches - before.stylePatches),
+             (unsigned)(stats.visibilityPatches - before.visibilityPatches),
+             (unsigned)(stats.pageLoads - before.pageLoads),
+             (unsigned)stats.syncs, (unsigned)stats.rebuilds);
+  }
+  if (needsCreate) {
+    lv_mem_monitor_t mon_after;
+    lv_mem_monitor(&mon_after);
+    ESP_LOGD(TAG,
+             "LVGL mem after list create: free=%u->%u frag_pct=%u largest=%u",
+             (unsigned)mon_before.free_size, (unsigned)mon_after.free_size,
+             (unsigned)mon_after.frag_pct,
+             (unsigned)mon_after.free_biggest_size);
+  }
+  logUiState("syncMouldList");
+}
+
+void reportMouldSearch(bool failed) {
+  char text[96];
+  if (failed) {
+    snprintf(text, sizeof(text), "Search index unavailable.");
+  } else if (ui.mouldHitCount == 0) {
+    snprintf(text, sizeof(text), "No profile matches \"%s\".",
+             ui.mouldSearch.query);
+  } else if (ui.mouldHitCount >= MOULD_SEARCH_MAX_HITS &&
+             !Storage::mouldSearchDone(ui.mouldSearch)) {
+    snprintf(text, sizeof(text), "Showing the first %d matches.",
+             ui.mouldHitCount);
+  } else {
+    snprintf(text, sizeof(text), "%d matching profile%s.", ui.mouldHitCount,
+             ui.mouldHitCount == 1 ? "" : "s");
+  }
+  setNotice(ui.mouldNotice, text,
+            lv_color_hex(failed ? 0xffff7a : 0xffd6d6d6));
+}
+
+// Runs the pending index scan for at most MOULD_SEARCH_BUDGET_US (plus one
+// slice) and shows whatever new hits it found.
+void continueMouldSearch() {
+  PrdUi::MouldListStats &stats = ui.mouldListStats;
+  const int64_t t0 = esp_timer_get_time();
+  const int before = ui.mouldHitCount;
+  bool failed = false;
+  while (ui.mouldSearchPending) {
+    if (ui.mouldHitCount >= MOULD_SEARCH_MAX_HITS ||
+        Storage::mouldSearchDone(ui.mouldSearch)) {
+      ui.mouldSearchPending = false;
+      break;
+    }
+    if (esp_timer_get_time() - t0 >= MOULD_SEARCH_BUDGET_US)
+      break;
+    int room = MOULD_SEARCH_MAX_HITS - ui.mouldHitCount;
+    int n = Storage::stepMouldSearch(
+        ui.mouldSearch, MOULD_SEARCH_STEP_ROWS,
+        &ui.mouldHits[ui.mouldHitCount],
+        room < MOULD_SEARCH_STEP_HITS ? room : MOULD_SEARCH_STEP_HITS);
+    if (n < 0) {
+      failed = true;
+      ui.mouldSearchPending = false;
+      break;
+    }
+    ui.mouldHitCount += n;
+  }
+
+  const uint32_t us = static_cast<uint32_t>(esp_timer_get_time() - t0);
+  stats.searchSteps++;
+  if (us > stats.searchStepUsMax)
+    stats.searchStepUsMax = us;
+  if (ui.mouldHitCount != before)
+    syncMouldList();
+  if (!ui.mouldSearchPending) {
+    ESP_LOGD(TAG, "mould search '%s': %d hits in %u ms",
+             ui.mouldSearch.query, ui.mouldHitCount,
+             (unsigned)((esp_timer_get_time() - ui.mouldSearchStartUs) /
+                        1000));
+    reportMouldSearch(failed);
+  }
+}
+
+// Starts over from the search box text; an empty box shows the library.
+void restartMouldSearch() {
+  const char *query =
+      ui.mouldSearchBox ? lv_textarea_get_text(ui.mouldSearchBox) : nullptr;
+  const bool active = query && query[0] != '\0';
+  const bool wasActive = ui.mouldSearchActive;
+  ui.mouldSearchActive = active;
+  ui.mouldSearchPending = active;
+  ui.mouldHitCount = 0;
+  if (active) {
+    ui.mouldListStats.searches++;
+    ui.mouldSearchStartUs = esp_timer_get_time();
+    Storage::beginMouldSearch(ui.mouldSearch, query);
+    if (PPInjectorUI_mould_name_matches(ui.currentMould.name,
+                                        &ui.mouldSearch)) {
+      Storage::MouldIndexEntry &hit = ui.mouldHits[ui.mouldHitCount++];
+      hit = Storage::MouldIndexEntry{};
+      memcpy(hit.name, ui.currentMould.name, sizeof(hit.name));
+    }
+  }
+  // Sync first: scrolling re-binds rows, which must not see a stale count.
+  syncMouldList();
+  if (active || wasActive)
+    lv_obj_scroll_to_y(ui.mouldList, 0, LV_ANIM_OFF);
+  if (active)
+    continueMouldSearch();
+  else if (wasActive)
+    setNotice(ui.mouldNotice, "Select a profile.", lv_color_hex(0xffd6d6d6));
+}
+
+// Re-shows the list after the library changed, re-running an active search.
+void refreshMouldLibraryView() {
+  if (ui.mouldSearchActive)
+    restartMouldSearch();
+  else
+    syncMouldList();
+}
+
+void clearMouldSearch() {
+  if (ui.mouldSearchBox && ui.mouldSearchActive)
+    lv_textarea_set_text(ui.mouldSearchBox, ""); // VALUE_CHANGED restarts
+}
+
+void hideMouldSearchKeyboard() {
+  if (!ui.mouldSearchKeyboard)
+    return;
+  lv_keyboard_set_textarea(ui.mouldSearchKeyboard, nullptr);
+  lv_obj_add_flag(ui.mouldSearchKeyboard, LV_OBJ_FLAG_HIDDEN);
+}
+
+// The keyboard is only created the first time someone searches.
+void showMouldSearchKeyboard() {
+  if (!ui.mouldSearchKeyboard) {
+    ui.mouldSearchKeyboard = lv_keyboard_create(ui.rightPanelMould);
+    lv_obj_set_size(ui.mouldSearchKeyboard, 480, 250);
+    styleKeyboardChrome(ui.mouldSearchKeyboard);
+  }
+#if !SCREEN_DIAG_FORCE_KEYBOARD_CENTER
+  alignKeyboardForField(ui.mouldSearchKeyboard, objects.mould_settings,
+                        ui.mouldSearchBox);
+#else
+  lv_obj_center(ui.mouldSearchKeyboard);
+#endif
+  lv_keyboard_set_textarea(ui.mouldSearchKeyboard, ui.mouldSearchBox);
+  lv_keyboard_set_mode(ui.mouldSearchKeyboard, LV_KEYBOARD_MODE_TEXT_LOWER);
+  lv_obj_clear_flag(ui.mouldSearchKeyboard, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_move_foreground(ui.mouldSearchKeyboard);
+}
+
+void onMouldSearchEvent(lv_event_t *event) {
+  lv_event_code_t code = lv_event_get_code(event);
+  if (code == LV_EVENT_VALUE_CHANGED) {
+    restartMouldSearch();
+  } else if (code == LV_EVENT_CLICKED || code == LV_EVENT_FOCUSED) {
+    showMouldSearchKeyboard();
+  } else if (code == LV_EVENT_READY || code == LV_EVENT_CANCEL ||
+             code == LV_EVENT_DEFOCUSED) {
+    hideMouldSearchKeyboard();
+  }
 }
 
 void onMouldSend(lv_event_t *) {
@@ -1423,7 +2325,12 @@ void onMouldSend(lv_event_t *) {
     return;
   }
 
-  if (DisplayComms::sendMould(ui.mouldProfiles[ui.selectedMould])) {
+  if (!loadSelectedProfile(ui.selectedMould)) {
+    setNotice(ui.mouldNotice, "Cannot read profile from storage.",
+              lv_color_hex(0xffff7a));
+    return;
+  }
+  if (DisplayComms::sendMould(ui.selectedProfile)) {
     setNotice(ui.mouldNotice, "MOULD command sent.", lv_color_hex(0xff9be7a5));
   } else {
     setNotice(ui.mouldNotice, "Failed to send MOULD command.",
@@ -1538,8 +2445,8 @@ void onMouldEditSave(lv_event_t *) {
     return;
   }
 
-  // Save inputs back to snapshot -> ui.mouldProfiles
-  DisplayComms::MouldParams &p = ui.mouldProfiles[ui.selectedMould];
+  // Save inputs back to snapshot -> ui.selectedProfile -> library row
+  DisplayComms::MouldParams &p = ui.selectedProfile;
 
   for (int i = 0; i < MOULD_FIELD_COUNT; i++) {
     if (!ui.mouldEditInputs[i])
@@ -1611,15 +2518,21 @@ void onMouldEditSave(lv_event_t *) {
       p.injectTorque = atof(txt);
   }
 
-  Storage::saveMoulds(ui.mouldProfiles, ui.mouldProfileCount);
-  rebuildMouldList(); // Refresh list names
+  const bool saved = Storage::writeMould(ui.selectedMould, p);
+  invalidateMouldPages();
+  refreshMouldLibraryView(); // Refresh list names
 
   // If this is the active mould, update controller?
   // User must click "Send" explicitly from the list to update controller.
 
   lv_obj_add_flag(ui.rightPanelMouldEdit, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(ui.rightPanelMould, LV_OBJ_FLAG_HIDDEN);
-  setNotice(ui.mouldNotice, "Profile saved.", lv_color_hex(0xff9be7a5));
+  if (saved) {
+    setNotice(ui.mouldNotice, "Profile saved.", lv_color_hex(0xff9be7a5));
+  } else {
+    setNotice(ui.mouldNotice, "Failed to save profile.",
+              lv_color_hex(0xffff7a));
+  }
   logUiState("onMouldEditSave");
 }
 
@@ -1630,6 +2543,11 @@ void onMouldEdit(lv_event_t *) {
     setNotice(ui.mouldNotice, "Select a mould first.", lv_color_hex(0xfff0a0));
     return;
   }
+  if (!loadSelectedProfile(ui.selectedMould)) {
+    setNotice(ui.mouldNotice, "Cannot read profile from storage.",
+              lv_color_hex(0xffff7a));
+    return;
+  }
 
   if (!ensureMouldEditPanel()) {
     setNotice(ui.mouldNotice, "Cannot open editor (LVGL mem).",
@@ -1674,7 +2592,7 @@ void onMouldEdit(lv_event_t *) {
   }
 
   // Populate fields
-  DisplayComms::MouldParams &p = ui.mouldProfiles[ui.selectedMould];
+  DisplayComms::MouldParams &p = ui.selectedProfile;
   for (int i = 0; i < MOULD_FIELD_COUNT; i++) {
     if (!ui.mouldEditInputs[i])
       continue;
@@ -1743,9 +2661,10 @@ void onMouldEdit(lv_event_t *) {
 void onMouldNew(lv_event_t *) {
   Serial.println("PRD_UI: onMouldNew begin");
   logUiState("onMouldNew.begin");
-  if (ui.mouldProfileCount >= MAX_MOULD_PROFILES) {
-    setNotice(ui.mouldNotice, "Profile limit reached.", lv_color_hex(0xffff7a));
-    Serial.println("PRD_UI: onMouldNew limit reached");
+  // Row 0 may still only exist in RAM (nothing stored yet); it has to reach
+  // flash first so the new profile does not take the controller slot.
+  if (Storage::mouldCount() == 0 && !Storage::writeMould(0, ui.currentMould)) {
+    setNotice(ui.mouldNotice, "Storage unavailable.", lv_color_hex(0xffff7a));
     return;
   }
 
@@ -1770,16 +2689,23 @@ void onMouldNew(lv_event_t *) {
   newProfile.packDecel = 100.0f;
   newProfile.injectTorque = 0.5f;
 
-  ui.mouldProfiles[ui.mouldProfileCount] = newProfile;
-  ui.mouldProfileCount++;
+  if (!Storage::writeMould(ui.mouldProfileCount, newProfile)) {
+    setNotice(ui.mouldNotice, "Failed to store profile.",
+              lv_color_hex(0xffff7a));
+    return;
+  }
+  Serial.println("PRD_UI: onMouldNew after save");
+  ui.mouldProfileCount = Storage::mouldCount();
   Serial.printf("PRD_UI: onMouldNew after append count=%d\n",
                 ui.mouldProfileCount);
   delay(0);
-  rebuildMouldList();
-  Serial.println("PRD_UI: onMouldNew after rebuild");
-  delay(0);
-  Storage::saveMoulds(ui.mouldProfiles, ui.mouldProfileCount);
-  Serial.println("PRD_UI: onMouldNew after save");
+  invalidateMouldPages();
+  clearMouldSearch(); // the new row has to be in view
+  syncMouldList();
+  lv_obj_scroll_to_y(ui.mouldList,
+                     MOULD_ROW_PITCH * (ui.mouldProfileCount - 1),
+                     LV_ANIM_OFF);
+  Serial.println("PRD_UI: onMouldNew after list sync");
   setNotice(ui.mouldNotice, "Created local mould profile.",
             lv_color_hex(0xff9be7a5));
   Serial.println("PRD_UI: onMouldNew after notice");
@@ -1793,21 +2719,26 @@ void onMouldDelete(lv_event_t *) {
   }
 
   const int removeIndex = ui.selectedMould;
-  for (int i = removeIndex; i < ui.mouldProfileCount - 1; i++) {
-    ui.mouldProfiles[i] = ui.mouldProfiles[i + 1];
+  if (removeIndex == 0) {
+    // Slot 0 mirrors the controller and is refilled from every MOULD_OK.
+    setNotice(ui.mouldNotice, "The current mould cannot be deleted.",
+              lv_color_hex(0xfff0a0));
+    return;
   }
-  if (ui.mouldProfileCount > 0) {
-    ui.mouldProfileCount--;
+  if (!Storage::removeMould(removeIndex)) {
+    setNotice(ui.mouldNotice, "Failed to delete profile.",
+              lv_color_hex(0xffff7a));
+    return;
   }
-
-  if (removeIndex == 0) {
-    ui.lastMouldName[0] = '\0';
+  ui.mouldProfileCount = Storage::mouldCount();
+  if (ui.mouldProfileCount < 1) {
+    ui.mouldProfileCount = 1;
   }
 
   ui.selectedMould = -1;
   ui.lastTappedMould = -1;
-  rebuildMouldList();
-  Storage::saveMoulds(ui.mouldProfiles, ui.mouldProfileCount);
+  invalidateMouldPages();
+  refreshMouldLibraryView();
   setNotice(ui.mouldNotice, "Profile deleted.", lv_color_hex(0xfff0a0));
   logUiState("onMouldDelete");
 }
@@ -1911,6 +2842,7 @@ void assignCommonField(DisplayComms::CommonParams &common, int fieldIndex,
   case 14:
     ui.heatTimeMin = value;
     Storage::saveLocalSettings(ui.heatTimeMin);
+    ui.nextBandChangeMs = millis(); // stages moved, re-render the bands
     break;
   default:
     break;
@@ -2013,6 +2945,7 @@ bool sendCommonFromInputs() {
           static_cast<float>(atof(lv_textarea_get_text(ui.commonInputs[i])));
       ui.heatTimeMin = value;
       Storage::saveLocalSettings(ui.heatTimeMin);
+      ui.nextBandChangeMs = millis(); // stages moved, re-render the bands
     }
   }
 
@@ -2127,6 +3060,7 @@ void createMainPanel() {
 
   ui.stateAction3 = createButton(ui.rightPanelMain, "End of Day", 18, 310,
                                  RIGHT_WIDTH - 36, 52, onNavigate);
+  lv_obj_add_style(ui.stateAction3, &PrdTheme::styles().eodIdle, LV_PART_MAIN);
   lv_obj_add_flag(ui.stateAction3, LV_OBJ_FLAG_HIDDEN);
 
   createButton(ui.rightPanelMain, "Mould Settings", 18, 720, 150, 58,
@@ -2151,7 +3085,8 @@ void createMainPanel() {
                    RIGHT_WIDTH - 36, 46, onNavigate,
                    reinterpret_cast<void *>(
                        static_cast<intptr_t>(SCREEN_ID_MOULD_SETTINGS)));
-  lv_obj_set_style_border_width(ui.mainMouldDisplay, 1, 0);
+  lv_obj_add_style(ui.mainMouldDisplay, &PrdTheme::styles().mouldPlaceholder,
+                   LV_PART_MAIN);
   syncMainMouldDisplay();
 
   ui.mainErrorLabel = lv_label_create(ui.rightPanelMain);
@@ -2178,9 +3113,19 @@ void createMouldPanel() {
                              LV_PART_MAIN | LV_STATE_DEFAULT);
   lv_label_set_text(title, "Mould Selection");
 
+  ui.mouldSearchBox = lv_textarea_create(ui.rightPanelMould);
+  lv_obj_set_pos(ui.mouldSearchBox, 18, 54);
+  lv_obj_set_size(ui.mouldSearchBox, RIGHT_WIDTH - 36, 42);
+  lv_textarea_set_one_line(ui.mouldSearchBox, true);
+  lv_textarea_set_max_length(ui.mouldSearchBox,
+                             sizeof(DisplayComms::MouldParams::name) - 1);
+  lv_textarea_set_placeholder_text(ui.mouldSearchBox, "Search by name");
+  lv_obj_add_event_cb(ui.mouldSearchBox, onMouldSearchEvent, LV_EVENT_ALL,
+                      nullptr);
+
   ui.mouldList = lv_obj_create(ui.rightPanelMould);
-  lv_obj_set_pos(ui.mouldList, 18, 54);
-  lv_obj_set_size(ui.mouldList, RIGHT_WIDTH - 36, 530);
+  lv_obj_set_pos(ui.mouldList, 18, 104);
+  lv_obj_set_size(ui.mouldList, RIGHT_WIDTH - 36, MOULD_LIST_HEIGHT);
   lv_obj_set_style_bg_color(ui.mouldList, lv_color_hex(0x1a222b),
                             LV_PART_MAIN | LV_STATE_DEFAULT);
   lv_obj_set_style_border_color(ui.mouldList, lv_color_hex(0x3a4a5a),
@@ -2192,6 +3137,8 @@ void createMouldPanel() {
   lv_obj_set_scroll_dir(ui.mouldList, LV_DIR_VER);
   lv_obj_clear_flag(ui.mouldList, LV_OBJ_FLAG_SCROLL_ELASTIC);
   lv_obj_clear_flag(ui.mouldList, LV_OBJ_FLAG_SCROLL_MOMENTUM);
+  lv_obj_add_event_cb(ui.mouldList, onMouldListScroll, LV_EVENT_SCROLL,
+                      nullptr);
 
   ui.mouldNotice = lv_label_create(ui.rightPanelMould);
   lv_obj_set_pos(ui.mouldNotice, 18, 592);
@@ -2473,26 +3420,32 @@ void createCommonPanel() {
 }
 
 void updateStateWidgets(const DisplayComms::Status &status) {
-  static char lastState[24] = {1}; // Force initial update
+  static DisplayComms::MachineState lastState =
+      DisplayComms::MachineState::Unknown;
+  static bool lastHasState = false;
   static bool lastEod = false;
   static bool firstRun = true;
 
-  const char *stateText = status.state[0] != '\0' ? status.state : "--";
-  bool stateChanged = (strcmp(stateText, lastState) != 0);
+  const bool hasState = (status.state[0] != '\0');
+  const char *stateText = hasState ? status.state : "--";
+  const DisplayComms::MachineStateInfo &info =
+      DisplayComms::machineStateInfo(status.stateId);
+  bool stateChanged = firstRun || status.stateId != lastState ||
+                      hasState != lastHasState;
   bool eodChanged = (status.endOfDayFlag != lastEod) || firstRun;
 
+  // Unknown states differ only by name; refresh the label without re-binding.
+  setLabelTextIfChanged(ui.stateValue, stateText);
   if (!stateChanged && !eodChanged) {
     return;
   }
 
   // Preserve state for next check
-  strncpy(lastState, stateText, sizeof(lastState) - 1);
-  lastState[sizeof(lastState) - 1] = '\0';
+  lastState = status.stateId;
+  lastHasState = hasState;
   lastEod = status.endOfDayFlag;
   firstRun = false;
 
-  setLabelTextIfChanged(ui.stateValue, stateText);
-
   // Global EOD Frame - Only update if EOD changed
   if (ui.globalEodFrame && eodChanged) {
     if (status.endOfDayFlag) {
@@ -2502,69 +3455,37 @@ void updateStateWidgets(const DisplayComms::Status &status) {
     }
   }
 
-  bool hasState = (status.state[0] != '\0');
   if (hasState) {
-    // Determine Y position based on state to prevent double-tap accidents
-    int btnY = 240; // Default Row 2
-    if (strcmp(stateText, "REFILL") == 0 || strcmp(stateText, "INJECT") == 0 ||
-        strcmp(stateText, "INIT_HOMED_ENCODER_ZEROED") == 0) {
-      btnY = 170; // Row 1
-    } else if (strcmp(stateText, "READY_TO_INJECT") == 0 ||
-               strcmp(stateText, "PURGE_ZERO") == 0 ||
-               strcmp(stateText, "RELEASE") == 0 ||
-               strcmp(stateText, "ANTIDRIP") == 0 ||
-               strcmp(stateText, "CONFIRM_MOULD_REMOVAL") == 0) {
-      btnY = 310; // Row 3
-    }
-    // COMPRESSION, HOLD_INJECTION, INIT_HOT_WAIT stay at Row 2 (240)
+    // Button row depends on the state to prevent double-tap accidents
+    static const int ROW_Y[] = {170, 240, 310};
+    const int btnY = ROW_Y[info.buttonRow >= 1 && info.buttonRow <= 3
+                               ? info.buttonRow - 1
+                               : 1];
+    const StateActionButton &action =
+        STATE_ACTION_BUTTONS[static_cast<size_t>(info.action)];
 
     if (ui.stateAction1) {
-      lv_obj_clear_flag(ui.stateAction1, LV_OBJ_FLAG_HIDDEN);
-      lv_obj_set_y(ui.stateAction1, btnY);
-      lv_obj_t *label = lv_obj_get_child(ui.stateAction1, 0);
-
-      // Only re-bind if state changed
-      if (stateChanged) {
-        lv_obj_remove_event_cb(ui.stateAction1, nullptr);
+      if (action.onClick) {
+        lv_obj_clear_flag(ui.stateAction1, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_set_y(ui.stateAction1, btnY);
 
-        if (strcmp(stateText, "REFILL") == 0) {
-          if (label)
-            setLabelTextIfChanged(label, "Compress");
-          lv_obj_add_event_cb(ui.stateAction1, onStateActionGotoCompression,
-                              LV_EVENT_CLICKED, nullptr);
-        } else if (strcmp(stateText, "COMPRESSION") == 0) {
-          if (label)
-            setLabelTextIfChanged(label, "Abort to Refill");
-          lv_obj_add_event_cb(ui.stateAction1, onStateActionGotoRefill,
-                              LV_EVENT_CLICKED, nullptr);
-        } else if (strcmp(stateText, "READY_TO_INJECT") == 0) {
-          if (label)
-            setLabelTextIfChanged(label, "Purge Zero");
-          lv_obj_add_event_cb(ui.stateAction1, onStateActionGotoPurge,
-                              LV_EVENT_CLICKED, nullptr);
-        } else if (strcmp(stateText, "PURGE_ZERO") == 0) {
-          if (label)
-            setLabelTextIfChanged(label, "Stop Purge");
-          lv_obj_add_event_cb(ui.stateAction1, onStateActionGotoReady,
-                              LV_EVENT_CLICKED, nullptr);
-        } else if (strcmp(stateText, "INIT_HOT_WAIT") == 0 ||
-                   strcmp(stateText, "INIT_HOMED_ENCODER_ZEROED") == 0) {
+        // Only re-bind if state changed
+        if (stateChanged) {
+          lv_obj_t *label = lv_obj_get_child(ui.stateAction1, 0);
+          lv_obj_remove_event_cb(ui.stateAction1, nullptr);
           if (label)
-            setLabelTextIfChanged(label, "HOME");
-          lv_obj_add_event_cb(ui.stateAction1, onStateActionGotoHome,
+            setLabelTextIfChanged(label, action.label);
+          lv_obj_add_event_cb(ui.stateAction1, action.onClick,
                               LV_EVENT_CLICKED, nullptr);
-        } else {
-          lv_obj_add_flag(ui.stateAction1, LV_OBJ_FLAG_HIDDEN);
         }
-      }
-    } else {
-      if (ui.stateAction1)
+      } else {
         lv_obj_add_flag(ui.stateAction1, LV_OBJ_FLAG_HIDDEN);
+      }
     }
 
     if (ui.stateAction2) {
       lv_obj_t *label = lv_obj_get_child(ui.stateAction2, 0);
-      if (strcmp(stateText, "READY_TO_INJECT") == 0) {
+      if (info.flags & DisplayComms::STATE_ABORT_BUTTON) {
         lv_obj_clear_flag(ui.stateAction2, LV_OBJ_FLAG_HIDDEN);
         lv_obj_set_y(ui.stateAction2, btnY);
         if (stateChanged) {
@@ -2581,7 +3502,7 @@ void updateStateWidgets(const DisplayComms::Status &status) {
 
     // End of Day Button (stateAction3) - REFILL ONLY
     if (ui.stateAction3) {
-      if (strcmp(stateText, "REFILL") == 0) {
+      if (info.flags & DisplayComms::STATE_EOD_BUTTON) {
         lv_obj_clear_flag(ui.stateAction3, LV_OBJ_FLAG_HIDDEN);
         lv_obj_set_y(ui.stateAction3, 310);
 
@@ -2597,15 +3518,10 @@ void updateStateWidgets(const DisplayComms::Status &status) {
                                                            : "End of Day");
         }
 
-        if (status.endOfDayFlag) {
-          lv_obj_set_style_bg_color(ui.stateAction3, lv_color_hex(0x000000), 0);
-          lv_obj_set_style_border_width(ui.stateAction3, 2, 0);
-          lv_obj_set_style_border_color(ui.stateAction3, lv_color_hex(0x0000FF),
-                                        0);
-        } else {
-          lv_obj_set_style_bg_color(ui.stateAction3, lv_color_hex(0x2196F3), 0);
-          lv_obj_set_style_border_width(ui.stateAction3, 0, 0);
-        }
+        const PrdTheme::Styles &theme = PrdTheme::styles();
+        PrdTheme::swap(ui.stateAction3,
+                       status.endOfDayFlag ? &theme.eodIdle : &theme.eodActive,
+                       status.endOfDayFlag ? &theme.eodActive : &theme.eodIdle);
       } else {
         lv_obj_add_flag(ui.stateAction3, LV_OBJ_FLAG_HIDDEN);
       }
@@ -2627,18 +3543,350 @@ void updateMouldListFromComms(const DisplayComms::MouldParams &mould) {
   }
 
   bool nameChanged = strcmp(ui.lastMouldName, mould.name) != 0;
+  bool listChanged =
+      ui.mouldProfileCount == 0 ||
+      strncmp(ui.currentMould.name, mould.name,
+              sizeof(ui.currentMould.name)) != 0;
 
-  // Always update slot 0 with the latest controller data.
+  // Always update slot 0 with the latest controller data; the store skips
+  // the write when the record is unchanged.
   if (ui.mouldProfileCount == 0) {
     ui.mouldProfileCount = 1;
   }
-  ui.mouldProfiles[0] = mould;
+  ui.currentMould = mould;
+  Storage::writeMould(0, mould);
   if (nameChanged) {
     strncpy(ui.lastMouldName, mould.name, sizeof(ui.lastMouldName) - 1);
     ui.lastMouldName[sizeof(ui.lastMouldName) - 1] = '\0';
   }
-  rebuildMouldList();
-  syncMainMouldDisplay();
+  // Only the slot-0 label depends on comms data; skip the list walk otherwise.
+  if (listChanged) {
+    refreshMouldLibraryView();
+    syncMainMouldDisplay();
+  }
+}
+
+#if CONFIG_PPINJECTORUI_MOULD_LIST_BENCH
+// Fills a scratch library with CONFIG_PPINJECTORUI_MOULD_LIST_BENCH_ROWS
+// synthetic profiles, points the list at it and scrolls top to bottom in
+// third-of-a-row steps. Each step is timed through re-binding and layout
+// (plus a full refresh when the mould screen is the active one), and heap is
+// sampled around the run: with the virtual list neither should follow the
+// row count.
+void runMouldListBenchmark() {
+  const int rows = CONFIG_PPINJECTORUI_MOULD_LIST_BENCH_ROWS;
+  if (!isObjReady(ui.mouldList) || !Storage::beginScratchMoulds(rows)) {
+    ESP_LOGW(TAG, "mould list bench: cannot prepare %d rows", rows);
+    return;
+  }
+
+  const size_t heapBefore = esp_get_free_heap_size();
+  lv_mem_monitor_t memBefore;
+  lv_mem_monitor(&memBefore);
+  const PrdUi::MouldListStats before = ui.mouldListStats;
+  const int savedCount = ui.mouldProfileCount;
+  const int savedSelection = ui.selectedMould;
+  ui.selectedMould = -1;
+
+  ui.mouldProfileCount = Storage::mouldCount();
+  invalidateMouldPages();
+  syncMouldList();
+  const bool render = lv_screen_active() == objects.mould_settings;
+  const int32_t step = MOULD_ROW_PITCH / 3;
+  const int32_t end = MOULD_ROW_PITCH * ui.mouldProfileCount;
+  uint32_t steps = 0;
+  uint32_t worstUs = 0;
+  uint64_t totalUs = 0;
+  for (int32_t y = 0; y <= end; y += step) {
+    const int64_t t0 = esp_timer_get_time();
+    lv_obj_scroll_to_y(ui.mouldList, y, LV_ANIM_OFF);
+    lv_obj_update_layout(ui.mouldList);
+    if (render) {
+      lv_refr_now(nullptr);
+    }
+    const uint32_t us = static_cast<uint32_t>(esp_timer_get_time() - t0);
+    totalUs += us;
+    worstUs = us > worstUs ? us : worstUs;
+    if ((++steps & 15) == 0) {
+      delay(1); // let the idle task feed the watchdog
+    }
+  }
+
+  lv_mem_monitor_t memAfter;
+  lv_mem_monitor(&memAfter);
+  const size_t heapAfter = esp_get_free_heap_size();
+  const PrdUi::MouldListStats &after = ui.mouldListStats;
+  ESP_LOGI(TAG,
+           "mould list bench: rows=%d steps=%u %s avg=%uus max=%uus "
+           "binds=%u pages=%u buttons=%u/%d",
+           ui.mouldProfileCount, (unsigned)steps,
+           render ? "bind+layout+render" : "bind+layout",
+           (unsigned)(steps ? totalUs / steps : 0), (unsigned)worstUs,
+           (unsigned)(after.rowBinds - before.rowBinds),
+           (unsigned)(after.pageLoads - before.pageLoads),
+           (unsigned)after.buttonsCreated, MOULD_ROW_POOL);
+  ESP_LOGI(TAG, "mould list bench: heap free %u->%u, LVGL free %u->%u",
+           (unsigned)heapBefore, (unsigned)heapAfter,
+           (unsigned)memBefore.free_size, (unsigned)memAfter.free_size);
+
+  Storage::endScratchMoulds();
+  ui.mouldProfileCount = savedCount;
+  ui.selectedMould = savedSelection;
+  invalidateMouldPages();
+  lv_obj_scroll_to_y(ui.mouldList, 0, LV_ANIM_OFF);
+  syncMouldList();
+}
+#endif
+
+#if CONFIG_PPINJECTORUI_DISPLAY_BENCH
+// Display stress benchmark: an idle baseline, then the plunger sweeping its
+// travel while every refill band changes height and heat colour, then the
+// same with the whole screen invalidated each step. A low-priority task on
+// the other core copies PSRAM to PSRAM throughout, so each phase also shows
+// how much PSRAM bandwidth rendering and scan-out leave over.
+constexpr uint32_t DISPLAY_BENCH_IDLE_MS = 1000;
+constexpr uint32_t DISPLAY_BENCH_SWEEP_MS = 2000;
+constexpr size_t DISPLAY_BENCH_COPY_BYTES = 128 * 1024; // beyond the cache
+const char *const DISPLAY_BENCH_PHASES[] = {"idle", "plunger", "full"};
+
+struct DisplayBench {
+  lv_timer_t *timer = nullptr;
+  int phase = 0;
+  uint32_t phaseStartMs = 0;
+  uint32_t renders = 0;
+  TouchScreen_panel_stats_t phaseStats = {};
+  uint32_t phaseCopies = 0;
+  uint32_t phaseCopyUs = 0;
+  // Owned by the copy task, which frees the buffers once stopped.
+  uint8_t *copySrc = nullptr;
+  uint8_t *copyDst = nullptr;
+  volatile bool copyStop = false;
+  volatile uint32_t copies = 0;
+  volatile uint32_t copyUs = 0;
+};
+
+DisplayBench s_displayBench;
+
+void displayBenchCopyTask(void *) {
+  DisplayBench &b = s_displayBench;
+  while (!b.copyStop) {
+    const int64_t t0 = esp_timer_get_time();
+    memcpy(b.copyDst, b.copySrc, DISPLAY_BENCH_COPY_BYTES);
+    b.copyUs = b.copyUs + static_cast<uint32_t>(esp_timer_get_time() - t0);
+    b.copies = b.copies + 1;
+    vTaskDelay(1); // leave the idle task its share of the core
+  }
+  heap_caps_free(b.copySrc);
+  heap_caps_free(b.copyDst);
+  b.copySrc = b.copyDst = nullptr;
+  vTaskDelete(nullptr);
+}
+
+void displayBenchOnRender(lv_event_t *) { s_displayBench.renders++; }
+
+void beginDisplayBenchPhase(uint32_t now) {
+  DisplayBench &b = s_displayBench;
+  b.phaseStartMs = now;
+  b.renders = 0;
+  TouchScreen_panel_stats(&b.phaseStats); // also resets the longest frame
+  b.phaseCopies = b.copies;
+  b.phaseCopyUs = b.copyUs;
+}
+
+void endDisplayBenchPhase(uint32_t elapsedMs) {
+  const DisplayBench &b = s_displayBench;
+  TouchScreen_panel_stats_t st = {};
+  TouchScreen_panel_stats(&st);
+  const uint32_t copyUs = b.copyUs - b.phaseCopyUs;
+  const uint64_t copied = static_cast<uint64_t>(b.copies - b.phaseCopies) *
+                          DISPLAY_BENCH_COPY_BYTES;
+  const uint32_t fps10 = elapsedMs ? b.renders * 10000 / elapsedMs : 0;
+  ESP_LOGI(TAG,
+           "display bench: %-7s %5u ms fps=%u.%u frames=%u scanned=%u "
+           "slips=%u restarts=%u max frame=%u us psram copy=%u MB/s",
+           DISPLAY_BENCH_PHASES[b.phase], (unsigned)elapsedMs,
+           (unsigned)(fps10 / 10), (unsigned)(fps10 % 10), (unsigned)b.renders,
+           (unsigned)(st.frames - b.phaseStats.frames),
+           (unsigned)(st.slips - b.phaseStats.slips),
+           (unsigned)(st.restarts - b.phaseStats.restarts),
+           (unsigned)st.frame_us_max,
+           (unsigned)(copyUs ? copied / copyUs : 0)); // bytes/us = MB/s
+}
+
+void finishDisplayBench() {
+  DisplayBench &b = s_displayBench;
+  b.copyStop = true;
+  lv_timer_delete(b.timer);
+  b.timer = nullptr;
+  lv_display_t *display = lv_display_get_default();
+  if (display) {
+    lv_display_remove_event_cb_with_user_data(display, displayBenchOnRender,
+                                              nullptr);
+  }
+  // The band model kept following the controller; show it again.
+  updatePlungerPosition(DisplayComms::getStatus().encoderTurns);
+  refreshLiveWidgets(LIVE_BANDS);
+  ui.nextBandChangeMs = nextRefillBandChangeMs(millis());
+}
+
+void displayBenchStep(lv_timer_t *) {
+  DisplayBench &b = s_displayBench;
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - b.phaseStartMs;
+  const uint32_t phaseMs = b.phase == 0
+                               ? DISPLAY_BENCH_IDLE_MS
+                               : CONFIG_PPINJECTORUI_DISPLAY_BENCH_S * 500;
+  if (elapsed >= phaseMs) {
+    endDisplayBenchPhase(elapsed);
+    if (++b.phase == 3) {
+      finishDisplayBench();
+      return;
+    }
+    beginDisplayBenchPhase(now);
+    return;
+  }
+  if (b.phase == 0) {
+    return;
+  }
+
+  const uint32_t t = now % DISPLAY_BENCH_SWEEP_MS;
+  const uint32_t half = DISPLAY_BENCH_SWEEP_MS / 2;
+  const float sweep =
+      static_cast<float>(t < half ? t : DISPLAY_BENCH_SWEEP_MS - t) / half;
+  updatePlungerPosition(TURNS_MIN + (TURNS_MAX - TURNS_MIN) * sweep);
+
+  // Synthetic full stack drawn over the real band model, which is put back
+  // right after so the controller's view of it is not disturbed.
+  RefillBlock saved[16];
+  for (int i = 0; i < 16; ++i) {
+    saved[i] = ui.refillBlocks[i];
+  }
+  const int savedCount = ui.blockCount;
+  const float savedLift = ui.blockStackLift;
+  const float bandTurns = REFILL_STACK_BOTTOM_Y / 16.0f / REFILL_PX_PER_TURN;
+  const float heatStepMs = ui.heatTimeMin * 60.0f * 1000.0f / 16.0f;
+  for (int i = 0; i < 16; ++i) {
+    const uint32_t wobble = (now / 40 + i * 7) % 32;
+    const uint32_t stage = (now / 250 + i) % 16;
+    ui.refillBlocks[i] =
+        RefillBlock(bandTurns * (0.5f + wobble / 62.0f),
+                    now - static_cast<uint32_t>(stage * heatStepMs), true);
+  }
+  ui.blockCount = 16;
+  ui.blockStackLift = 0;
+  refreshLiveWidgets(LIVE_BANDS);
+  for (int i = 0; i < 16; ++i) {
+    ui.refillBlocks[i] = saved[i];
+  }
+  ui.blockCount = savedCount;
+  ui.blockStackLift = savedLift;
+
+  if (b.phase == 2) {
+    lv_obj_invalidate(lv_screen_active());
+  }
+}
+
+void runDisplayBenchmark() {
+  DisplayBench &b = s_displayBench;
+  TouchScreen_panel_stats_t st = {};
+  lv_display_t *display = lv_display_get_default();
+  if (!display || !TouchScreen_panel_stats(&st)) {
+    ESP_LOGW(TAG, "display bench: no panel monitor");
+    return;
+  }
+  b.copySrc = static_cast<uint8_t *>(
+      heap_caps_malloc(DISPLAY_BENCH_COPY_BYTES, MALLOC_CAP_SPIRAM));
+  b.copyDst = static_cast<uint8_t *>(
+      heap_caps_malloc(DISPLAY_BENCH_COPY_BYTES, MALLOC_CAP_SPIRAM));
+  if (b.copySrc) {
+    memset(b.copySrc, 0x5a, DISPLAY_BENCH_COPY_BYTES);
+  }
+  const BaseType_t core = CONFIG_LVGL_PORT_TASK_CORE == 0   ? 1
+                          : CONFIG_LVGL_PORT_TASK_CORE == 1 ? 0
+                                                            : tskNO_AFFINITY;
+  if (!b.copySrc || !b.copyDst ||
+      xTaskCreatePinnedToCore(displayBenchCopyTask, "disp_bench", 2048,
+                              nullptr, 1, nullptr, core) != pdPASS) {
+    heap_caps_free(b.copySrc);
+    heap_caps_free(b.copyDst);
+    b.copySrc = b.copyDst = nullptr;
+    ESP_LOGW(TAG, "display bench: cannot start the PSRAM copy task");
+    return;
+  }
+
+#if CONFIG_LVGL_PORT_AVOID_TEAR_MODE == 3 && CONFIG_LVGL_PORT_ROTATION_DEGREE == 0
+  const char *drawBuffers = "none (direct)";
+#elif CONFIG_LVGL_PORT_BUF_INTERNAL
+  const char *drawBuffers = "internal RAM";
+#else
+  const char *drawBuffers = "PSRAM";
+#endif
+  ESP_LOGI(TAG,
+           "display bench: pclk=%u Hz bounce=%u lines frame buffers=%u "
+           "draw buffers=%s psram align=%u scan-out=%u MB/s frame=%u us "
+           "slip=%u us",
+           (unsigned)st.pixel_clock_hz, (unsigned)st.bounce_lines,
+           (unsigned)st.frame_buffers, drawBuffers,
+           (unsigned)CONFIG_TOUCHSCREEN_LCD_PSRAM_TRANS_ALIGN,
+           (unsigned)(st.scan_bytes_per_s / 1000000), (unsigned)st.frame_us,
+           (unsigned)st.slip_us);
+
+  b.phase = 0;
+  lv_display_add_event_cb(display, displayBenchOnRender, LV_EVENT_RENDER_READY,
+                          nullptr);
+  beginDisplayBenchPhase(millis());
+  b.timer = lv_timer_create(displayBenchStep, 5, nullptr);
+}
+#endif
+
+#if CONFIG_PPINJECTORUI_PLUNGER_SMOOTHING
+// Moves the plunger once per display frame from the motion estimate, so it
+// glides between ENC samples instead of stepping at the sample rate. An
+// endless lv_anim is only used as a per-frame hook: the animated value is
+// ignored and the writes still go through the live-widget cache, so a
+// parked plunger costs nothing.
+lv_anim_t s_plungerAnim;
+
+void plungerAnimExec(void *, int32_t) {
+#if CONFIG_PPINJECTORUI_DISPLAY_BENCH
+  if (s_displayBench.timer) {
+    return;
+  }
+#endif
+  const int y = plungerYOffset(
+      DisplayComms::predictEncoderTurns(esp_timer_get_time()));
+  if (y != ui.plungerY) {
+    ui.plungerY = y;
+    refreshLiveWidgets(LIVE_PLUNGER);
+  }
+}
+
+void startPlungerAnimation() {
+  lv_anim_init(&s_plungerAnim);
+  lv_anim_set_var(&s_plungerAnim, &ui);
+  lv_anim_set_exec_cb(&s_plungerAnim, plungerAnimExec);
+  lv_anim_set_values(&s_plungerAnim, 0, 1000);
+  lv_anim_set_duration(&s_plungerAnim, 1000);
+  lv_anim_set_repeat_count(&s_plungerAnim, LV_ANIM_REPEAT_INFINITE);
+  lv_anim_start(&s_plungerAnim);
+}
+#endif
+
+// Reports how long boot took up to the first frame drawn with the PRD UI
+// in place, and how much of that went to storage and to building the UI.
+void onFirstFrameRendered(lv_event_t *) {
+  static bool reported = false;
+  if (reported)
+    return;
+  reported = true;
+  const int64_t now = esp_timer_get_time();
+  ESP_LOGI(TAG,
+           "boot: first interactive frame at %u ms (%s mount %u ms, mould "
+           "library open %u ms, PRD UI init %u ms)",
+           (unsigned)(now / 1000), PPInjectorUI_storage_backend()->name,
+           (unsigned)(Storage::s_mountUs / 1000),
+           (unsigned)(Storage::s_libraryOpenUs / 1000),
+           (unsigned)((ui.initDoneUs - ui.initStartUs) / 1000));
 }
 
 } // namespace
@@ -2650,6 +3898,13 @@ void storageSelfTest() {
 
   Storage::init();
 
+  // Replays a power cut at every byte of each mould store write on a scratch
+  // file, before touching the real profiles.
+  bool replayOk =
+      PPInjectorUI_mould_store_selftest("/spiffs/moulds_selftest.db");
+  ESP_LOGI(TAG, "Storage self-test: power-cut replay %s",
+           replayOk ? "passed" : "FAILED");
+
   for (int i = 0; i < 3; ++i) {
     DisplayComms::MouldParams &p = out[i];
     snprintf(p.name, sizeof(p.name), "TEST_%d", i + 1);
@@ -2674,11 +3929,12 @@ void storageSelfTest() {
 }
 
 void storageReadDump() {
-  DisplayComms::MouldParams in[MAX_MOULD_PROFILES] = {};
+  constexpr int kDumpMax = 16;
+  DisplayComms::MouldParams in[kDumpMax] = {};
   int inCount = 0;
 
   Storage::init();
-  Storage::loadMoulds(in, inCount, MAX_MOULD_PROFILES);
+  Storage::loadMoulds(in, inCount, kDumpMax);
   ESP_LOGI(TAG, "Storage read-dump: loaded=%d", inCount);
 }
 
@@ -2696,6 +3952,11 @@ void init() {
     return;
   }
 
+  ui.initStartUs = esp_timer_get_time();
+  lv_mem_monitor_t memBefore;
+  lv_mem_monitor(&memBefore);
+  PrdTheme::init();
+
   // Create global EOD frame overlay
   ui.globalEodFrame = lv_obj_create(lv_layer_top());
   lv_obj_set_size(ui.globalEodFrame, SCREEN_WIDTH, SCREEN_HEIGHT);
@@ -2709,8 +3970,10 @@ void init() {
 
   // Load persisted moulds
   Storage::init();
-  Storage::loadMoulds(ui.mouldProfiles, ui.mouldProfileCount,
-                      MAX_MOULD_PROFILES);
+  ui.mouldProfileCount = Storage::mouldCount();
+  if (ui.mouldProfileCount > 0 && !Storage::readMould(0, ui.currentMould)) {
+    ESP_LOGW(TAG, "Storage: current mould record unreadable");
+  }
   Storage::loadLocalSettings(ui.heatTimeMin);
 
   // Keep the plunger column static (touch drag should not scroll the screen).
@@ -2743,15 +4006,15 @@ void init() {
   createNetworkGestureUi();
   Serial.println("PRD_UI: init before uiYield after panel creation");
   uiYield();
-  Serial.println("PRD_UI: init before rebuildMouldList");
+  Serial.println("PRD_UI: init before syncMouldList");
 
   if (ui.mouldProfileCount <= 0) {
     ui.mouldProfileCount = 1;
-    strncpy(ui.mouldProfiles[0].name, "Awaiting QUERY_MOULD",
-            sizeof(ui.mouldProfiles[0].name) - 1);
-    ui.mouldProfiles[0].name[sizeof(ui.mouldProfiles[0].name) - 1] = '\0';
+    strncpy(ui.currentMould.name, "Awaiting QUERY_MOULD",
+            sizeof(ui.currentMould.name) - 1);
+    ui.currentMould.name[sizeof(ui.currentMould.name) - 1] = '\0';
   }
-  rebuildMouldList();
+  syncMouldList();
   ui.selectedMould = -1;
 
   setButtonEnabled(ui.mouldButtonSend, false);
@@ -2759,6 +4022,46 @@ void init() {
   setButtonEnabled(ui.commonButtonSend, false);
 
   ui.initialized = true;
+  ui.initDoneUs = esp_timer_get_time();
+  lv_mem_monitor_t memAfter;
+  lv_mem_monitor(&memAfter);
+  ESP_LOGI(TAG, "PrdUi widgets: %u B of LVGL heap (shared styles %u B)",
+           (unsigned)(memBefore.free_size - memAfter.free_size),
+           (unsigned)PrdTheme::heapBytes());
+  lv_display_t *display = lv_display_get_default();
+  if (display) {
+    lv_display_add_event_cb(display, onFirstFrameRendered, LV_EVENT_REFR_READY,
+                            nullptr);
+  }
+#if CONFIG_PPINJECTORUI_PLUNGER_SMOOTHING
+  startPlungerAnimation();
+#endif
+#if CONFIG_PPINJECTORUI_MOULD_LIST_BENCH
+  runMouldListBenchmark();
+#endif
+#if CONFIG_PPINJECTORUI_MOULD_INDEX_BENCH
+  PPInjectorUI_mould_index_benchmark("/spiffs/moulds_bench.idx",
+                                     CONFIG_PPINJECTORUI_MOULD_INDEX_BENCH_ROWS);
+#endif
+#if CONFIG_PPINJECTORUI_MOTION_BENCH
+  // Fixed-rate streams, then the deadband stream the ENC subscription asks
+  // for, where stops show up as silence.
+#if CONFIG_PPINJECTORUI_TELEMETRY_SUBSCRIBE
+  const uint32_t subDeadband = CONFIG_PPINJECTORUI_ENC_SUB_DEADBAND_MTURNS;
+#else
+  const uint32_t subDeadband = 2; // the subscription default
+#endif
+  for (const uint32_t deadband : {0u, subDeadband}) {
+    for (const uint32_t hz : {5u, 10u, 20u, 50u}) {
+      PPInjectorUI_motion_benchmark(
+          hz, 1000 / LV_DEF_REFR_PERIOD,
+          CONFIG_PPINJECTORUI_PLUNGER_HORIZON_MS * 1000u, deadband, nullptr);
+    }
+  }
+#endif
+#if CONFIG_PPINJECTORUI_DISPLAY_BENCH
+  runDisplayBenchmark();
+#endif
   Serial.println("PRD_UI: init complete");
 }
 
@@ -2766,26 +4069,101 @@ void tick() {
   if (!ui.initialized) {
     return;
   }
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+  const int64_t tickStartUs = esp_timer_get_time();
+#endif
+  const uint32_t writesBefore = ui.propWrites;
+  catchUpLiveScreen();
 
   const DisplayComms::Status &status = DisplayComms::getStatus();
   const DisplayComms::MouldParams &mould = DisplayComms::getMould();
   const DisplayComms::CommonParams &common = DisplayComms::getCommon();
 
-  updateRefillBlocks(status);
-  updatePlungerPosition(status.encoderTurns);
-  renderAllPlungers();
-  updateLeftReadouts(status);
-  updateStateWidgets(status);
-  updateErrorFrames(status);
-  updateMouldListFromComms(mould);
+  const uint32_t changed = DisplayComms::takeChanges(ui.commsCursor);
+  const uint32_t now = millis();
+
+  if (changed & (DisplayComms::CHANGED_POSITION |
+                 DisplayComms::CHANGED_STATE)) {
+    updateRefillBlocks(status);
+  }
+#if CONFIG_PPINJECTORUI_DISPLAY_BENCH
+  const bool drawPlungers = s_displayBench.timer == nullptr;
+#else
+  const bool drawPlungers = true;
+#endif
+  uint8_t liveDirty = 0;
+#if CONFIG_PPINJECTORUI_PLUNGER_SMOOTHING
+  // The animation follows samples; a state change snaps it to the reported
+  // position right away (the estimate restarts there too).
+  const uint32_t plungerSnap = DisplayComms::CHANGED_STATE;
+#else
+  const uint32_t plungerSnap = DisplayComms::CHANGED_POSITION;
+#endif
+  if (drawPlungers && (changed & plungerSnap)) {
+    ui.plungerY = plungerYOffset(status.encoderTurns);
+    liveDirty |= LIVE_PLUNGER;
+  }
+  // Bands move with the stack, but their heat colour and age label also
+  // advance with time; re-render them when the next of those is due.
+  if (drawPlungers &&
+      ((changed & (DisplayComms::CHANGED_POSITION |
+                   DisplayComms::CHANGED_STATE)) ||
+       (ui.blockCount > 0 &&
+        static_cast<int32_t>(now - ui.nextBandChangeMs) >= 0) ||
+       ui.blockCount != ui.lastRenderedBlockCount)) {
+    liveDirty |= LIVE_BANDS;
+    ui.nextBandChangeMs = nextRefillBandChangeMs(now);
+    ui.lastRenderedBlockCount = ui.blockCount;
+  }
+  if (changed &
+      (DisplayComms::CHANGED_POSITION | DisplayComms::CHANGED_TEMP)) {
+    liveDirty |= LIVE_READOUTS;
+  }
+  refreshLiveWidgets(liveDirty);
+  if (changed & (DisplayComms::CHANGED_STATE | DisplayComms::CHANGED_EOD)) {
+    updateStateWidgets(status);
+  }
+  if (changed & DisplayComms::CHANGED_ERROR) {
+    updateErrorFrames(status);
+  }
+  if (changed & DisplayComms::CHANGED_MOULD) {
+    updateMouldListFromComms(mould);
+  }
+  if (ui.mouldSearchPending) {
+    continueMouldSearch();
+  }
   syncMouldSendEditEnablement();
 
-  if (!ui.commonDirty) {
+  // A COMMON_OK that lands while the user is editing is applied once the
+  // edit is sent or discarded.
+  if (changed & DisplayComms::CHANGED_COMMON) {
+    ui.commonModelStale = true;
+  }
+  if (ui.commonModelStale && !ui.commonDirty) {
     syncCommonInputsFromModel(common);
+    ui.commonModelStale = false;
   }
   syncCommonSendEnablement();
+
+  PrdUi::LiveUpdateStats &live = ui.liveStats;
+  const uint32_t tickWrites = ui.propWrites - writesBefore;
+  live.ticks++;
+  live.writes += tickWrites;
+  live.lastTickWrites = tickWrites;
+  if (tickWrites > live.maxTickWrites) {
+    live.maxTickWrites = tickWrites;
+  }
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+  updateFrameHud(now);
+  TouchScreen_frame_add_tick_us(
+      static_cast<uint32_t>(esp_timer_get_time() - tickStartUs));
+#endif
 }
 
 bool isInitialized() { return ui.initialized; }
 
+const MouldListStats &mouldListStats() { return ui.mouldListStats; }
+
+const LiveUpdateStats &liveUpdateStats() { return ui.liveStats; }
+
 } // namespace PrdUi
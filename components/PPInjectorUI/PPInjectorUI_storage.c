@@ -0,0 +1,223 @@
+// BEGIN --- Standard C headers section ---
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+// END   --- Standard C headers section ---
+
+// BEGIN --- SDK config section---
+#include <sdkconfig.h>
+// END   --- SDK config section---
+
+// BEGIN --- ESP-IDF headers section ---
+#include "esp_log.h"
+#include "esp_spiffs.h"
+#if CONFIG_PPINJECTORUI_STORAGE_LITTLEFS
+#include "esp_littlefs.h"
+#endif
+// END   --- ESP-IDF headers section ---
+
+// BEGIN --- Self-includes section ---
+#include "PPInjectorUI_storage.h"
+// END --- Self-includes section ---
+
+static const char *TAG = "PPInjectorUI_sto";
+
+// Backend on the partition after PPInjectorUI_storage_mount(); only differs
+// from the Kconfig pick when a SPIFFS partition could not be converted.
+static const PPInjectorUI_storage_backend_t *s_mounted = NULL;
+
+// ------------------ BEGIN SPIFFS backend ------------------
+static esp_err_t spiffs_mount(const char *base_path, const char *partition_label, bool format_if_mount_failed) {
+  const esp_vfs_spiffs_conf_t conf = {
+      .base_path = base_path,
+      .partition_label = partition_label,
+      .max_files = 8,
+      .format_if_mount_failed = format_if_mount_failed,
+  };
+  return esp_vfs_spiffs_register(&conf);
+}
+
+static esp_err_t spiffs_unmount(const char *partition_label) { return esp_vfs_spiffs_unregister(partition_label); }
+
+static esp_err_t spiffs_info(const char *partition_label, size_t *total, size_t *used) {
+  return esp_spiffs_info(partition_label, total, used);
+}
+
+const PPInjectorUI_storage_backend_t PPInjectorUI_storage_spiffs = {
+    .name = "SPIFFS",
+    .mount = spiffs_mount,
+    .unmount = spiffs_unmount,
+    .info = spiffs_info,
+};
+// ------------------ END   SPIFFS backend ------------------
+
+// ------------------ BEGIN LittleFS backend ------------------
+#if CONFIG_PPINJECTORUI_STORAGE_LITTLEFS
+static esp_err_t littlefs_mount(const char *base_path, const char *partition_label, bool format_if_mount_failed) {
+  const esp_vfs_littlefs_conf_t conf = {
+      .base_path = base_path,
+      .partition_label = partition_label,
+      .format_if_mount_failed = format_if_mount_failed,
+  };
+  return esp_vfs_littlefs_register(&conf);
+}
+
+static esp_err_t littlefs_unmount(const char *partition_label) { return esp_vfs_littlefs_unregister(partition_label); }
+
+static esp_err_t littlefs_info(const char *partition_label, size_t *total, size_t *used) {
+  return esp_littlefs_info(partition_label, total, used);
+}
+
+const PPInjectorUI_storage_backend_t PPInjectorUI_storage_littlefs = {
+    .name = "LittleFS",
+    .mount = littlefs_mount,
+    .unmount = littlefs_unmount,
+    .info = littlefs_info,
+};
+
+// SPIFFS is flat and the UI only keeps a handful of small files there, so
+// they fit in RAM while the partition is reformatted. A power cut inside
+// that window loses them, which is no worse than the plain
+// format_if_mount_failed it replaces. The format only happens once every
+// file is in RAM: anything that cannot be carried keeps the partition on
+// SPIFFS, and the conversion is retried on the next boot.
+#define CARRY_MAX_FILES 8
+
+typedef struct {
+  char name[64];
+  uint8_t *data;
+  size_t len;
+} carried_file_t;
+
+static void carry_free(carried_file_t *files, int n) {
+  for (int i = 0; i < n; ++i) {
+    free(files[i].data);
+  }
+}
+
+// Reads every regular file under `base_path` into `files`. False if any of
+// them could not be read (too many, name too long, out of memory, I/O).
+static bool carry_read(const char *base_path, carried_file_t *files, int *count) {
+  *count = 0;
+  DIR *dir = opendir(base_path);
+  if (!dir) {
+    ESP_LOGE(TAG, "cannot list %s", base_path);
+    return false;
+  }
+  bool ok = true;
+  int n = 0;
+  char path[128];
+  struct dirent *e;
+  while (ok && (e = readdir(dir)) != NULL) {
+    if (strlen(e->d_name) >= sizeof(files[0].name)) {
+      ESP_LOGE(TAG, "cannot carry over %s/%s (name too long)", base_path, e->d_name);
+      ok = false;
+      break;
+    }
+    struct stat st;
+    snprintf(path, sizeof(path), "%s/%.63s", base_path, e->d_name);
+    if (stat(path, &st) != 0) {
+      ESP_LOGE(TAG, "cannot stat %s", path);
+      ok = false;
+      break;
+    }
+    if (!S_ISREG(st.st_mode)) {
+      continue;
+    }
+    if (n == CARRY_MAX_FILES) {
+      ESP_LOGE(TAG, "cannot carry over %s (more than %d files)", path, CARRY_MAX_FILES);
+      ok = false;
+      break;
+    }
+    FILE *f = fopen(path, "rb");
+    uint8_t *data = f ? malloc(st.st_size ? (size_t)st.st_size : 1) : NULL;
+    if (data && fread(data, 1, (size_t)st.st_size, f) == (size_t)st.st_size) {
+      strcpy(files[n].name, e->d_name);
+      files[n].data = data;
+      files[n].len = (size_t)st.st_size;
+      n++;
+    } else {
+      ESP_LOGE(TAG, "cannot carry over %s (%u bytes): %s", path, (unsigned)st.st_size,
+               f ? (data ? "read failed" : "out of memory") : "open failed");
+      free(data);
+      ok = false;
+    }
+    if (f) {
+      fclose(f);
+    }
+  }
+  closedir(dir);
+  *count = n;
+  return ok;
+}
+
+static void carry_write(const char *base_path, carried_file_t *files, int n) {
+  char path[128];
+  for (int i = 0; i < n; ++i) {
+    snprintf(path, sizeof(path), "%s/%s", base_path, files[i].name);
+    FILE *f = fopen(path, "wb");
+    bool ok = f && fwrite(files[i].data, 1, files[i].len, f) == files[i].len;
+    if (f) {
+      ok = (fclose(f) == 0) && ok;
+    }
+    if (ok) {
+      ESP_LOGI(TAG, "carried %s (%u bytes)", files[i].name, (unsigned)files[i].len);
+    } else {
+      ESP_LOGE(TAG, "carrying %s (%u bytes) FAILED", files[i].name, (unsigned)files[i].len);
+    }
+  }
+  carry_free(files, n);
+}
+
+static esp_err_t littlefs_mount_migrating(const char *base_path, const char *partition_label) {
+  esp_err_t err = littlefs_mount(base_path, partition_label, false);
+  if (err == ESP_OK) {
+    return ESP_OK;
+  }
+
+  carried_file_t files[CARRY_MAX_FILES];
+  int n = 0;
+  if (spiffs_mount(base_path, partition_label, false) == ESP_OK) {
+    if (!carry_read(base_path, files, &n)) {
+      // Formatting now would drop what could not be read: stay on SPIFFS.
+      carry_free(files, n);
+      ESP_LOGE(TAG, "not converting %s to LittleFS: staying on SPIFFS", partition_label);
+      s_mounted = &PPInjectorUI_storage_spiffs;
+      return ESP_OK;
+    }
+    spiffs_unmount(partition_label);
+    ESP_LOGW(TAG, "converting %s from SPIFFS to LittleFS (%d files)", partition_label, n);
+  }
+  err = littlefs_mount(base_path, partition_label, true);
+  if (err != ESP_OK) {
+    carry_free(files, n);
+    return err;
+  }
+  carry_write(base_path, files, n);
+  return ESP_OK;
+}
+#endif
+// ------------------ END   LittleFS backend ------------------
+
+const PPInjectorUI_storage_backend_t *PPInjectorUI_storage_backend(void) {
+  if (s_mounted) {
+    return s_mounted;
+  }
+#if CONFIG_PPINJECTORUI_STORAGE_LITTLEFS
+  return &PPInjectorUI_storage_littlefs;
+#else
+  return &PPInjectorUI_storage_spiffs;
+#endif
+}
+
+esp_err_t PPInjectorUI_storage_mount(const char *base_path, const char *partition_label) {
+  s_mounted = NULL;
+#if CONFIG_PPINJECTORUI_STORAGE_LITTLEFS
+  return littlefs_mount_migrating(base_path, partition_label);
+#else
+  return spiffs_mount(base_path, partition_label, true);
+#endif
+}
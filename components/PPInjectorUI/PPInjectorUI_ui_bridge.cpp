@@ -12,6 +12,9 @@ extern "C" void PPInjectorUI_ui_init_bridge(void)
 {
     ui_init();
     DisplayComms::init();
+#if CONFIG_PPINJECTORUI_PARSER_BENCH
+    DisplayComms::runParserBenchmark(CONFIG_PPINJECTORUI_PARSER_BENCH_LINES);
+#endif
 
     plunger_stateValue plunger_state(eez::flow::getGlobalVariable(FLOW_GLOBAL_VARIABLE_PLUNGER_STATE));
     if (plunger_state) {
@@ -43,6 +46,16 @@ extern "C" void PPInjectorUI_comms_set_tx_callback_bridge(void (*cb)(const char
     DisplayComms::setTxCallback(cb, ctx);
 }
 
+extern "C" void PPInjectorUI_comms_inject_frame_bridge(const uint8_t *frame, size_t len)
+{
+    DisplayComms::injectRxFrame(frame, len);
+}
+
+extern "C" void PPInjectorUI_comms_set_tx_bytes_callback_bridge(void (*cb)(const uint8_t *, size_t, void *), void *ctx)
+{
+    DisplayComms::setTxBytesCallback(cb, ctx);
+}
+
 extern "C" void PPInjectorUI_storage_selftest_bridge(void)
 {
     PrdUi::storageSelfTest();
@@ -0,0 +1,6 @@
+// Host build: the benchmarks and self-tests are compiled in, nothing else is
+// configured.
+#pragma once
+#define CONFIG_PPINJECTORUI_MOTION_BENCH 1
+#define CONFIG_PPINJECTORUI_STORAGE_SELFTEST 1
+#define CONFIG_PPINJECTORUI_MOULD_INDEX_BENCH 1
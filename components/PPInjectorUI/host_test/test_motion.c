@@ -0,0 +1,71 @@
+// Host test for the plunger motion estimate: replays the benchmark cycle
+// and checks the prediction error, including at stops of a deadband stream.
+
+#include <math.h>
+#include <stdio.h>
+
+#include "PPInjectorUI_motion.h"
+
+static int s_failures;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                   \
+      s_failures++;                                                            \
+    }                                                                          \
+  } while (0)
+
+// Constant velocity, then a stop reported the way the subscription does it:
+// nothing until the next keyframe a second later.
+static void test_stop_without_samples(void) {
+  PPInjectorUI_motion_t m;
+  PPInjectorUI_motion_init(&m, PPINJECTORUI_MOTION_ALPHA,
+                           PPINJECTORUI_MOTION_BETA, 250000,
+                           PPINJECTORUI_MOTION_SILENCE_US(60));
+  int64_t t_us = 0;
+  float x = 0.0f;
+  for (int i = 0; i < 60; ++i, t_us += 16667) {
+    x = (float)t_us * 1e-6f * 10.0f; // 10 turns/s
+    PPInjectorUI_motion_update(&m, x, t_us);
+  }
+  const int64_t stop_us = t_us - 16667;
+  float overshoot = 0.0f;
+  for (int64_t t = stop_us; t < stop_us + 1000000; t += 16667) {
+    overshoot = fmaxf(overshoot, PPInjectorUI_motion_predict(&m, t) - x);
+  }
+  // Before the fix: v * horizon = 2.5 turns.
+  CHECK(overshoot < 0.4f);
+
+  PPInjectorUI_motion_update(&m, x, stop_us + 1000000); // keyframe
+  CHECK(fabsf(m.turns_per_s) < 0.05f);
+  float bounce = 0.0f;
+  for (int64_t t = stop_us + 1000000; t < stop_us + 2000000; t += 16667) {
+    bounce = fmaxf(bounce, fabsf(PPInjectorUI_motion_predict(&m, t) - x));
+  }
+  CHECK(bounce < 0.01f);
+}
+
+static void test_replay(uint32_t sample_hz, uint32_t deadband_mturns,
+                        float pred_rms_max, float hold_max) {
+  PPInjectorUI_motion_bench_t r;
+  PPInjectorUI_motion_benchmark(sample_hz, 60, 250000, deadband_mturns, &r);
+  CHECK(r.pred_rms < r.last_rms);
+  CHECK(r.pred_rms < pred_rms_max);
+  CHECK(r.hold_max < hold_max);
+}
+
+int main(void) {
+  test_stop_without_samples();
+  // Fixed-rate streams: stops show up as repeated positions.
+  test_replay(10, 0, 0.20f, 0.05f);
+  test_replay(20, 0, 0.05f, 0.01f);
+  test_replay(50, 0, 0.01f, 0.01f);
+  // The ENC subscription: 2 mturn deadband, keyframe every second. Before
+  // the silence rule the at-rest errors were 1.05, 0.54 and 0.15 turns.
+  test_replay(10, 2, 0.20f, 0.30f);
+  test_replay(20, 2, 0.05f, 0.05f);
+  test_replay(60, 2, 0.01f, 0.01f);
+  printf("%s\n", s_failures ? "FAILED" : "OK");
+  return s_failures ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+// Host test for the mould name index: prefix and substring search, the
+// removal shift, then the benchmark over a synthetic library.
+
+#include <stdio.h>
+
+#include "PPInjectorUI_mould_index.h"
+
+#define INDEX_PATH "test_mould_index.idx"
+#define BENCH_PATH "test_mould_index_bench.idx"
+
+static int s_failures;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                   \
+      s_failures++;                                                            \
+    }                                                                          \
+  } while (0)
+
+static const char *const kNames[] = {"Bottle Cap", "Lid", "Gear 12",
+                                     "cap small", "Hook"};
+#define NAME_COUNT (sizeof(kNames) / sizeof(kNames[0]))
+
+// Runs `query` over the whole index, confirms each candidate against
+// `names` (the store's rows) and returns the matches.
+static int search(PPInjectorUI_mould_index_t *idx, const char *const *names,
+                  const char *query, uint32_t *rows, int cap) {
+  PPInjectorUI_mould_search_t s;
+  uint32_t found[NAME_COUNT];
+  int matches = 0;
+  PPInjectorUI_mould_search_begin(&s, query);
+  while (s.next < idx->count) {
+    const int n = PPInjectorUI_mould_search_step(idx, &s, 2, found,
+                                                 (int)NAME_COUNT);
+    if (n < 0) {
+      return -1;
+    }
+    for (int i = 0; i < n; ++i) {
+      if (PPInjectorUI_mould_name_matches(names[found[i]], &s) &&
+          matches < cap) {
+        rows[matches++] = found[i];
+      }
+    }
+  }
+  return matches;
+}
+
+static void test_search(void) {
+  PPInjectorUI_mould_index_t idx;
+  uint32_t rows[NAME_COUNT];
+  remove(INDEX_PATH);
+  PPInjectorUI_mould_index_open(&idx, INDEX_PATH, 0);
+  for (uint32_t i = 0; i < NAME_COUNT; ++i) {
+    CHECK(PPInjectorUI_mould_index_set(&idx, i, kNames[i]));
+  }
+  CHECK(PPInjectorUI_mould_index_end_update(&idx));
+  PPInjectorUI_mould_index_close(&idx);
+
+  // A clean index with the expected count is reused, not rebuilt.
+  CHECK(PPInjectorUI_mould_index_open(&idx, INDEX_PATH, NAME_COUNT));
+  CHECK(idx.count == NAME_COUNT);
+  CHECK(PPInjectorUI_mould_index_same(&idx, 2, "GEAR 12"));
+  CHECK(!PPInjectorUI_mould_index_same(&idx, 2, "Gear 13"));
+
+  CHECK(search(&idx, kNames, "ca", rows, NAME_COUNT) == 1 && rows[0] == 3);
+  CHECK(search(&idx, kNames, "cap", rows, NAME_COUNT) == 2 && rows[0] == 0 &&
+        rows[1] == 3);
+  CHECK(search(&idx, kNames, "gear 1", rows, NAME_COUNT) == 1 && rows[0] == 2);
+  CHECK(search(&idx, kNames, "x", rows, NAME_COUNT) == 0);
+
+  CHECK(PPInjectorUI_mould_index_remove(&idx, 0));
+  CHECK(PPInjectorUI_mould_index_end_update(&idx));
+  CHECK(idx.count == NAME_COUNT - 1);
+  CHECK(search(&idx, kNames + 1, "cap", rows, NAME_COUNT) == 1 &&
+        rows[0] == 2);
+
+  // An update left open marks the index dirty, so reopening rebuilds it.
+  CHECK(PPInjectorUI_mould_index_begin_update(&idx));
+  PPInjectorUI_mould_index_close(&idx);
+  CHECK(!PPInjectorUI_mould_index_open(&idx, INDEX_PATH, NAME_COUNT - 1));
+  PPInjectorUI_mould_index_close(&idx);
+  remove(INDEX_PATH);
+}
+
+int main(void) {
+  test_search();
+  PPInjectorUI_mould_index_benchmark(BENCH_PATH, 5000);
+  printf("%s\n", s_failures ? "FAILED" : "OK");
+  return s_failures ? 1 : 0;
+}
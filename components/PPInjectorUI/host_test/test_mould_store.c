@@ -0,0 +1,97 @@
+// Host test for the mould store: the slot round trip, the boot open from
+// the index summary against the full scan, then the power-cut self-test,
+// which cuts every write after each byte count and reopens.
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "esp_timer.h"
+#include "PPInjectorUI_mould_store.h"
+
+#define STORE_PATH "test_mould_store.db"
+
+static int s_failures;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                   \
+      s_failures++;                                                            \
+    }                                                                          \
+  } while (0)
+
+static void test_round_trip(void) {
+  PPInjectorUI_mould_store_t s;
+  PPInjectorUI_mould_record_t rec = {0};
+  PPInjectorUI_mould_record_t got;
+  remove(STORE_PATH);
+  CHECK(PPInjectorUI_mould_store_open(&s, STORE_PATH));
+  memset(rec.data, 7, sizeof(rec.data));
+  CHECK(PPInjectorUI_mould_store_put(&s, 0, &rec) == 1);
+  CHECK(rec.id != 0);
+  CHECK(PPInjectorUI_mould_store_put(&s, 0, &rec) == 0); // unchanged
+  rec.data[3] = 9;
+  CHECK(PPInjectorUI_mould_store_put(&s, 0, &rec) == 1);
+  PPInjectorUI_mould_record_t other = {0};
+  CHECK(PPInjectorUI_mould_store_put(&s, 1, &other) == 1); // append
+  CHECK(other.id != rec.id);
+
+  PPInjectorUI_mould_store_t reopened;
+  CHECK(PPInjectorUI_mould_store_open(&reopened, STORE_PATH));
+  CHECK(reopened.slots == 2);
+  CHECK(PPInjectorUI_mould_store_get(&reopened, 0, &got) == 1);
+  CHECK(got.id == rec.id && got.data[3] == 9);
+  CHECK(PPInjectorUI_mould_store_erase(&reopened, 0) == 1);
+  CHECK(PPInjectorUI_mould_store_get(&reopened, 0, &got) == 0);
+  remove(STORE_PATH);
+}
+
+// The library open at boot, before (scan every slot) and after (trust the
+// summary in the index header). Flash is not modelled: the bytes read are
+// what differs on target, the host times only show the CPU side.
+static void test_summary_open(uint32_t records) {
+  PPInjectorUI_mould_store_t s;
+  PPInjectorUI_mould_record_t rec = {0};
+  remove(STORE_PATH);
+  CHECK(PPInjectorUI_mould_store_open(&s, STORE_PATH));
+  for (uint32_t i = 0; i < records; ++i) {
+    rec.id = 0;
+    memset(rec.data, (int)(i & 0xFF), sizeof(rec.data));
+    CHECK(PPInjectorUI_mould_store_put(&s, i, &rec) == 1);
+  }
+  const uint32_t next_id = s.next_id;
+  struct stat st;
+  CHECK(stat(STORE_PATH, &st) == 0);
+
+  int64_t t0 = esp_timer_get_time();
+  CHECK(PPInjectorUI_mould_store_open(&s, STORE_PATH));
+  const int64_t scan_us = esp_timer_get_time() - t0;
+  CHECK(s.stats.scans == 1 && s.slots == records && s.next_id == next_id);
+
+  t0 = esp_timer_get_time();
+  CHECK(PPInjectorUI_mould_store_open_summary(&s, STORE_PATH, records,
+                                              next_id));
+  const int64_t summary_us = esp_timer_get_time() - t0;
+  CHECK(s.stats.scans == 0 && s.slots == records && s.next_id == next_id);
+  printf("open %lu records: full scan reads %ld bytes in %ld us, summary "
+         "reads %d bytes in %ld us\n",
+         (unsigned long)records, (long)st.st_size, (long)scan_us,
+         PPINJECTORUI_MOULD_STORE_HEADER_SIZE, (long)summary_us);
+
+  // A summary that disagrees with the file is not trusted.
+  CHECK(PPInjectorUI_mould_store_open_summary(&s, STORE_PATH, records - 1,
+                                              next_id));
+  CHECK(s.stats.scans == 1 && s.slots == records);
+  remove(STORE_PATH);
+}
+
+int main(void) {
+  test_round_trip();
+  test_summary_open(100);
+  test_summary_open(1000);
+  CHECK(PPInjectorUI_mould_store_selftest(STORE_PATH));
+  remove(STORE_PATH);
+  printf("%s\n", s_failures ? "FAILED" : "OK");
+  return s_failures ? 1 : 0;
+}
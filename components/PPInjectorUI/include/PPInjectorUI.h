@@ -5,6 +5,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include <PrjCfg.h>
@@ -83,6 +84,7 @@ PPInjectorUI_return_code_t PPInjectorUI_spin(void);
 // ------------------ BEGIN Public API (COMMON)--------------------
 
 typedef void (*PPInjectorUI_machine_tx_cb_t)(const char *line, void *ctx);
+typedef void (*PPInjectorUI_machine_tx_bytes_cb_t)(const uint8_t *data, size_t len, void *ctx);
 
 /**
  *  Execute a function wrapped with locks so you can access the DRE variables in thread-safe mode
@@ -110,6 +112,36 @@ void PPInjectorUI_feed_machine_line(const char *line);
  */
 void PPInjectorUI_set_machine_tx_callback(PPInjectorUI_machine_tx_cb_t cb, void *ctx);
 
+/**
+ * Feed one binary protocol frame (COBS block without the 0x00 delimiter)
+ * into the PPInjectorUI parser (RX path). See PPInjectorUI_binproto.h.
+ */
+void PPInjectorUI_feed_machine_frame(const uint8_t *frame, size_t len);
+
+/**
+ * Register callback for outbound raw bytes (binary frames, TX path). The
+ * binary protocol is only negotiated when this callback is set.
+ */
+void PPInjectorUI_set_machine_tx_bytes_callback(PPInjectorUI_machine_tx_bytes_cb_t cb, void *ctx);
+
+#if CONFIG_PPINJECTORUI_UART_RX_TASK
+typedef struct {
+    uint32_t lines;       // lines queued for the UI
+    uint32_t frames;      // binary frames queued for the UI
+    uint32_t overruns;    // FIFO/driver buffer/pattern queue overflows (data lost)
+    uint32_t dropped;     // complete lines dropped because the line queue was full
+    uint32_t oversize;    // lines longer than the line buffer, discarded
+    uint32_t short_reads; // lines the driver returned incompletely, discarded
+    uint32_t max_depth;   // line queue high-water mark
+    uint32_t depth;       // lines currently waiting
+} PPInjectorUI_uart_rx_stats_t;
+
+/**
+ * Snapshot of the UART RX task counters.
+ */
+void PPInjectorUI_get_uart_rx_stats(PPInjectorUI_uart_rx_stats_t *dst);
+#endif
+
 void PPInjectorUI_request_system_action(PPInjectorUI_system_action_t action);
 PPInjectorUI_system_action_t PPInjectorUI_take_system_action(void);
 void PPInjectorUI_set_wifi_credentials_available(bool available);
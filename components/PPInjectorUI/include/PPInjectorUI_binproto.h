@@ -0,0 +1,162 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ------------------ BEGIN Negotiation ------------------
+// Binary framing is opt-in. The HMI sends PPINJECTORUI_PROTO_REQ as a text
+// line; a controller that supports it answers PPINJECTORUI_PROTO_ACK and both
+// sides switch to framed packets right after that line's '\n'. Any other
+// answer (or none) keeps the text protocol.
+#define PPINJECTORUI_PROTO_REQ "PROTO|BIN|1"
+#define PPINJECTORUI_PROTO_ACK "PROTO_OK|BIN|1"
+// ------------------ END   Negotiation ------------------
+
+// ------------------ BEGIN Framing ------------------
+// Wire frame: COBS(type | payload | crc16_le(type | payload)) 0x00
+// CRC is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF). Multi-byte payload
+// fields are little-endian; floats are IEEE-754 binary32.
+#define PPINJECTORUI_BINPROTO_MAX_PAYLOAD 128
+#define PPINJECTORUI_BINPROTO_MAX_FRAME                                       \
+    (PPINJECTORUI_BINPROTO_MAX_PAYLOAD + 3 +                                  \
+     (PPINJECTORUI_BINPROTO_MAX_PAYLOAD + 3) / 254 + 2)
+
+typedef enum {
+    // HMI -> controller
+    PPINJECTORUI_MSG_QUERY_MOULD  = 0x01,
+    PPINJECTORUI_MSG_QUERY_COMMON = 0x02,
+    PPINJECTORUI_MSG_QUERY_STATE  = 0x03,
+    PPINJECTORUI_MSG_QUERY_ERROR  = 0x04,
+    PPINJECTORUI_MSG_CMD_GOTO     = 0x05, // payload: state name (no NUL)
+    PPINJECTORUI_MSG_CMD_TOGGLE   = 0x06, // payload: feature name (no NUL)
+    PPINJECTORUI_MSG_MOULD        = 0x07, // payload: mould record
+    PPINJECTORUI_MSG_COMMON       = 0x08, // payload: common record
+    PPINJECTORUI_MSG_SUB          = 0x09, // u8 channel, u16 rate_hz, f32 deadband
+
+    // Either direction: one text protocol line (no '\n'), for anything that
+    // has no binary encoding (MOCK, ...).
+    PPINJECTORUI_MSG_TEXT         = 0x7F,
+
+    // controller -> HMI
+    PPINJECTORUI_MSG_ENC          = 0x81, // f32 turns [, u8 delta sequence]
+    PPINJECTORUI_MSG_TEMP         = 0x82, // f32 degC
+    PPINJECTORUI_MSG_STATE        = 0x83, // state name (no NUL)
+    PPINJECTORUI_MSG_EOD          = 0x84, // u8 flag
+    PPINJECTORUI_MSG_ERROR        = 0x85, // u16 code, message (no NUL)
+    PPINJECTORUI_MSG_MOULD_OK     = 0x86, // mould record
+    PPINJECTORUI_MSG_COMMON_OK    = 0x87, // common record
+    PPINJECTORUI_MSG_STATUS       = 0x88, // status record
+    PPINJECTORUI_MSG_ENC_DELTA    = 0x89, // u8 sequence, i16 delta (1/1000 turn)
+} PPInjectorUI_msg_type_t;
+
+// Telemetry channels for PPINJECTORUI_MSG_SUB / "SUB|<channel>|..."
+typedef enum {
+    PPINJECTORUI_SUB_ENC  = 0,
+    PPINJECTORUI_SUB_TEMP = 1,
+} PPInjectorUI_sub_channel_t;
+
+// Record sizes on the wire.
+// mould : name[32] (NUL padded), 11 x f32 (fillVolume .. packDecel in
+//         MouldParams order), mode[2], f32 injectTorque
+// common: f32, f32, u32, u32, 8 x f32, u32, u32 (CommonParams order)
+// status: f32 turns, f32 tempC, u16 errorCode, u8 flags (bit0 = EOD),
+//         state[24] (NUL padded)
+#define PPINJECTORUI_BINPROTO_MOULD_SIZE  82
+#define PPINJECTORUI_BINPROTO_COMMON_SIZE 56
+#define PPINJECTORUI_BINPROTO_STATUS_SIZE 35
+// ------------------ END   Framing ------------------
+
+uint16_t PPInjectorUI_crc16(const uint8_t *data, size_t len);
+
+/**
+ * COBS-encode `len` bytes. Returns the encoded length (no delimiter) or 0 if
+ * `dst` is too small.
+ */
+size_t PPInjectorUI_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_len);
+
+/**
+ * Decode one COBS block (without the 0x00 delimiter). Returns the decoded
+ * length or 0 on malformed input / overflow.
+ */
+size_t PPInjectorUI_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_len);
+
+/**
+ * Build a complete wire frame, including the trailing 0x00.
+ * Returns its length or 0 if it does not fit.
+ */
+size_t PPInjectorUI_binproto_encode(uint8_t type, const uint8_t *payload, size_t payload_len,
+                                    uint8_t *out, size_t out_len);
+
+/**
+ * Decode and CRC-check one received frame (delimiter stripped). On success
+ * stores the message type and returns the payload length; returns -1 on a
+ * framing or CRC error.
+ */
+int PPInjectorUI_binproto_decode(const uint8_t *frame, size_t len, uint8_t *type,
+                                 uint8_t *payload, size_t payload_len);
+
+// Little-endian field helpers for payload packing.
+static inline void PPInjectorUI_put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void PPInjectorUI_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint16_t PPInjectorUI_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static inline uint32_t PPInjectorUI_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+void PPInjectorUI_put_f32(uint8_t *p, float v);
+float PPInjectorUI_get_f32(const uint8_t *p);
+
+// ------------------ BEGIN Link framer ------------------
+// Splits a raw RX byte stream into text lines ('\n' / '\r') and, once the
+// PPINJECTORUI_PROTO_ACK line has been seen, into 0x00-delimited frames. If
+// no delimiter shows up within PPINJECTORUI_BINPROTO_MAX_FRAME bytes the peer
+// is assumed to be talking text again and the framer reverts to lines.
+#define PPINJECTORUI_LINK_LINE_MAX 256
+
+typedef struct {
+    void (*on_line)(const char *line, void *ctx);
+    void (*on_frame)(const uint8_t *frame, size_t len, void *ctx);
+    void (*on_mode)(bool binary, void *ctx); // optional
+    void *ctx;
+} PPInjectorUI_link_sink_t;
+
+typedef struct {
+    uint8_t buf[PPINJECTORUI_LINK_LINE_MAX];
+    size_t len;
+    bool allow_binary;
+    bool binary;
+    uint32_t overflows; // partial lines/frames dropped for lack of space
+} PPInjectorUI_link_framer_t;
+
+void PPInjectorUI_link_framer_init(PPInjectorUI_link_framer_t *f, bool allow_binary);
+void PPInjectorUI_link_framer_set_binary(PPInjectorUI_link_framer_t *f, bool binary);
+void PPInjectorUI_link_framer_push(PPInjectorUI_link_framer_t *f, const uint8_t *data, size_t len,
+                                   const PPInjectorUI_link_sink_t *sink);
+// ------------------ END   Link framer ------------------
+
+#ifdef __cplusplus
+}
+#endif
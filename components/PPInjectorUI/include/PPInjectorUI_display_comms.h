@@ -9,8 +9,11 @@ extern "C" {
 #ifdef __cplusplus
 }
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include "PPInjectorUI_motion.h"
+
 namespace DisplayComms {
 
 struct MouldParams {
@@ -47,23 +50,108 @@ struct CommonParams {
   uint32_t contactorLimit;
 };
 
+// Controller machine states known to the UI. The state string is mapped
+// once when it arrives (see machineStateInfo()); consumers switch on the id
+// and test the flags instead of comparing strings. Adding a controller state
+// is one row in the table in PPInjectorUI_display_comms.cpp.
+enum class MachineState : uint8_t {
+  Unknown = 0, // empty or not in the table; state[] still has the text
+  Home,
+  InitHeating,
+  InitHotWait,
+  InitHomedEncoderZeroed,
+  Refill,
+  Compression,
+  ReadyToInject,
+  Inject,
+  HoldInjection,
+  PurgeZero,
+  Antidrip,
+  Release,
+  ConfirmRemoval,
+  ConfirmMouldRemoval,
+  Count
+};
+
+enum MachineStateFlag : uint16_t {
+  STATE_SAFE_FOR_UPDATE = 1u << 0, // mould/common parameters may be sent
+  STATE_CONSUMES_VOLUME = 1u << 1, // plunger moving down uses refill blocks
+  STATE_SUCTION = 1u << 2,         // plunger moving up lifts the block stack
+  STATE_RESETS_REFILL = 1u << 3,   // drops refill tracking and stack lift
+  STATE_ABORT_BUTTON = 1u << 4,    // second state button: abort to refill
+  STATE_EOD_BUTTON = 1u << 5,      // end-of-day toggle button
+};
+
+// What the primary state button does in a state.
+enum class StateAction : uint8_t {
+  None = 0,
+  GotoCompression,
+  GotoRefill,
+  GotoPurge,
+  GotoReady,
+  GotoHome,
+};
+
+struct MachineStateInfo {
+  const char *name;  // as sent by the controller
+  uint16_t flags;    // MachineStateFlag
+  uint8_t buttonRow; // 1..3, row of the state buttons
+  StateAction action;
+};
+
 struct Status {
   float encoderTurns;
   float tempC;
   char state[24];
+  MachineState stateId; // state[] mapped through the state table
   uint16_t errorCode;
   char errorMsg[64];
   bool endOfDayFlag;
 };
 
+// Per-field change tracking. parseMessage() bumps the generation of every
+// field it actually modifies; each consumer keeps its own cursor and asks
+// takeChanges() which fields moved since it last looked.
+enum ChangeField : uint32_t {
+  CHANGED_POSITION = 1u << 0,
+  CHANGED_TEMP = 1u << 1,
+  CHANGED_STATE = 1u << 2,
+  CHANGED_ERROR = 1u << 3,
+  CHANGED_EOD = 1u << 4,
+  CHANGED_MOULD = 1u << 5,
+  CHANGED_COMMON = 1u << 6,
+  CHANGED_ALL = (1u << 7) - 1,
+};
+
+// RX parser throughput; (lines + frames) / (busyUs / 1e6) gives messages
+// per second of parser CPU time.
+struct ParseStats {
+  uint32_t lines;
+  uint32_t unknown;
+  uint64_t busyUs;
+  uint32_t frames;    // binary frames decoded
+  uint32_t badFrames; // COBS/CRC/length errors
+  uint32_t fallbacks; // binary mode dropped because the peer sent text
+  uint32_t encDeltas;       // ENCD samples applied
+  uint32_t encDeltaDropped; // ENCD samples without a valid base (seq gap)
+};
+
 typedef void (*tx_callback_t)(const char *line, void *ctx);
+typedef void (*tx_bytes_callback_t)(const uint8_t *data, size_t len,
+                                    void *ctx);
 
 void init(void);
 void update(void);
 void injectRxLine(const char *line);
+// One binary frame as received: COBS block without the 0x00 delimiter.
+void injectRxFrame(const uint8_t *frame, size_t len);
 void applyUiUpdates(void);
 
 void setTxCallback(tx_callback_t cb, void *ctx);
+// Raw byte sink for binary frames. Binary mode is only requested (and only
+// used for TX) when this is set; otherwise everything goes out as text.
+void setTxBytesCallback(tx_bytes_callback_t cb, void *ctx);
+bool binaryActive(void);
 
 void sendQueryMould(void);
 void sendQueryCommon(void);
@@ -74,11 +162,48 @@ void sendCmdToggle(const char *feature);
 bool sendMould(const MouldParams &params);
 bool sendCommon(const CommonParams &params);
 
+// Telemetry subscription: the controller decimates the channel to at most
+// `rateHz` updates per second and skips samples that moved less than
+// `deadband` (turns / degC) since the last one sent. ENC is then streamed as
+// ENCD deltas against sequence-numbered ENC keyframes.
+enum class SubChannel : uint8_t { Enc = 0, Temp = 1 };
+void sendSubscribe(SubChannel channel, uint16_t rateHz, float deadband);
+
+// Fixed little-endian mould record (PPINJECTORUI_BINPROTO_MOULD_SIZE bytes).
+// Used on the wire and by the on-flash mould store, so neither depends on the
+// in-memory MouldParams layout.
+size_t packMouldRecord(const MouldParams &params, uint8_t *out);
+void unpackMouldRecord(const uint8_t *in, MouldParams &params);
+
 const Status &getStatus(void);
 const MouldParams &getMould(void);
 const CommonParams &getCommon(void);
 bool isSafeForUpdate(void);
 
+// Table row for `state`; Unknown (and anything out of range) gets a row
+// with no flags, button row 2 and no action.
+const MachineStateInfo &machineStateInfo(MachineState state);
+// Case-insensitive lookup of a controller state name; Unknown if absent.
+MachineState parseMachineState(const char *name, size_t len);
+
+// Returns the CHANGED_* mask of fields updated since `cursor` and advances
+// it. A zero-initialised cursor sees every field once after init().
+uint32_t takeChanges(uint32_t &cursor);
+
+const ParseStats &getParseStats(void);
+
+// Replays a fixed ENC/ENCD/TEMP stream of about `lines` lines through the
+// text parser and the pre-switch one, and logs lines/s for each
+// (CONFIG_PPINJECTORUI_PARSER_BENCH only). Decoder state is restored after.
+void runParserBenchmark(uint32_t lines);
+
+// Plunger position at `nowUs` (esp_timer time) from the motion estimate of
+// the ENC stream; the MOCK position while one is set. Unlike
+// getStatus().encoderTurns it moves between samples.
+float predictEncoderTurns(int64_t nowUs);
+// Filter state and prediction error stats.
+const PPInjectorUI_motion_t &motionEstimate(void);
+
 } // namespace DisplayComms
 
 #endif
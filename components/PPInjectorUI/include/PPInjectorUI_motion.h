@@ -0,0 +1,104 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ------------------ BEGIN Estimator ------------------
+// Alpha-beta tracker for the plunger position. Each ENC sample corrects
+// the predicted position by `alpha` and the velocity by `beta` times the
+// residual, with the real time between samples as step, so an irregular or
+// decimated stream still gives a usable velocity. The residual (where the
+// sample landed against where the filter expected it) is the prediction
+// error over one sample interval and is accumulated for stats.
+//
+// predict() dead-reckons from the last update for at most `horizon_us`,
+// then eases back to the last estimate over another horizon: a stream that
+// stopped (controller deadband, lost link) parks the plunger where it was
+// last seen instead of letting it coast away.
+//
+// A subscribed stream sends nothing while the plunger moves less than the
+// deadband, only a keyframe about once a second. With `silence_us` set, a
+// gap longer than that means the plunger stopped: predict() runs ahead for
+// at most `silence_us`, and the next update starts from rest instead of
+// charging the stale velocity against the whole gap.
+#define PPINJECTORUI_MOTION_ALPHA 0.9f
+#define PPINJECTORUI_MOTION_BETA 0.6f
+// A gap longer than this restarts the filter at the new sample.
+#define PPINJECTORUI_MOTION_STALE_US 1000000
+// Silence threshold for a stream subscribed at `rate_hz`: one and a half
+// periods, so sample jitter is not taken for a stop.
+#define PPINJECTORUI_MOTION_SILENCE_US(rate_hz) (1500000u / (rate_hz))
+// ------------------ END   Estimator ------------------
+
+typedef struct {
+  float alpha;
+  float beta;
+  uint32_t horizon_us;
+  uint32_t silence_us; // 0: every sample is sent, stops show as repeats
+  bool valid;
+  int64_t t_us;        // time of the last update
+  float turns;         // filtered position at t_us
+  float turns_per_s;   // filtered velocity
+  uint32_t samples;
+  uint32_t resets;     // restarts: first sample, snap, stale gap
+  uint32_t err_count;  // residuals accumulated below
+  float err_max;       // largest |residual| (turns)
+  double err_sq_sum;   // sum of residual^2, for the RMS
+} PPInjectorUI_motion_t;
+
+void PPInjectorUI_motion_init(PPInjectorUI_motion_t *m, float alpha,
+                              float beta, uint32_t horizon_us,
+                              uint32_t silence_us);
+
+/**
+ * Restart at `turns` with zero velocity (machine state change, keyframe
+ * after a loss).
+ */
+void PPInjectorUI_motion_snap(PPInjectorUI_motion_t *m, float turns,
+                              int64_t t_us);
+
+/** Feed one position sample taken at `t_us`. */
+void PPInjectorUI_motion_update(PPInjectorUI_motion_t *m, float turns,
+                                int64_t t_us);
+
+/**
+ * Estimated position at `t_us` (see the horizon note above); 0 before the
+ * first sample.
+ */
+float PPInjectorUI_motion_predict(const PPInjectorUI_motion_t *m,
+                                  int64_t t_us);
+
+/** RMS of the residuals so far, in turns. */
+float PPInjectorUI_motion_err_rms(const PPInjectorUI_motion_t *m);
+
+typedef struct {
+  float last_rms;   // error of the last sample, what the UI drew before
+  float last_max;
+  float pred_rms;   // error of predict()
+  float pred_max;
+  float hold_max;   // largest predict() error while the plunger stands still
+  uint32_t samples; // samples the stream actually sent
+} PPInjectorUI_motion_bench_t;
+
+/**
+ * Replay a synthetic injection cycle (moves, holds, sample jitter and
+ * 1/1000-turn quantisation) sampled at `sample_hz` and compare, at every
+ * `frame_hz` frame, the true position with the last sample and with
+ * predict() (CONFIG_PPINJECTORUI_MOTION_BENCH only). With `deadband_mturns`
+ * the stream is filtered like the ENC subscription: a sample is only sent
+ * once it moved that far, plus a keyframe every second. Logs the figures
+ * and, if `out` is set, returns them. Plain C; host_test/ runs it
+ * off-target.
+ */
+void PPInjectorUI_motion_benchmark(uint32_t sample_hz, uint32_t frame_hz,
+                                   uint32_t horizon_us,
+                                   uint32_t deadband_mturns,
+                                   PPInjectorUI_motion_bench_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,111 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ------------------ BEGIN File layout ------------------
+// Name search index kept next to the mould store, one fixed entry per store
+// slot (entry i describes library row i):
+// header: u32 magic, u16 version, u16 entry size, u32 count, u32 tag,
+//         u16 flags, u16 crc16
+// entry : u64 trigram signature, head[8]
+//
+// Names are folded (ASCII lower case) first. The signature has one of 64
+// bits set per trigram of the name; head holds the first folded bytes. A
+// query shorter than PPINJECTORUI_MOULD_SEARCH_MIN_TRIGRAM matches as a name
+// prefix, longer ones as a substring, so a scan only reads 16 bytes per row
+// and full names are only fetched for candidates.
+//
+// The index is derived data. The owner sets the dirty flag before changing
+// the store and clears it once the index caught up; an index found dirty or
+// with the wrong count on open is rebuilt from the store. `tag` is an
+// opaque owner value saved with each clean header (the mould library keeps
+// the store's next record id there), so a clean header doubles as an exact
+// summary of the store it describes.
+#define PPINJECTORUI_MOULD_INDEX_MAGIC   0x494D5050u // "PPMI"
+#define PPINJECTORUI_MOULD_INDEX_VERSION 2
+#define PPINJECTORUI_MOULD_INDEX_HEADER_SIZE 20
+#define PPINJECTORUI_MOULD_INDEX_HEAD_LEN 8
+#define PPINJECTORUI_MOULD_INDEX_ENTRY_SIZE (8 + PPINJECTORUI_MOULD_INDEX_HEAD_LEN)
+#define PPINJECTORUI_MOULD_INDEX_PATH_MAX 64
+#define PPINJECTORUI_MOULD_NAME_LEN 32
+#define PPINJECTORUI_MOULD_SEARCH_MIN_TRIGRAM 3
+// ------------------ END   File layout ------------------
+
+typedef struct {
+    char path[PPINJECTORUI_MOULD_INDEX_PATH_MAX];
+    uint32_t count;
+    uint32_t tag; // written with the next clean header
+    bool open;
+    bool dirty;
+    uint8_t *map; // entries mirrored in RAM, NULL until first use
+    uint32_t map_cap;
+    bool map_failed; // no memory for the mirror: stay file-backed
+} PPInjectorUI_mould_index_t;
+
+typedef struct {
+    char query[PPINJECTORUI_MOULD_NAME_LEN]; // folded
+    size_t len;
+    uint64_t sig;
+    uint32_t next; // next row to scan
+} PPInjectorUI_mould_search_t;
+
+/**
+ * Open the index at `path`. Returns false (leaving an empty, dirty index
+ * open) when the file is missing, damaged, left dirty or does not hold
+ * `expected_count` entries; the caller then rebuilds it with set().
+ */
+bool PPInjectorUI_mould_index_open(PPInjectorUI_mould_index_t *idx, const char *path, uint32_t expected_count);
+
+/** Release the RAM mirror; required before opening `idx` again. */
+void PPInjectorUI_mould_index_close(PPInjectorUI_mould_index_t *idx);
+
+/**
+ * Read `count` and `tag` from the header at `path` without opening the
+ * index. False if the file is missing, damaged or was left dirty.
+ */
+bool PPInjectorUI_mould_index_peek(const char *path, uint32_t *count, uint32_t *tag);
+
+/** Mark the index dirty before changing the store, clean once it caught up. */
+bool PPInjectorUI_mould_index_begin_update(PPInjectorUI_mould_index_t *idx);
+bool PPInjectorUI_mould_index_end_update(PPInjectorUI_mould_index_t *idx);
+
+/** True if row `row` already indexes `name` (set() would be a no-op). */
+bool PPInjectorUI_mould_index_same(PPInjectorUI_mould_index_t *idx, uint32_t row, const char *name);
+
+/** Index `name` at `row` (at most one past the end, which appends). */
+bool PPInjectorUI_mould_index_set(PPInjectorUI_mould_index_t *idx, uint32_t row, const char *name);
+
+/** Drop `row`; later entries move up one, like the store. */
+bool PPInjectorUI_mould_index_remove(PPInjectorUI_mould_index_t *idx, uint32_t row);
+
+void PPInjectorUI_mould_search_begin(PPInjectorUI_mould_search_t *s, const char *query);
+
+/**
+ * Scan up to `max_rows` entries from where the previous step stopped and
+ * store rows that may match in `rows` (at most `cap`, stopping early when
+ * full). Candidates still need PPInjectorUI_mould_name_matches() on the full
+ * name. Returns the number stored, or -1 on error; the scan is finished once
+ * s->next reaches idx->count.
+ */
+int PPInjectorUI_mould_search_step(PPInjectorUI_mould_index_t *idx, PPInjectorUI_mould_search_t *s,
+                                   uint32_t max_rows, uint32_t *rows, int cap);
+
+bool PPInjectorUI_mould_name_matches(const char *name, const PPInjectorUI_mould_search_t *s);
+
+/**
+ * Build an index of `rows` synthetic names at `path` and time full-library
+ * queries from flash and from the RAM mirror
+ * (CONFIG_PPINJECTORUI_MOULD_INDEX_BENCH only). Plain stdio, so it
+ * also runs off-target with stub sdkconfig.h / esp_log.h / esp_timer.h.
+ */
+void PPInjectorUI_mould_index_benchmark(const char *path, uint32_t rows);
+
+#ifdef __cplusplus
+}
+#endif
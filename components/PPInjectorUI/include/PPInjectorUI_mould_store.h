@@ -0,0 +1,118 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "PPInjectorUI_binproto.h"
+
+// ------------------ BEGIN File layout ------------------
+// header : u32 magic, u16 version, u16 record size, 6 reserved, u16 crc16
+// slot   : two copies of PPINJECTORUI_MOULD_STORE_COPY_SIZE bytes each
+// copy   : u32 seq, u32 id, u32 modified, u8 flags, u8 reserved,
+//          record[PPINJECTORUI_MOULD_RECORD_SIZE], u16 crc16
+//
+// An update overwrites the older copy of its slot with seq + 1, so a power
+// cut mid-write leaves the other copy intact and the CRC rejects the torn
+// one. Whole-file rewrites (create, compaction, migration) go to a temp file
+// that replaces the store only once it is complete. All integers are
+// little-endian; the record is the binary protocol mould record, so the
+// file does not depend on the in-memory MouldParams layout.
+#define PPINJECTORUI_MOULD_STORE_MAGIC   0x534D5050u // "PPMS"
+#define PPINJECTORUI_MOULD_STORE_VERSION 1
+#define PPINJECTORUI_MOULD_RECORD_SIZE   PPINJECTORUI_BINPROTO_MOULD_SIZE
+#define PPINJECTORUI_MOULD_STORE_HEADER_SIZE 16
+#define PPINJECTORUI_MOULD_STORE_COPY_SIZE (14 + PPINJECTORUI_MOULD_RECORD_SIZE + 2)
+#define PPINJECTORUI_MOULD_STORE_PATH_MAX 64
+// ------------------ END   File layout ------------------
+
+typedef struct {
+    uint32_t id;       // stable across edits; 0 asks the store to assign one
+    uint32_t modified; // caller-defined timestamp
+    uint8_t data[PPINJECTORUI_MOULD_RECORD_SIZE];
+} PPInjectorUI_mould_record_t;
+
+typedef struct {
+    uint32_t records_written;   // copies written by put/erase
+    uint32_t records_unchanged; // puts skipped because nothing changed
+    uint32_t bad_copies;        // copies rejected by CRC while reading
+    uint32_t rewrites;          // temp-file rewrites
+    uint32_t scans;             // opens that had to read every slot
+} PPInjectorUI_mould_store_stats_t;
+
+typedef struct {
+    char path[PPINJECTORUI_MOULD_STORE_PATH_MAX];
+    uint32_t slots;
+    uint32_t live; // slots holding a record
+    uint32_t next_id;
+    bool open;
+    PPInjectorUI_mould_store_stats_t stats;
+} PPInjectorUI_mould_store_t;
+
+/**
+ * Open (creating if needed) the store at `path`. Finishes an interrupted
+ * rewrite, drops a stale temp file and refuses files written by a newer,
+ * unknown format version instead of overwriting them.
+ */
+bool PPInjectorUI_mould_store_open(PPInjectorUI_mould_store_t *s, const char *path);
+
+/**
+ * Open without scanning every slot, trusting a summary the owner saved
+ * while the store was consistent: `slots` records, all live, ids below
+ * `next_id`. Only taken when no rewrite is pending and the file size
+ * matches `slots` exactly; otherwise this is open(). Use it only where every
+ * change to the store also updates the summary.
+ */
+bool PPInjectorUI_mould_store_open_summary(PPInjectorUI_mould_store_t *s, const char *path, uint32_t slots,
+                                           uint32_t next_id);
+uint32_t PPInjectorUI_mould_store_slots(const PPInjectorUI_mould_store_t *s);
+
+/** Returns 1 and fills `rec` for a live slot, 0 for an empty one, -1 on I/O error. */
+int PPInjectorUI_mould_store_get(PPInjectorUI_mould_store_t *s, uint32_t slot,
+                                 PPInjectorUI_mould_record_t *rec);
+
+/**
+ * Read `count` consecutive slots from `first` with a single open; empty
+ * slots come back zeroed (id 0). Returns the number of slots read (clipped
+ * to the end of the store) or -1 on error.
+ */
+int PPInjectorUI_mould_store_get_range(PPInjectorUI_mould_store_t *s, uint32_t first, uint32_t count,
+                                       PPInjectorUI_mould_record_t *recs);
+
+/**
+ * Store `rec` in `slot` (at most one past the last slot, which appends).
+ * Only that slot is written, and not at all if its content is unchanged.
+ * Assigns rec->id when it is 0. Returns 1 if written, 0 if unchanged, -1 on
+ * error.
+ */
+int PPInjectorUI_mould_store_put(PPInjectorUI_mould_store_t *s, uint32_t slot,
+                                 PPInjectorUI_mould_record_t *rec);
+
+/** Mark `slot` empty. Same return convention as put. */
+int PPInjectorUI_mould_store_erase(PPInjectorUI_mould_store_t *s, uint32_t slot);
+
+/**
+ * Drop `slot` and close the gap: later records (and ids) move up one slot,
+ * empty slots are squeezed out; UINT32_MAX only squeezes. Streams through a
+ * temp file + rename.
+ */
+bool PPInjectorUI_mould_store_remove(PPInjectorUI_mould_store_t *s, uint32_t slot);
+
+/** Replace the whole store with `count` records (temp file + rename). */
+bool PPInjectorUI_mould_store_rewrite(PPInjectorUI_mould_store_t *s,
+                                      const PPInjectorUI_mould_record_t *recs, uint32_t count);
+
+/**
+ * Power-cut replay (CONFIG_PPINJECTORUI_STORAGE_SELFTEST only): cuts every
+ * kind of write after each possible byte count, reopens the store at `path`
+ * and checks that each slot holds either its old or its new content.
+ */
+bool PPInjectorUI_mould_store_selftest(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
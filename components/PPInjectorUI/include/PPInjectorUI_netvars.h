@@ -16,11 +16,15 @@ void PPInjectorUI_netvars_nvs_load(void);
 void PPInjectorUI_netvars_nvs_save(void);
 
 void PPInjectorUI_netvars_append_json(cJSON *root);
+void PPInjectorUI_netvars_write_json(NetVars_json_writer_t *w);
 bool PPInjectorUI_netvars_parse_json_dict(cJSON *root);
 
+// Apply this component's section of an already parsed config document.
+void PPInjectorUI_config_parse_json_root(cJSON *root);
 void PPInjectorUI_config_parse_json(const char *data);
 void PPInjectorUI_nvs_set_dirty(void);
 void PPInjectorUI_nvs_spin(void);
+const netvars_nvs_stats_t *PPInjectorUI_nvs_stats(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,47 @@
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <lvgl.h>
+
+namespace PrdTheme {
+
+constexpr int REFILL_STAGES = 16;
+constexpr uint8_t NO_STAGE = 0xFF;
+
+// Shared styles for the PrdUi widgets, built once by init(). Widgets attach
+// them with lv_obj_add_style() instead of setting local properties, so each
+// property is stored once however many objects use it and changing a look
+// is one style swap. Styles are added after the LVGL theme's, so they win
+// over it; a local property set on one object still wins over them.
+struct Styles {
+  lv_style_t button;           // rounded blue button, white centred text
+  lv_style_t panel;            // right-hand panel background
+  lv_style_t errorFrame;       // red border on a panel while an error is up
+  lv_style_t mouldCurrent;     // main "(current)" box with a mould loaded
+  lv_style_t mouldPlaceholder; // main "(current)" box while waiting
+  lv_style_t eodIdle;          // End of Day button
+  lv_style_t eodActive;        // End of Day button with the flag set
+  lv_style_t refillBand;       // band geometry and top line
+  lv_style_t refillBandLabel;  // volume/age text inside a band
+  lv_style_t refillStage[REFILL_STAGES]; // band heat colour, blue -> red
+};
+
+void init(void);
+// Valid after init().
+const Styles &styles(void);
+// LVGL heap taken by the shared styles, measured in init().
+size_t heapBytes(void);
+
+// Replaces `from` with `to` on the main part of `obj`, keeping its place in
+// the style list. Either may be nullptr to only attach or only detach; a
+// `to` the object already carries is moved to the top, not added twice.
+void swap(lv_obj_t *obj, const lv_style_t *from, const lv_style_t *to);
+
+// Drops the generated widget's local look from an EEZ refill band and
+// attaches refillBand, so only the heat stage changes per render.
+void adoptRefillBand(lv_obj_t *band);
+
+} // namespace PrdTheme
+#endif
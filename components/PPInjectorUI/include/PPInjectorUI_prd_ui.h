@@ -1,13 +1,50 @@
 #pragma once
 
 #ifdef __cplusplus
+#include <cstdint>
+
 namespace PrdUi {
 
+// Mould list bookkeeping: with nothing changing, every counter but `syncs`
+// should stay flat. buttonsCreated never exceeds the row pool size, however
+// many profiles are stored.
+struct MouldListStats {
+  uint32_t syncs;             // list syncs requested
+  uint32_t rebuilds;          // syncs that had to create buttons
+  uint32_t buttonsCreated;    // LVGL button objects allocated
+  uint32_t labelPatches;      // button labels rewritten
+  uint32_t stylePatches;      // selection colours rewritten
+  uint32_t visibilityPatches; // buttons shown or hidden
+  uint32_t rowBinds;          // pooled buttons moved to another row
+  uint32_t pageLoads;         // index pages read from flash
+  uint32_t scrollEvents;      // LV_EVENT_SCROLL handled
+  uint32_t scrollBindUsMax;   // slowest re-bind in a scroll event
+  uint64_t scrollBindUsTotal; // total time re-binding on scroll
+  uint32_t searches;          // searches started from the search box
+  uint32_t searchSteps;       // budgeted index scan slices run from tick()
+  uint32_t searchStepUsMax;   // slowest scan slice
+};
+
+// Live widget scheduling: readouts, plunger Y and refill bands are written
+// only on the active screen; hidden screens are marked stale and caught up
+// once when they become active. `writes` counts LVGL property setters run
+// from tick(), so it shows what the skipped screens no longer cost.
+struct LiveUpdateStats {
+  uint32_t ticks;          // tick() calls
+  uint32_t writes;         // LVGL property writes made inside tick()
+  uint32_t lastTickWrites; // writes made by the most recent tick()
+  uint32_t maxTickWrites;  // most writes made by a single tick()
+  uint32_t deferred;       // live updates left stale on a hidden screen
+  uint32_t catchUps;       // stale screens refreshed on becoming active
+};
+
 void init(void);
 void tick(void);
 bool isInitialized(void);
 void storageSelfTest(void);
 void storageReadDump(void);
+const MouldListStats &mouldListStats(void);
+const LiveUpdateStats &liveUpdateStats(void);
 
 } // namespace PrdUi
 #endif
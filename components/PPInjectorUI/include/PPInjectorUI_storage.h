@@ -0,0 +1,48 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <sdkconfig.h>
+
+#include "esp_err.h"
+
+// Filesystem behind the UI's profile and settings files. Everything above
+// it (mould store, name index, local settings) only uses stdio paths under
+// the mount point, so a backend only has to mount, unmount and report usage.
+typedef struct {
+    const char *name;
+    esp_err_t (*mount)(const char *base_path, const char *partition_label, bool format_if_mount_failed);
+    esp_err_t (*unmount)(const char *partition_label);
+    esp_err_t (*info)(const char *partition_label, size_t *total, size_t *used);
+} PPInjectorUI_storage_backend_t;
+
+extern const PPInjectorUI_storage_backend_t PPInjectorUI_storage_spiffs;
+#if CONFIG_PPINJECTORUI_STORAGE_LITTLEFS
+extern const PPInjectorUI_storage_backend_t PPInjectorUI_storage_littlefs;
+#endif
+
+/**
+ * Backend picked in Kconfig (PPINJECTORUI_STORAGE_BACKEND), or SPIFFS after
+ * a mount that had to keep an unconvertible SPIFFS partition.
+ */
+const PPInjectorUI_storage_backend_t *PPInjectorUI_storage_backend(void);
+
+/**
+ * Mount the configured backend on `partition_label` at `base_path`. When it
+ * is LittleFS and the partition still holds SPIFFS from older firmware, the
+ * files are carried over (read into RAM, partition reformatted, written
+ * back) instead of being lost to format_if_mount_failed. If any file cannot
+ * be read into RAM the partition is not formatted: it stays mounted as
+ * SPIFFS (see PPInjectorUI_storage_backend()) and the conversion is retried
+ * on the next mount.
+ */
+esp_err_t PPInjectorUI_storage_mount(const char *base_path, const char *partition_label);
+
+#ifdef __cplusplus
+}
+#endif
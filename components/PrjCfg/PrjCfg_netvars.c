@@ -1,3 +1,4 @@
+#include <assert.h>
 #include <string.h>
 #include <PrjCfg.h>
 #include "PrjCfg_netvars.h"
@@ -10,6 +11,13 @@ const NetVars_desc_t PrjCfg_netvars_desc[] = {
 
 const size_t PrjCfg_netvars_count = sizeof(PrjCfg_netvars_desc) / sizeof(PrjCfg_netvars_desc[0]);
 
+#include "PrjCfg_netvars_index_fragment.c_"
+
+const size_t PrjCfg_netvars_key_index_count = sizeof(PrjCfg_netvars_key_index) / sizeof(PrjCfg_netvars_key_index[0]);
+
+_Static_assert(sizeof(PrjCfg_netvars_desc) / sizeof(PrjCfg_netvars_desc[0]) == PRJCFG_NETVARS_POS_COUNT,
+               "PrjCfg_netvars_index_fragment.c_ is out of date; rerun poris/gen_netvars.py PrjCfg");
+
 void PrjCfg_netvars_append_json(cJSON *root)
 {
     if (PrjCfg_netvars_count > 0)
@@ -18,11 +26,21 @@ void PrjCfg_netvars_append_json(cJSON *root)
     }
 }
 
+void PrjCfg_netvars_write_json(NetVars_json_writer_t *w)
+{
+    if (PrjCfg_netvars_count > 0)
+    {
+        NetVars_write_json_component("PrjCfg", PrjCfg_netvars_desc, PrjCfg_netvars_count, w);
+    }
+}
+
 bool PrjCfg_netvars_parse_json_dict(cJSON *root)
 {
     if (PrjCfg_netvars_count > 0)
     {
-        return NetVars_parse_json_dict(PrjCfg_netvars_desc, PrjCfg_netvars_count, root);
+        return NetVars_parse_json_dict_indexed(PrjCfg_netvars_desc, PrjCfg_netvars_count,
+                                               PrjCfg_netvars_key_index, PrjCfg_netvars_key_index_count, root,
+                                               &PrjCfg_nvs_mgr);
     }
     else
     {
@@ -32,8 +50,12 @@ bool PrjCfg_netvars_parse_json_dict(cJSON *root)
 
 void PrjCfg_netvars_nvs_load(void)
 {
+    // Runs once at component init: a stale index fragment would make lookups
+    // miss keys silently, so debug builds stop here instead.
+    assert(NetVars_key_index_check("PrjCfg", PrjCfg_netvars_desc, PrjCfg_netvars_count,
+                                   PrjCfg_netvars_key_index, PrjCfg_netvars_key_index_count));
     if (PrjCfg_netvars_count > 0)
-    {    
+    {
         NetVars_nvs_load_component("PrjCfg", PrjCfg_netvars_desc, PrjCfg_netvars_count);
     }
 }
@@ -41,19 +63,31 @@ void PrjCfg_netvars_nvs_load(void)
 void PrjCfg_netvars_nvs_save(void)
 {
     if (PrjCfg_netvars_count > 0)
-    {  
+    {
         NetVars_nvs_save_component("PrjCfg", PrjCfg_netvars_desc, PrjCfg_netvars_count);
     }
 }
 
-void PrjCfg_config_parse_json(const char *data)
+void PrjCfg_config_parse_json_root(cJSON *root)
 {
     if (PrjCfg_netvars_count > 0)
-    {    
-        bool nvs_cfg_changed = NetVars_parse_json_component_data("PrjCfg", PrjCfg_netvars_desc, PrjCfg_netvars_count, data);
-        if (nvs_cfg_changed)
+    {
+        // Changed NVS-backed descriptors are marked dirty one by one.
+        (void)NetVars_parse_json_component_indexed("PrjCfg", PrjCfg_netvars_desc, PrjCfg_netvars_count,
+                                                   PrjCfg_netvars_key_index, PrjCfg_netvars_key_index_count, root,
+                                                   &PrjCfg_nvs_mgr);
+    }
+}
+
+void PrjCfg_config_parse_json(const char *data)
+{
+    if (PrjCfg_netvars_count > 0 && data)
+    {
+        cJSON *root = cJSON_Parse(data);
+        if (root)
         {
-            PrjCfg_nvs_set_dirty();
+            PrjCfg_config_parse_json_root(root);
+            cJSON_Delete(root);
         }
     }
 }
@@ -65,8 +99,13 @@ void PrjCfg_nvs_set_dirty(void)
 
 void PrjCfg_nvs_spin(void)
 {
-    if (NetVars_nvs_spin(&PrjCfg_nvs_mgr))
+    if (PrjCfg_netvars_count > 0)
     {
-        PrjCfg_netvars_nvs_save();
+        (void)NetVars_nvs_spin_component("PrjCfg", PrjCfg_netvars_desc, PrjCfg_netvars_count, &PrjCfg_nvs_mgr);
     }
 }
+
+const netvars_nvs_stats_t *PrjCfg_nvs_stats(void)
+{
+    return &PrjCfg_nvs_mgr.stats;
+}
@@ -16,12 +16,16 @@ void PrjCfg_netvars_nvs_load(void);
 void PrjCfg_netvars_nvs_save(void);
 
 void PrjCfg_netvars_append_json(cJSON *root);
+void PrjCfg_netvars_write_json(NetVars_json_writer_t *w);
 bool PrjCfg_netvars_parse_json_dict(cJSON *root);
 
+// Apply this component's section of an already parsed config document.
+void PrjCfg_config_parse_json_root(cJSON *root);
 void PrjCfg_config_parse_json(const char *data);
 
 void PrjCfg_nvs_set_dirty(void);
 void PrjCfg_nvs_spin(void);
+const netvars_nvs_stats_t *PrjCfg_nvs_stats(void);
 
 #ifdef __cplusplus
 }
@@ -1,3 +1,4 @@
+#include <assert.h>
 #include <string.h>
 #include <Provisioning.h>
 #include "Provisioning_netvars.h"
@@ -10,6 +11,13 @@ const NetVars_desc_t Provisioning_netvars_desc[] = {
 
 const size_t Provisioning_netvars_count = sizeof(Provisioning_netvars_desc) / sizeof(Provisioning_netvars_desc[0]);
 
+#include "Provisioning_netvars_index_fragment.c_"
+
+const size_t Provisioning_netvars_key_index_count = sizeof(Provisioning_netvars_key_index) / sizeof(Provisioning_netvars_key_index[0]);
+
+_Static_assert(sizeof(Provisioning_netvars_desc) / sizeof(Provisioning_netvars_desc[0]) == PROVISIONING_NETVARS_POS_COUNT,
+               "Provisioning_netvars_index_fragment.c_ is out of date; rerun poris/gen_netvars.py Provisioning");
+
 void Provisioning_netvars_append_json(cJSON *root)
 {
     if (Provisioning_netvars_count > 0)
@@ -18,11 +26,21 @@ void Provisioning_netvars_append_json(cJSON *root)
     }
 }
 
+void Provisioning_netvars_write_json(NetVars_json_writer_t *w)
+{
+    if (Provisioning_netvars_count > 0)
+    {
+        NetVars_write_json_component("Provisioning", Provisioning_netvars_desc, Provisioning_netvars_count, w);
+    }
+}
+
 bool Provisioning_netvars_parse_json_dict(cJSON *root)
 {
     if (Provisioning_netvars_count > 0)
     {
-        return NetVars_parse_json_dict(Provisioning_netvars_desc, Provisioning_netvars_count, root);
+        return NetVars_parse_json_dict_indexed(Provisioning_netvars_desc, Provisioning_netvars_count,
+                                               Provisioning_netvars_key_index, Provisioning_netvars_key_index_count, root,
+                                               &Provisioning_nvs_mgr);
     }
     else
     {
@@ -32,6 +50,10 @@ bool Provisioning_netvars_parse_json_dict(cJSON *root)
 
 void Provisioning_netvars_nvs_load(void)
 {
+    // Runs once at component init: a stale index fragment would make lookups
+    // miss keys silently, so debug builds stop here instead.
+    assert(NetVars_key_index_check("Provisioning", Provisioning_netvars_desc, Provisioning_netvars_count,
+                                   Provisioning_netvars_key_index, Provisioning_netvars_key_index_count));
     if (Provisioning_netvars_count > 0)
     {
         NetVars_nvs_load_component("Provisioning", Provisioning_netvars_desc, Provisioning_netvars_count);
@@ -46,14 +68,26 @@ void Provisioning_netvars_nvs_save(void)
     }
 }
 
-void Provisioning_config_parse_json(const char *data)
+void Provisioning_config_parse_json_root(cJSON *root)
 {
     if (Provisioning_netvars_count > 0)
     {
-        bool nvs_cfg_changed = NetVars_parse_json_component_data("Provisioning", Provisioning_netvars_desc, Provisioning_netvars_count, data);
-        if (nvs_cfg_changed)
+        // Changed NVS-backed descriptors are marked dirty one by one.
+        (void)NetVars_parse_json_component_indexed("Provisioning", Provisioning_netvars_desc, Provisioning_netvars_count,
+                                                   Provisioning_netvars_key_index, Provisioning_netvars_key_index_count, root,
+                                                   &Provisioning_nvs_mgr);
+    }
+}
+
+void Provisioning_config_parse_json(const char *data)
+{
+    if (Provisioning_netvars_count > 0 && data)
+    {
+        cJSON *root = cJSON_Parse(data);
+        if (root)
         {
-            Provisioning_nvs_set_dirty();
+            Provisioning_config_parse_json_root(root);
+            cJSON_Delete(root);
         }
     }
 }
@@ -65,8 +99,13 @@ void Provisioning_nvs_set_dirty(void)
 
 void Provisioning_nvs_spin(void)
 {
-    if (NetVars_nvs_spin(&Provisioning_nvs_mgr))
+    if (Provisioning_netvars_count > 0)
     {
-        Provisioning_netvars_nvs_save();
+        (void)NetVars_nvs_spin_component("Provisioning", Provisioning_netvars_desc, Provisioning_netvars_count, &Provisioning_nvs_mgr);
     }
 }
+
+const netvars_nvs_stats_t *Provisioning_nvs_stats(void)
+{
+    return &Provisioning_nvs_mgr.stats;
+}
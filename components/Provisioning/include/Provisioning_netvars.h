@@ -16,12 +16,16 @@ void Provisioning_netvars_nvs_load(void);
 void Provisioning_netvars_nvs_save(void);
 
 void Provisioning_netvars_append_json(cJSON *root);
+void Provisioning_netvars_write_json(NetVars_json_writer_t *w);
 bool Provisioning_netvars_parse_json_dict(cJSON *root);
 
+// Apply this component's section of an already parsed config document.
+void Provisioning_config_parse_json_root(cJSON *root);
 void Provisioning_config_parse_json(const char *data);
 
 void Provisioning_nvs_set_dirty(void);
 void Provisioning_nvs_spin(void);
+const netvars_nvs_stats_t *Provisioning_nvs_stats(void);
 
 #ifdef __cplusplus
 }
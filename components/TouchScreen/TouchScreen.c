@@ -389,3 +389,14 @@ int TouchScreen_boot_display_height(void)
 {
     return TouchScreen_display_boot_height();
 }
+
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+bool TouchScreen_panel_stats(TouchScreen_panel_stats_t *dst)
+{
+    if (!s_lvgl_ready || !dst)
+    {
+        return false;
+    }
+    return TouchScreen_display_panel_stats(dst);
+}
+#endif
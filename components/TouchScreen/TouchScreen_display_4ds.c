@@ -60,7 +60,6 @@ static const char *TAG = "TouchScreen4DS";
 #define GEN4_IOX_TOUCH_INT_BIT     6  // 1 = no touch, 0 = touch (active-low)
 
 static bool s_i2c_inited = false;
-static lv_indev_t *s_indev = NULL;
 
 static esp_err_t touch_i2c_init(void)
 {
@@ -143,26 +142,6 @@ static esp_err_t touch_read(uint16_t *out_x, uint16_t *out_y, bool *out_pressed)
     return ESP_OK;
 }
 
-static void lvgl_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
-{
-    (void)indev;
-    static uint16_t last_x = 0;
-    static uint16_t last_y = 0;
-
-    uint16_t x = 0, y = 0;
-    bool pressed = false;
-    if (touch_read(&x, &y, &pressed) == ESP_OK && pressed) {
-        last_x = x;
-        last_y = y;
-        data->state = (lv_indev_state_t)1;
-    } else {
-        data->state = (lv_indev_state_t)0;
-    }
-    data->point.x = (lv_coord_t)last_x;
-    data->point.y = (lv_coord_t)last_y;
-    data->continue_reading = false;
-}
-
 IRAM_ATTR static bool rgb_lcd_on_vsync_event(esp_lcd_panel_handle_t panel,
                                             const esp_lcd_rgb_panel_event_data_t *edata,
                                             void *user_ctx)
@@ -253,18 +232,12 @@ esp_err_t TouchScreen_display_init(void)
     ESP_ERROR_CHECK(touch_i2c_init());
 
     ESP_ERROR_CHECK(lvgl_port_init(panel_handle, NULL));
-    // Register LVGL touch input device (polling I2C controller at 0x38)
-    if (lvgl_port_lock(1000)) {
-        s_indev = lv_indev_create();
-        if (!s_indev) {
-            ESP_LOGW(TAG, "lv_indev_create failed");
-        } else {
-            lv_indev_set_type(s_indev, LV_INDEV_TYPE_POINTER);
-            lv_indev_set_read_cb(s_indev, lvgl_touch_read_cb);
-        }
-        lvgl_port_unlock();
-    } else {
-        ESP_LOGW(TAG, "lvgl_port_lock failed, touch not registered");
+    // Register LVGL touch input device. The expander's interrupt output is
+    // not wired to a GPIO we know of, so the touch task polls it (I2C @ 0x39,
+    // then the controller @ 0x38 only while touched) off the LVGL task.
+    esp_err_t touch_err = lvgl_port_touch_start(touch_read, -1);
+    if (touch_err != ESP_OK) {
+        ESP_LOGW(TAG, "touch not registered: %s", esp_err_to_name(touch_err));
     }
 
     esp_lcd_rgb_panel_event_callbacks_t cbs = {
@@ -307,3 +280,11 @@ int TouchScreen_display_boot_height(void)
 {
     return 0;
 }
+
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+bool TouchScreen_display_panel_stats(TouchScreen_panel_stats_t *dst)
+{
+    (void)dst;
+    return false;
+}
+#endif
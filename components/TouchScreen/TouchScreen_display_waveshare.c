@@ -38,3 +38,10 @@ int TouchScreen_display_boot_height(void)
 {
     return waveshare_esp32_s3_rgb_lcd_height();
 }
+
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+bool TouchScreen_display_panel_stats(TouchScreen_panel_stats_t *dst)
+{
+    return waveshare_esp32_s3_rgb_lcd_scan_stats(dst);
+}
+#endif
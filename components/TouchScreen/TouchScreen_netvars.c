@@ -1,3 +1,4 @@
+#include <assert.h>
 #include <string.h>
 #include <TouchScreen.h>
 #include "TouchScreen_netvars.h"
@@ -10,6 +11,13 @@ const NetVars_desc_t TouchScreen_netvars_desc[] = {
 
 const size_t TouchScreen_netvars_count = sizeof(TouchScreen_netvars_desc) / sizeof(TouchScreen_netvars_desc[0]);
 
+#include "TouchScreen_netvars_index_fragment.c_"
+
+const size_t TouchScreen_netvars_key_index_count = sizeof(TouchScreen_netvars_key_index) / sizeof(TouchScreen_netvars_key_index[0]);
+
+_Static_assert(sizeof(TouchScreen_netvars_desc) / sizeof(TouchScreen_netvars_desc[0]) == TOUCHSCREEN_NETVARS_POS_COUNT,
+               "TouchScreen_netvars_index_fragment.c_ is out of date; rerun poris/gen_netvars.py TouchScreen");
+
 void TouchScreen_netvars_append_json(cJSON *root)
 {
     if (TouchScreen_netvars_count > 0)
@@ -18,11 +26,21 @@ void TouchScreen_netvars_append_json(cJSON *root)
     }
 }
 
+void TouchScreen_netvars_write_json(NetVars_json_writer_t *w)
+{
+    if (TouchScreen_netvars_count > 0)
+    {
+        NetVars_write_json_component("TouchScreen", TouchScreen_netvars_desc, TouchScreen_netvars_count, w);
+    }
+}
+
 bool TouchScreen_netvars_parse_json_dict(cJSON *root)
 {
     if (TouchScreen_netvars_count > 0)
     {
-        return NetVars_parse_json_dict(TouchScreen_netvars_desc, TouchScreen_netvars_count, root);
+        return NetVars_parse_json_dict_indexed(TouchScreen_netvars_desc, TouchScreen_netvars_count,
+                                               TouchScreen_netvars_key_index, TouchScreen_netvars_key_index_count, root,
+                                               &TouchScreen_nvs_mgr);
     }
     else
     {
@@ -32,6 +50,10 @@ bool TouchScreen_netvars_parse_json_dict(cJSON *root)
 
 void TouchScreen_netvars_nvs_load(void)
 {
+    // Runs once at component init: a stale index fragment would make lookups
+    // miss keys silently, so debug builds stop here instead.
+    assert(NetVars_key_index_check("TouchScreen", TouchScreen_netvars_desc, TouchScreen_netvars_count,
+                                   TouchScreen_netvars_key_index, TouchScreen_netvars_key_index_count));
     if (TouchScreen_netvars_count > 0)
     {
         NetVars_nvs_load_component("TouchScreen", TouchScreen_netvars_desc, TouchScreen_netvars_count);
@@ -46,14 +68,26 @@ void TouchScreen_netvars_nvs_save(void)
     }
 }
 
-void TouchScreen_config_parse_json(const char *data)
+void TouchScreen_config_parse_json_root(cJSON *root)
 {
     if (TouchScreen_netvars_count > 0)
     {
-        bool nvs_cfg_changed = NetVars_parse_json_component_data("TouchScreen", TouchScreen_netvars_desc, TouchScreen_netvars_count, data);
-        if (nvs_cfg_changed)
+        // Changed NVS-backed descriptors are marked dirty one by one.
+        (void)NetVars_parse_json_component_indexed("TouchScreen", TouchScreen_netvars_desc, TouchScreen_netvars_count,
+                                                   TouchScreen_netvars_key_index, TouchScreen_netvars_key_index_count, root,
+                                                   &TouchScreen_nvs_mgr);
+    }
+}
+
+void TouchScreen_config_parse_json(const char *data)
+{
+    if (TouchScreen_netvars_count > 0 && data)
+    {
+        cJSON *root = cJSON_Parse(data);
+        if (root)
         {
-            TouchScreen_nvs_set_dirty();
+            TouchScreen_config_parse_json_root(root);
+            cJSON_Delete(root);
         }
     }
 }
@@ -65,8 +99,13 @@ void TouchScreen_nvs_set_dirty(void)
 
 void TouchScreen_nvs_spin(void)
 {
-    if (NetVars_nvs_spin(&TouchScreen_nvs_mgr))
+    if (TouchScreen_netvars_count > 0)
     {
-        TouchScreen_netvars_nvs_save();
+        (void)NetVars_nvs_spin_component("TouchScreen", TouchScreen_netvars_desc, TouchScreen_netvars_count, &TouchScreen_nvs_mgr);
     }
 }
+
+const netvars_nvs_stats_t *TouchScreen_nvs_stats(void)
+{
+    return &TouchScreen_nvs_mgr.stats;
+}
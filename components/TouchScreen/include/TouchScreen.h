@@ -7,6 +7,7 @@ extern "C" {
 #include <stdbool.h>
 #include <stdint.h>
 #include <esp_err.h>
+#include <sdkconfig.h>
 
 #include <PrjCfg.h>
 
@@ -18,7 +19,67 @@ typedef enum {
 // ------------------ END   Return code ------------------
 
 // ------------------ BEGIN Datatypes ------------------
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+// Per-frame measurements kept by the LVGL port frame profiler. A frame is a
+// display refresh that flushed at least one area.
+typedef enum {
+    TouchScreen_frame_handler_us = 0, // lv_timer_handler() pass that drew it
+    TouchScreen_frame_render_us,      // refresh start to ready, flushes included
+    TouchScreen_frame_flush_us,       // flush_cb() total, rotation included
+    TouchScreen_frame_rotated_bytes,  // bytes copied by software rotation
+    TouchScreen_frame_invalidated_px, // pixels invalidated for the frame
+    TouchScreen_frame_vsync_us,       // waiting for vsync after a buffer swap
+    TouchScreen_frame_synced_bytes,   // bytes copied to keep both buffers equal
+    TouchScreen_frame_tick_us,        // UI tick time since the previous frame
+    TouchScreen_frame_metric_count
+} TouchScreen_frame_metric_t;
+
+typedef struct {
+    uint32_t p50;
+    uint32_t p95;
+    uint32_t max;
+} TouchScreen_frame_percentiles_t;
+
+typedef struct {
+    uint32_t frames;       // frames in the sliding window
+    uint32_t window_ms;    // time between the oldest and newest of them
+    uint32_t total_frames; // frames since boot
+    uint32_t vsync_timeouts; // buffer swaps that saw no vsync (direct mode)
+    TouchScreen_frame_percentiles_t metric[TouchScreen_frame_metric_count];
+} TouchScreen_frame_stats_t;
+#endif
 
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+// RGB panel scan-out counters (CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR) and the
+// display performance profile they were measured with.
+typedef struct {
+    uint32_t frames;           // vsyncs since the LVGL display came up
+    uint32_t slips;            // late bounce-buffer refills that shifted the picture
+    uint32_t restarts;         // panel restarts issued after a slip
+    uint32_t frame_us_max;     // longest vsync to vsync since the previous call
+    uint32_t frame_us;         // nominal frame time from the panel timings
+    uint32_t slip_us;          // refill lateness counted as a slip (0: no bounce buffer)
+    uint32_t scan_bytes_per_s; // PSRAM read rate of the scan-out
+    uint32_t pixel_clock_hz;
+    uint16_t bounce_lines;
+    uint8_t frame_buffers;
+} TouchScreen_panel_stats_t;
+#endif
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+// Touch task counters and touch-to-pixel latency: time from the touch event
+// (INT edge, or polled read) to the end of the first frame flushed after
+// LVGL took the change in. Scan-out of that frame adds up to one frame time.
+typedef struct {
+    uint32_t reads;        // controller reads by the touch task
+    uint32_t int_wakeups;  // reads triggered by the INT line
+    uint32_t read_errors;
+    uint32_t read_us_max;  // longest controller read
+    uint32_t count;        // touch changes that reached the screen
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+} TouchScreen_touch_stats_t;
+#endif
 // ------------------ END   Datatypes ------------------
 
 // ------------------ BEGIN DRE ------------------
@@ -105,6 +166,9 @@ void TouchScreen_lvgl_unlock(void);
 
 /**
  * Lightweight boot display helpers (no LVGL).
+ * draw_center_text() remembers what it drew: calling it again with the same
+ * line count and longest line only repaints the lines that changed, so
+ * progress screens can be refreshed cheaply.
  */
 bool TouchScreen_boot_display_ready(void);
 esp_err_t TouchScreen_boot_display_init(void);
@@ -114,6 +178,36 @@ esp_err_t TouchScreen_boot_display_draw_center_text(const char *text, uint16_t f
 int TouchScreen_boot_display_width(void);
 int TouchScreen_boot_display_height(void);
 
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+/**
+ * Frame profiler (CONFIG_LVGL_PORT_FRAME_PROFILER), implemented by the LVGL
+ * port. Call both with the LVGL lock held.
+ * - TouchScreen_frame_stats() fills p50/p95/max over the last
+ *   CONFIG_LVGL_PORT_FRAME_PROFILER_WINDOW frames; false if none yet.
+ * - TouchScreen_frame_add_tick_us() charges UI tick time to the next frame.
+ */
+bool TouchScreen_frame_stats(TouchScreen_frame_stats_t *dst);
+void TouchScreen_frame_add_tick_us(uint32_t us);
+const char *TouchScreen_frame_metric_name(TouchScreen_frame_metric_t metric);
+#endif
+
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+/**
+ * RGB panel scan-out counters; false if the display backend has no monitor
+ * or the display is not up yet. Resets frame_us_max.
+ */
+bool TouchScreen_panel_stats(TouchScreen_panel_stats_t *dst);
+#endif
+
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+/**
+ * Touch counters and latency (CONFIG_LVGL_PORT_TOUCH_LATENCY), implemented
+ * by the LVGL port. Call with the LVGL lock held; false if no touch has
+ * reached the screen yet.
+ */
+bool TouchScreen_touch_stats(TouchScreen_touch_stats_t *dst);
+#endif
+
 // ------------------ END   Public API (COMMON)--------------------
 
 #ifdef __cplusplus
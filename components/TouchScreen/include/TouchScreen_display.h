@@ -1,6 +1,10 @@
 #pragma once
 
+#include <stdbool.h>
+#include <sdkconfig.h>
+
 #include "esp_err.h"
+#include "TouchScreen.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -37,6 +41,13 @@ esp_err_t TouchScreen_display_boot_draw_center_text(const char *text, uint16_t f
 int TouchScreen_display_boot_width(void);
 int TouchScreen_display_boot_height(void);
 
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+/**
+ * Scan-out monitor counters, see TouchScreen_panel_stats().
+ */
+bool TouchScreen_display_panel_stats(TouchScreen_panel_stats_t *dst);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,11 +16,15 @@ void TouchScreen_netvars_nvs_load(void);
 void TouchScreen_netvars_nvs_save(void);
 
 void TouchScreen_netvars_append_json(cJSON *root);
+void TouchScreen_netvars_write_json(NetVars_json_writer_t *w);
 bool TouchScreen_netvars_parse_json_dict(cJSON *root);
 
+// Apply this component's section of an already parsed config document.
+void TouchScreen_config_parse_json_root(cJSON *root);
 void TouchScreen_config_parse_json(const char *data);
 void TouchScreen_nvs_set_dirty(void);
 void TouchScreen_nvs_spin(void);
+const netvars_nvs_stats_t *TouchScreen_nvs_stats(void);
 
 #ifdef __cplusplus
 }
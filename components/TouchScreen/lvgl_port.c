@@ -3,13 +3,17 @@
  */
 
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
 
+#include "driver/gpio.h"
 #include "esp_err.h"
 #include "esp_heap_caps.h"
 #include "esp_lcd_panel_ops.h"
@@ -17,9 +21,13 @@
 #include "esp_lcd_touch.h"
 #include "esp_log.h"
 #include "esp_timer.h"
+#if CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT == 0
+#include "esp_cache.h"
+#endif
 
 #include "lvgl.h"
 #include "lvgl_port.h"
+#include "TouchScreen.h"
 
 static const char *TAG = "lv_port";
 
@@ -34,8 +42,167 @@ static lv_color_t *s_draw_buf_1;
 static lv_color_t *s_draw_buf_2;
 static uint8_t *s_rot_buf;
 static size_t s_rot_buf_bytes;
+#if CONFIG_LVGL_PORT_ROTATE_INTO_FB
+static uint8_t *s_panel_fb; // RGB frame buffer rotated areas are written to
+#endif
+// Double frame buffering swapped on vsync: LVGL direct mode without
+// rotation, rotation into the back frame buffer with it.
+#if LVGL_PORT_DIRECT_MODE && (LVGL_PORT_ROTATION_DEGREE == 0 || CONFIG_LVGL_PORT_ROTATE_INTO_FB)
+#define LVGL_PORT_DOUBLE_FB 1
+#else
+#define LVGL_PORT_DOUBLE_FB 0
+#endif
+#if LVGL_PORT_DOUBLE_FB
+#define LVGL_PORT_VSYNC_TIMEOUT_MS 100
+#define LVGL_PORT_DIRTY_AREAS 16
+// Two panel frame buffers: the panel scans one out while the other is drawn,
+// and they swap on vsync once a refresh is complete. Without rotation they
+// are LVGL's own direct-mode buffers and LVGL keeps them in sync; with
+// rotation flushed areas are rotated into the back one (s_panel_fb) and
+// s_dirty lists them, in panel coordinates, for copying after the swap.
+static uint8_t *s_fbs[2];
+static uint8_t s_back_fb;
+#if CONFIG_LVGL_PORT_ROTATE_INTO_FB
+static lv_area_t s_dirty[LVGL_PORT_DIRTY_AREAS];
+static uint32_t s_dirty_count;
+#endif
+static uint32_t s_vsync_timeouts;
+#endif
 static bool s_inited;
 
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+#define FRAME_WINDOW CONFIG_LVGL_PORT_FRAME_PROFILER_WINDOW
+
+typedef struct {
+    uint32_t end_ms;
+    uint32_t value[TouchScreen_frame_metric_count];
+} frame_sample_t;
+
+// Only touched with the LVGL lock held: the display events and flush_cb run
+// inside lv_timer_handler(), and UI ticks report in under the lock from
+// whichever task drives them.
+static frame_sample_t s_frames[FRAME_WINDOW];
+static uint32_t s_frame_total;     // frames recorded since boot
+static frame_sample_t s_frame_cur; // frame being rendered
+static uint32_t s_frame_flushes;
+static int64_t s_frame_refr_start_us;
+static bool s_frame_ready;         // refreshed, waiting for handler time
+static uint32_t s_frame_sorted[FRAME_WINDOW];
+static int64_t s_frame_log_us;
+
+static const char *const s_frame_metric_names[TouchScreen_frame_metric_count] = {
+    "handler us", "render us", "flush us", "rotated B", "invalid px", "vsync us", "synced B", "ui tick us",
+};
+
+static void frame_refr_start_cb(lv_event_t *e)
+{
+    (void)e;
+    s_frame_refr_start_us = esp_timer_get_time();
+}
+
+static void frame_invalidate_cb(lv_event_t *e)
+{
+    const lv_area_t *area = (const lv_area_t *)lv_event_get_param(e);
+    if (area) {
+        s_frame_cur.value[TouchScreen_frame_invalidated_px] += lv_area_get_size(area);
+    }
+}
+
+static void frame_refr_ready_cb(lv_event_t *e)
+{
+    (void)e;
+    if (s_frame_flushes == 0) {
+        // Idle refresh: keep the tick time for the next frame that draws.
+        s_frame_cur.value[TouchScreen_frame_invalidated_px] = 0;
+        return;
+    }
+    s_frame_cur.value[TouchScreen_frame_render_us] =
+        (uint32_t)(esp_timer_get_time() - s_frame_refr_start_us);
+    s_frame_ready = true;
+}
+
+// Closes the frame drawn by the lv_timer_handler() pass that took
+// `handler_us`, if any.
+static void frame_profiler_end_pass(uint32_t handler_us)
+{
+    if (!s_frame_ready) {
+        return;
+    }
+    s_frame_cur.value[TouchScreen_frame_handler_us] = handler_us;
+    s_frame_cur.end_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    s_frames[s_frame_total % FRAME_WINDOW] = s_frame_cur;
+    s_frame_total++;
+    memset(&s_frame_cur, 0, sizeof(s_frame_cur));
+    s_frame_flushes = 0;
+    s_frame_ready = false;
+}
+
+static int frame_cmp_u32(const void *a, const void *b)
+{
+    const uint32_t x = *(const uint32_t *)a;
+    const uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+bool TouchScreen_frame_stats(TouchScreen_frame_stats_t *dst)
+{
+    if (!dst) {
+        return false;
+    }
+    memset(dst, 0, sizeof(*dst));
+    const uint32_t n = s_frame_total < FRAME_WINDOW ? s_frame_total : FRAME_WINDOW;
+    dst->frames = n;
+    dst->total_frames = s_frame_total;
+#if LVGL_PORT_DOUBLE_FB
+    dst->vsync_timeouts = s_vsync_timeouts;
+#endif
+    if (n == 0) {
+        return false;
+    }
+    // Until the ring wraps the window is slots [0, n), afterwards all of it,
+    // so the order of the slots does not matter for the percentiles.
+    const frame_sample_t *newest = &s_frames[(s_frame_total - 1) % FRAME_WINDOW];
+    const frame_sample_t *oldest = &s_frames[(s_frame_total - n) % FRAME_WINDOW];
+    dst->window_ms = newest->end_ms - oldest->end_ms;
+    for (int m = 0; m < TouchScreen_frame_metric_count; m++) {
+        for (uint32_t i = 0; i < n; i++) {
+            s_frame_sorted[i] = s_frames[i].value[m];
+        }
+        qsort(s_frame_sorted, n, sizeof(s_frame_sorted[0]), frame_cmp_u32);
+        dst->metric[m].p50 = s_frame_sorted[(n - 1) * 50 / 100];
+        dst->metric[m].p95 = s_frame_sorted[(n - 1) * 95 / 100];
+        dst->metric[m].max = s_frame_sorted[n - 1];
+    }
+    return true;
+}
+
+void TouchScreen_frame_add_tick_us(uint32_t us)
+{
+    s_frame_cur.value[TouchScreen_frame_tick_us] += us;
+}
+
+const char *TouchScreen_frame_metric_name(TouchScreen_frame_metric_t metric)
+{
+    if ((int)metric < 0 || metric >= TouchScreen_frame_metric_count) {
+        return "?";
+    }
+    return s_frame_metric_names[metric];
+}
+
+static void frame_profiler_log(const TouchScreen_frame_stats_t *st)
+{
+    const uint32_t fps_x10 = st->window_ms ? (st->frames - 1) * 10000U / st->window_ms : 0;
+    ESP_LOGI(TAG, "frames: %u in window (%u.%u fps), %u since boot, %u vsync timeouts",
+             (unsigned)st->frames, (unsigned)(fps_x10 / 10), (unsigned)(fps_x10 % 10),
+             (unsigned)st->total_frames, (unsigned)st->vsync_timeouts);
+    for (int m = 0; m < TouchScreen_frame_metric_count; m++) {
+        ESP_LOGI(TAG, "  %-10s p50 %7u  p95 %7u  max %7u",
+                 s_frame_metric_names[m], (unsigned)st->metric[m].p50,
+                 (unsigned)st->metric[m].p95, (unsigned)st->metric[m].max);
+    }
+}
+#endif
+
 static void lvgl_tick_cb(void *arg)
 {
     (void)arg;
@@ -53,12 +220,343 @@ static inline uint32_t clamp_delay_ms(uint32_t delay_ms)
     return delay_ms;
 }
 
+// Makes CPU writes to frame buffer lines [y1, y2] visible to the panel. With
+// bounce buffers the panel driver reads the frame buffer through the cache
+// itself; without them the panel DMA reads PSRAM behind it.
+static inline void fb_write_back(uint8_t *fb, int32_t y1, int32_t y2)
+{
+#if CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT == 0
+    const size_t fb_stride = (size_t)LVGL_PORT_H_RES * sizeof(uint16_t);
+    esp_cache_msync(fb + (size_t)y1 * fb_stride, (size_t)(y2 - y1 + 1) * fb_stride,
+                    ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+#else
+    (void)fb;
+    (void)y1;
+    (void)y2;
+#endif
+}
+
+#if CONFIG_LVGL_PORT_ROTATE_INTO_FB
+// Rotates a rendered area straight to its place in the panel frame buffer:
+// one pass over the pixels instead of rotating into s_rot_buf and having
+// esp_lcd_panel_draw_bitmap() copy that into the frame buffer again.
+static void flush_rotate_into_fb(const lv_area_t *area, const lv_area_t *rotated_area,
+                                 const uint8_t *px_map, lv_display_rotation_t rotation,
+                                 lv_color_format_t cf)
+{
+    const uint32_t px_size = lv_color_format_get_size(cf);
+    const uint32_t fb_stride = (uint32_t)LVGL_PORT_H_RES * px_size;
+    const uint32_t src_stride = lv_draw_buf_width_to_stride(lv_area_get_width(area), cf);
+    uint8_t *first_line = s_panel_fb + (size_t)rotated_area->y1 * fb_stride;
+
+    lv_draw_sw_rotate(px_map, first_line + (size_t)rotated_area->x1 * px_size,
+                      lv_area_get_width(area), lv_area_get_height(area),
+                      src_stride, fb_stride, rotation, cf);
+    fb_write_back(s_panel_fb, rotated_area->y1, rotated_area->y2);
+}
+#endif
+
+#if LVGL_PORT_DOUBLE_FB
+// Shows `fb` from the next panel frame on and returns once the panel has
+// finished reading the previous one, so that one can be drawn again
+// without tearing.
+static void direct_swap_on_vsync(uint8_t *fb)
+{
+    esp_lcd_panel_draw_bitmap(s_lcd_handle, 0, 0, LVGL_PORT_H_RES, LVGL_PORT_V_RES, fb);
+    // A vsync that already passed belongs to the frame before the swap.
+    (void)ulTaskNotifyValueClear(NULL, UINT32_MAX);
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+    const int64_t wait_start_us = esp_timer_get_time();
+#endif
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LVGL_PORT_VSYNC_TIMEOUT_MS)) == 0) {
+        if (s_vsync_timeouts++ == 0) {
+            ESP_LOGW(TAG, "no vsync within %d ms of a frame buffer swap", LVGL_PORT_VSYNC_TIMEOUT_MS);
+        }
+    }
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+    s_frame_cur.value[TouchScreen_frame_vsync_us] += (uint32_t)(esp_timer_get_time() - wait_start_us);
+#endif
+}
+
+#if CONFIG_LVGL_PORT_ROTATE_INTO_FB
+static void direct_note_dirty(const lv_area_t *area)
+{
+    if (s_dirty_count < LVGL_PORT_DIRTY_AREAS) {
+        s_dirty[s_dirty_count++] = *area;
+        return;
+    }
+    // Out of slots: grow the last one. Consecutive flushes are usually
+    // adjacent strips of the same invalidated area.
+    lv_area_t *last = &s_dirty[LVGL_PORT_DIRTY_AREAS - 1];
+    lv_area_join(last, last, area);
+}
+
+// After a swap the new back buffer still shows the previous frame: bring
+// the areas drawn into the new front buffer across.
+static void direct_sync_back_buffer(void)
+{
+    const uint8_t *front = s_fbs[s_back_fb ^ 1];
+    uint8_t *back = s_fbs[s_back_fb];
+    const size_t fb_stride = (size_t)LVGL_PORT_H_RES * sizeof(uint16_t);
+    for (uint32_t i = 0; i < s_dirty_count; i++) {
+        const lv_area_t *a = &s_dirty[i];
+        const size_t offset = (size_t)a->y1 * fb_stride + (size_t)a->x1 * sizeof(uint16_t);
+        const size_t row_bytes = (size_t)lv_area_get_width(a) * sizeof(uint16_t);
+        for (int32_t y = a->y1; y <= a->y2; y++) {
+            const size_t row = offset + (size_t)(y - a->y1) * fb_stride;
+            memcpy(back + row, front + row, row_bytes);
+        }
+        fb_write_back(back, a->y1, a->y2);
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+        s_frame_cur.value[TouchScreen_frame_synced_bytes] += (uint32_t)(row_bytes * lv_area_get_height(a));
+#endif
+    }
+    s_dirty_count = 0;
+}
+#endif
+#endif
+
+// Touch input. A task reads the controller when its INT line fires (or on
+// a poll period) and publishes the point as one packed word; the LVGL read
+// callback only loads it, so rendering never waits on the I2C bus.
+#define TOUCH_POINT_PRESSED (1U << 31)
+#define TOUCH_POINT_XY(x, y) ((((uint32_t)(x) & 0xFFF) << 12) | ((uint32_t)(y) & 0xFFF))
+#define TOUCH_POINT_X(p) (((p) >> 12) & 0xFFF)
+#define TOUCH_POINT_Y(p) ((p) & 0xFFF)
+
+static lvgl_port_touch_read_fn_t s_touch_read;
+static int s_touch_int_gpio = -1;
+static TaskHandle_t s_touch_task_handle;
+static atomic_uint s_touch_point; // TOUCH_POINT_* packed, 0 = released at 0,0
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+// Low 32 bits of esp_timer_get_time() when the published point happened: the
+// INT edge that led to its read, or the start of a polled read.
+static atomic_uint s_touch_point_us;
+static volatile uint32_t s_touch_int_us;
+static uint32_t s_touch_pending_us; // seen by LVGL, not yet on screen
+static bool s_touch_pending;
+// Each half has a single writer: read counters belong to the touch task,
+// latency to the LVGL task (touch_read_cb / flush_cb). Only the 32-bit read
+// counters are read across tasks, which cannot tear.
+static struct {
+    volatile uint32_t reads;
+    volatile uint32_t int_wakeups;
+    volatile uint32_t read_errors;
+    volatile uint32_t read_us_max;
+} s_touch_reads;
+static struct {
+    uint32_t count;
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+} s_touch_latency;
+#endif
+
+static void IRAM_ATTR touch_int_isr(void *arg)
+{
+    (void)arg;
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+    s_touch_int_us = (uint32_t)esp_timer_get_time();
+#endif
+    BaseType_t need_yield = pdFALSE;
+    vTaskNotifyGiveFromISR(s_touch_task_handle, &need_yield);
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static esp_err_t lcd_touch_read(uint16_t *x, uint16_t *y, bool *pressed)
+{
+    esp_err_t err = esp_lcd_touch_read_data(s_touch_handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    uint16_t strength = 0;
+    uint8_t count = 0;
+    *pressed = esp_lcd_touch_get_coordinates(s_touch_handle, x, y, &strength, &count, 1) && count > 0;
+    return ESP_OK;
+}
+
+static void touch_task(void *arg)
+{
+    (void)arg;
+    uint32_t published = 0;
+    for (;;) {
+        // With an INT line, a released panel needs no reads until it fires.
+        // While pressed, poll too so a missed release edge cannot stick.
+        const bool wait_int = s_touch_int_gpio >= 0 && !(published & TOUCH_POINT_PRESSED);
+        const bool by_int = ulTaskNotifyTake(pdTRUE, wait_int ? portMAX_DELAY
+                                                              : pdMS_TO_TICKS(CONFIG_LVGL_PORT_TOUCH_POLL_MS)) > 0;
+        const int64_t read_start_us = esp_timer_get_time();
+        uint16_t x = 0;
+        uint16_t y = 0;
+        bool pressed = false;
+        const esp_err_t err = s_touch_read(&x, &y, &pressed);
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+        const uint32_t read_us = (uint32_t)(esp_timer_get_time() - read_start_us);
+        s_touch_reads.reads++;
+        s_touch_reads.int_wakeups += by_int ? 1 : 0;
+        if (read_us > s_touch_reads.read_us_max) {
+            s_touch_reads.read_us_max = read_us;
+        }
+#else
+        (void)read_start_us;
+        (void)by_int;
+#endif
+        if (err != ESP_OK) {
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+            s_touch_reads.read_errors++;
+#endif
+            continue;
+        }
+        const uint32_t point = pressed ? (TOUCH_POINT_PRESSED | TOUCH_POINT_XY(x, y))
+                                       : (published & ~TOUCH_POINT_PRESSED);
+        if (point == published) {
+            continue;
+        }
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+        atomic_store_explicit(&s_touch_point_us, by_int ? s_touch_int_us : (uint32_t)read_start_us,
+                              memory_order_relaxed);
+#endif
+        atomic_store_explicit(&s_touch_point, point, memory_order_release);
+        published = point;
+    }
+}
+
+static void touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    (void)indev;
+    const uint32_t point = atomic_load_explicit(&s_touch_point, memory_order_acquire);
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+    static uint32_t last;
+    if (point != last && !s_touch_pending) {
+        s_touch_pending_us = atomic_load_explicit(&s_touch_point_us, memory_order_relaxed);
+        s_touch_pending = true;
+    }
+    // Debug only: this runs in the LVGL task with the lock held.
+    if (point != last && !(point & TOUCH_POINT_PRESSED) && s_touch_latency.count > 0) {
+        ESP_LOGD(TAG, "touch to pixels: last %u us, avg %u us, max %u us (%u events), read max %u us",
+                 (unsigned)s_touch_latency.last_us, (unsigned)(s_touch_latency.sum_us / s_touch_latency.count),
+                 (unsigned)s_touch_latency.max_us, (unsigned)s_touch_latency.count,
+                 (unsigned)s_touch_reads.read_us_max);
+    }
+    last = point;
+#endif
+    data->point.x = (lv_coord_t)TOUCH_POINT_X(point);
+    data->point.y = (lv_coord_t)TOUCH_POINT_Y(point);
+    data->state = (point & TOUCH_POINT_PRESSED) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->continue_reading = false;
+}
+
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+// A frame went out after LVGL took in a touch change: charge the time since
+// the touch to it. Input that changes nothing on screen is charged to the
+// next frame drawn for whatever reason.
+static void touch_latency_frame_out(void)
+{
+    if (!s_touch_pending) {
+        return;
+    }
+    const uint32_t us = (uint32_t)esp_timer_get_time() - s_touch_pending_us;
+    s_touch_pending = false;
+    s_touch_latency.last_us = us;
+    s_touch_latency.sum_us += us;
+    s_touch_latency.count++;
+    if (us > s_touch_latency.max_us) {
+        s_touch_latency.max_us = us;
+    }
+}
+
+bool TouchScreen_touch_stats(TouchScreen_touch_stats_t *dst)
+{
+    if (!dst) {
+        return false;
+    }
+    dst->reads = s_touch_reads.reads;
+    dst->int_wakeups = s_touch_reads.int_wakeups;
+    dst->read_errors = s_touch_reads.read_errors;
+    dst->read_us_max = s_touch_reads.read_us_max;
+    dst->count = s_touch_latency.count;
+    dst->last_us = s_touch_latency.last_us;
+    dst->max_us = s_touch_latency.max_us;
+    dst->sum_us = s_touch_latency.sum_us;
+    return s_touch_latency.count > 0;
+}
+#endif
+
+// Creates the pointer input device and the task feeding it; the caller
+// holds the LVGL lock (or LVGL is not running yet).
+static esp_err_t touch_start(lvgl_port_touch_read_fn_t read, int int_gpio)
+{
+    if (s_touch_read) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_touch_indev = lv_indev_create();
+    if (!s_touch_indev) {
+        return ESP_FAIL;
+    }
+    lv_indev_set_type(s_touch_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(s_touch_indev, touch_read_cb);
+    s_touch_read = read;
+
+    BaseType_t core_id = LVGL_PORT_TASK_CORE < 0 ? tskNO_AFFINITY : LVGL_PORT_TASK_CORE;
+    if (xTaskCreatePinnedToCore(touch_task, "lvgl_touch", CONFIG_LVGL_PORT_TOUCH_TASK_STACK_SIZE, NULL,
+                                CONFIG_LVGL_PORT_TOUCH_TASK_PRIORITY, &s_touch_task_handle, core_id) != pdPASS) {
+        ESP_LOGE(TAG, "cannot create touch task");
+        return ESP_FAIL;
+    }
+
+    if (int_gpio >= 0) {
+        const gpio_config_t int_conf = {
+            .pin_bit_mask = 1ULL << int_gpio,
+            .mode = GPIO_MODE_INPUT,
+            .pull_up_en = GPIO_PULLUP_ENABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = GPIO_INTR_NEGEDGE,
+        };
+        esp_err_t err = gpio_config(&int_conf);
+        if (err == ESP_OK) {
+            err = gpio_install_isr_service(0);
+            if (err == ESP_ERR_INVALID_STATE) {
+                err = ESP_OK; // already installed
+            }
+        }
+        if (err == ESP_OK) {
+            err = gpio_isr_handler_add(int_gpio, touch_int_isr, NULL);
+        }
+        if (err == ESP_OK) {
+            s_touch_int_gpio = int_gpio;
+        } else {
+            ESP_LOGW(TAG, "touch INT on GPIO %d unusable (%s), polling", int_gpio, esp_err_to_name(err));
+        }
+    }
+    ESP_LOGI(TAG, "touch task started, %s", s_touch_int_gpio >= 0 ? "INT driven" : "polling");
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_touch_start(lvgl_port_touch_read_fn_t read, int int_gpio)
+{
+    if (!read) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!lvgl_port_lock(1000)) {
+        return ESP_ERR_TIMEOUT;
+    }
+    const esp_err_t err = touch_start(read, int_gpio);
+    lvgl_port_unlock();
+    return err;
+}
+
 static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
 {
     if (!s_lcd_handle) {
         lv_display_flush_ready(disp);
         return;
     }
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+    const int64_t flush_start_us = esp_timer_get_time();
+    const uint32_t vsync_before_us = s_frame_cur.value[TouchScreen_frame_vsync_us];
+#endif
 
     const lv_area_t *draw_area = area;
     uint8_t *draw_px = px_map;
@@ -76,6 +574,23 @@ static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
         int32_t src_h = lv_area_get_height(area);
 
         size_t needed = (size_t)dest_stride * (size_t)lv_area_get_height(&rotated_area);
+#if CONFIG_LVGL_PORT_ROTATE_INTO_FB
+        if (s_panel_fb) {
+            flush_rotate_into_fb(area, &rotated_area, px_map, rotation, cf);
+            draw_px = NULL; // already in place
+#if LVGL_PORT_DOUBLE_FB
+            if (s_fbs[1]) {
+                direct_note_dirty(&rotated_area);
+                if (lv_display_flush_is_last(disp)) {
+                    direct_swap_on_vsync(s_panel_fb);
+                    s_back_fb ^= 1;
+                    s_panel_fb = s_fbs[s_back_fb];
+                    direct_sync_back_buffer();
+                }
+            }
+#endif
+        } else
+#endif
         if (s_rot_buf && needed <= s_rot_buf_bytes) {
             lv_draw_sw_rotate(px_map, s_rot_buf, src_w, src_h, src_stride, dest_stride, rotation, cf);
             draw_area = &rotated_area;
@@ -84,50 +599,89 @@ static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
             ESP_LOGW(TAG, "rotation buffer too small (%u > %u), drawing unrotated",
                      (unsigned)needed, (unsigned)s_rot_buf_bytes);
         }
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+        if (draw_px != px_map) {
+            s_frame_cur.value[TouchScreen_frame_rotated_bytes] += (uint32_t)needed;
+        }
+#endif
     }
+#if LVGL_PORT_DOUBLE_FB && LVGL_PORT_ROTATION_DEGREE == 0
+    else if (s_fbs[1]) {
+        // LVGL drew straight into px_map, one of the frame buffers.
+        if (lv_display_flush_is_last(disp)) {
+            direct_swap_on_vsync(px_map);
+        }
+        draw_px = NULL;
+    }
+#endif
 
-    const int x1 = draw_area->x1;
-    const int y1 = draw_area->y1;
-    const int x2 = draw_area->x2 + 1;
-    const int y2 = draw_area->y2 + 1;
-    esp_lcd_panel_draw_bitmap(s_lcd_handle, x1, y1, x2, y2, draw_px);
+    if (draw_px) {
+        const int x1 = draw_area->x1;
+        const int y1 = draw_area->y1;
+        const int x2 = draw_area->x2 + 1;
+        const int y2 = draw_area->y2 + 1;
+        esp_lcd_panel_draw_bitmap(s_lcd_handle, x1, y1, x2, y2, draw_px);
+    }
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+    const uint32_t vsync_us = s_frame_cur.value[TouchScreen_frame_vsync_us] - vsync_before_us;
+    s_frame_cur.value[TouchScreen_frame_flush_us] +=
+        (uint32_t)(esp_timer_get_time() - flush_start_us) - vsync_us;
+    s_frame_flushes++;
+#endif
+#if CONFIG_LVGL_PORT_TOUCH_LATENCY
+    if (lv_display_flush_is_last(disp)) {
+        touch_latency_frame_out();
+    }
+#endif
     lv_display_flush_ready(disp);
 }
 
-static void touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
+#if LVGL_PORT_DOUBLE_FB
+// Takes the panel's two frame buffers. False (partial rendering is used
+// instead) when the panel was created with fewer, e.g. by the boot display.
+static bool setup_frame_buffers(void)
 {
-    (void)indev;
-    static lv_coord_t last_x;
-    static lv_coord_t last_y;
-
-    data->state = (lv_indev_state_t)0;
-    data->point.x = last_x;
-    data->point.y = last_y;
-    data->continue_reading = false;
-
-    if (!s_touch_handle) {
-        return;
-    }
-
-    esp_lcd_touch_read_data(s_touch_handle);
-
-    uint16_t x[1] = {0};
-    uint16_t y[1] = {0};
-    uint16_t strength[1] = {0};
-    uint8_t count = 0;
-
-    bool pressed = esp_lcd_touch_get_coordinates(s_touch_handle, x, y, strength, &count, 1);
-    if (pressed && count > 0) {
-        last_x = (lv_coord_t)x[0];
-        last_y = (lv_coord_t)y[0];
-        data->point.x = last_x;
-        data->point.y = last_y;
-        data->state = (lv_indev_state_t)1;
+    void *fb0 = NULL;
+    void *fb1 = NULL;
+    if (esp_lcd_rgb_panel_get_frame_buffer(s_lcd_handle, 2, &fb0, &fb1) != ESP_OK || !fb0 || !fb1) {
+        ESP_LOGW(TAG, "panel has no second frame buffer, direct mode disabled");
+        return false;
     }
+    s_fbs[0] = (uint8_t *)fb0;
+    s_fbs[1] = (uint8_t *)fb1;
+    s_back_fb = 1; // the panel starts out showing fb0
+    return true;
 }
+#endif
 
 static esp_err_t setup_display_buffers(void)
 {
+#if LVGL_PORT_DOUBLE_FB
+    if (setup_frame_buffers()) {
+#if LVGL_PORT_ROTATION_DEGREE == 0
+        const size_t fb_bytes = (size_t)LVGL_PORT_H_RES * LVGL_PORT_V_RES *
+                                lv_color_format_get_size(lv_display_get_color_format(s_display));
+        lv_display_set_buffers(s_display, s_fbs[0], s_fbs[1], fb_bytes, LV_DISPLAY_RENDER_MODE_DIRECT);
+        ESP_LOGI(TAG, "direct mode, double frame buffer swapped on vsync");
+        return ESP_OK;
+#else
+        s_panel_fb = s_fbs[s_back_fb];
+        ESP_LOGI(TAG, "rotating into the back frame buffer, swapped on vsync");
+#endif
+    }
+#endif
+#if CONFIG_LVGL_PORT_ROTATE_INTO_FB
+    if (!s_panel_fb) {
+        void *panel_fb = NULL;
+        if (esp_lcd_rgb_panel_get_frame_buffer(s_lcd_handle, 1, &panel_fb) == ESP_OK && panel_fb) {
+            s_panel_fb = (uint8_t *)panel_fb;
+            ESP_LOGI(TAG, "rotating flushed areas straight into the RGB frame buffer");
+        } else {
+            ESP_LOGW(TAG, "no RGB frame buffer, rotating through a bounce copy");
+        }
+    }
+#endif
+
     const uint32_t line_count = LVGL_PORT_BUFFER_HEIGHT;
     const size_t buf_pixels = (size_t)LVGL_PORT_H_RES * line_count;
     const size_t buf_bytes = buf_pixels * sizeof(lv_color_t);
@@ -146,6 +700,14 @@ static esp_err_t setup_display_buffers(void)
         return ESP_ERR_NO_MEM;
     }
 
+#if CONFIG_LVGL_PORT_ROTATE_INTO_FB
+    if (s_panel_fb) {
+        // Rotation writes straight into the frame buffer, no bounce copy.
+        lv_display_set_buffers(s_display, s_draw_buf_1, s_draw_buf_2, buf_bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
+        return ESP_OK;
+    }
+#endif
+
     s_rot_buf = heap_caps_malloc(buf_bytes, LVGL_PORT_BUFFER_MALLOC_CAPS);
     if (!s_rot_buf) {
         ESP_LOGE(TAG, "rotation buf alloc failed (%u bytes)", (unsigned)buf_bytes);
@@ -166,10 +728,31 @@ static void lvgl_task(void *arg)
     (void)arg;
     while (true) {
         uint32_t delay_ms = LVGL_PORT_TASK_MIN_DELAY_MS;
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+        TouchScreen_frame_stats_t log_stats;
+        bool log_due = false;
+        if (lvgl_port_lock(-1)) {
+            const int64_t start_us = esp_timer_get_time();
+            delay_ms = lv_timer_handler();
+            const int64_t end_us = esp_timer_get_time();
+            frame_profiler_end_pass((uint32_t)(end_us - start_us));
+            if (CONFIG_LVGL_PORT_FRAME_PROFILER_LOG_S > 0 &&
+                end_us - s_frame_log_us >= (int64_t)CONFIG_LVGL_PORT_FRAME_PROFILER_LOG_S * 1000000) {
+                s_frame_log_us = end_us;
+                log_due = TouchScreen_frame_stats(&log_stats);
+            }
+            lvgl_port_unlock();
+        }
+        // Printed outside the lock so the UART does not stall rendering.
+        if (log_due) {
+            frame_profiler_log(&log_stats);
+        }
+#else
         if (lvgl_port_lock(-1)) {
             delay_ms = lv_timer_handler();
             lvgl_port_unlock();
         }
+#endif
         delay_ms = clamp_delay_ms(delay_ms);
 
         (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(delay_ms));
@@ -194,6 +777,11 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
         return ESP_FAIL;
     }
     lv_display_set_flush_cb(s_display, flush_cb);
+#if CONFIG_LVGL_PORT_FRAME_PROFILER
+    lv_display_add_event_cb(s_display, frame_refr_start_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(s_display, frame_invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_add_event_cb(s_display, frame_refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+#endif
 
     esp_err_t err = setup_display_buffers();
     if (err != ESP_OK) {
@@ -211,12 +799,10 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
 #endif
 
     if (s_touch_handle) {
-        s_touch_indev = lv_indev_create();
-        if (!s_touch_indev) {
-            return ESP_FAIL;
+        err = touch_start(lcd_touch_read, s_touch_handle->config.int_gpio_num);
+        if (err != ESP_OK) {
+            return err;
         }
-        lv_indev_set_type(s_touch_indev, LV_INDEV_TYPE_POINTER);
-        lv_indev_set_read_cb(s_touch_indev, touch_read_cb);
     }
 
     s_lvgl_mux = xSemaphoreCreateRecursiveMutex();
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "esp_err.h"
@@ -41,7 +42,8 @@ extern "C" {
 /**
  *
  * LVGL buffer related parameters, can be adjusted by users:
- *  (These parameters will be useless if the avoid tearing function is enabled)
+ *  (Unused only when LVGL draws straight into the frame buffers, i.e. avoid
+ *   tearing mode 3 without rotation)
  *
  *  - Memory type for buffer allocation:
  *      - MALLOC_CAP_SPIRAM: Allocate LVGL buffer in PSRAM
@@ -115,7 +117,8 @@ extern "C" {
 #elif LVGL_PORT_ROTATION_DEGREE == 270
 #define LVGL_PORT_ROTATION_270  (1)
 #endif
-#ifdef LVGL_PORT_LCD_RGB_BUFFER_NUMS
+/* Direct mode rotating into the back frame buffer still needs only two. */
+#if defined(LVGL_PORT_LCD_RGB_BUFFER_NUMS) && !(LVGL_PORT_DIRECT_MODE && CONFIG_LVGL_PORT_ROTATE_INTO_FB)
 #undef LVGL_PORT_LCD_RGB_BUFFER_NUMS
 #define LVGL_PORT_LCD_RGB_BUFFER_NUMS   (3)
 #endif
@@ -139,6 +142,32 @@ extern "C" {
  */
 esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle_t tp_handle);
 
+/**
+ * @brief Reads one point from a touch controller
+ *
+ * Runs in the touch task, never in the LVGL task, so it may block on I2C.
+ *
+ * @param[out] x, y: Point in panel coordinates, only used when pressed
+ * @param[out] pressed: Whether the panel is being touched
+ */
+typedef esp_err_t (*lvgl_port_touch_read_fn_t)(uint16_t *x, uint16_t *y, bool *pressed);
+
+/**
+ * @brief Registers a pointer input device fed by a touch task
+ *
+ * The task calls `read` on each falling edge of the controller's interrupt
+ * line `int_gpio` (-1: every CONFIG_LVGL_PORT_TOUCH_POLL_MS), and also at
+ * that period while pressed, and publishes the point lock-free for the LVGL
+ * read callback. lvgl_port_init() already does this for its touch handle;
+ * only one touch device is supported. Call after lvgl_port_init().
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: A touch device is already registered
+ *      - Others: Fail
+ */
+esp_err_t lvgl_port_touch_start(lvgl_port_touch_read_fn_t read, int int_gpio);
+
 /**
  * @brief Take LVGL mutex
  *
@@ -6,27 +6,183 @@
 
 #include "waveshare_rgb_lcd_port.h"
 #include "esp_err.h"
+#include "esp_timer.h"
+#if CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT == 0
+#include "esp_cache.h"
+#endif
 #include <string.h>
 
 static const char *TAG = "waveshare_rgb_lcd_port";
 static esp_lcd_panel_handle_t s_panel_handle = NULL;
 static bool s_panel_initialized = false;
 static bool s_lvgl_initialized = false;
+static bool s_panel_mirrored = false; // mirror set on the panel (boot: 180º)
 
 /* Keep boot/no-LVGL display as light as possible on internal DMA RAM usage. */
+#if LVGL_PORT_DIRECT_MODE
+/* LVGL reuses this panel; direct mode needs its frame buffers (PSRAM). */
+#define BOOT_RGB_NUM_FBS LVGL_PORT_LCD_RGB_BUFFER_NUMS
+#else
 #define BOOT_RGB_NUM_FBS 1
+#endif
 #define BOOT_RGB_BOUNCE_BUFFER_LINES 2
 #define BOOT_RGB_BOUNCE_BUFFER_SIZE_PX                                         \
   (LCD_H_RES * BOOT_RGB_BOUNCE_BUFFER_LINES)
 
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+// Scan-out monitor. on_vsync marks the start of every scanned frame. With
+// bounce buffers, on_bounce_frame_finish marks when the refill interrupt
+// copied the last line of a frame out of PSRAM, which happens at a fixed
+// offset from vsync as long as refills keep up. A refill later than one
+// bounce buffer leaves refill and scan a buffer apart from then on, i.e. a
+// shifted picture, and moves that offset by a buffer's scan time.
+#define SCAN_LINE_PX                                                           \
+  (LCD_H_RES + CONFIG_TOUCHSCREEN_LCD_HSYNC_PULSE_WIDTH +                      \
+   CONFIG_TOUCHSCREEN_LCD_HSYNC_BACK_PORCH +                                   \
+   CONFIG_TOUCHSCREEN_LCD_HSYNC_FRONT_PORCH)
+#define SCAN_FRAME_LINES                                                       \
+  (LCD_V_RES + CONFIG_TOUCHSCREEN_LCD_VSYNC_PULSE_WIDTH +                      \
+   CONFIG_TOUCHSCREEN_LCD_VSYNC_BACK_PORCH +                                   \
+   CONFIG_TOUCHSCREEN_LCD_VSYNC_FRONT_PORCH)
+#define SCAN_LINES_US(lines)                                                   \
+  ((int32_t)((uint64_t)SCAN_LINE_PX * (lines) * 1000000ULL /                   \
+             LCD_PIXEL_CLOCK_HZ))
+#define SCAN_FRAME_US SCAN_LINES_US(SCAN_FRAME_LINES)
+#define SCAN_BOUNCE_US SCAN_LINES_US(CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT)
+
+static volatile uint32_t s_scan_frames;
+static volatile uint32_t s_scan_frame_us_max;
+static int64_t s_scan_vsync_us;
+#if RGB_BOUNCE_BUFFER_SIZE > 0
+static volatile uint32_t s_scan_slips;
+static int32_t s_scan_phase_us = -1; // refill end after vsync, -1 to relearn
+static volatile uint32_t s_scan_settle; // frames to skip after a restart
+#endif
+#if CONFIG_TOUCHSCREEN_LCD_RESTART_ON_SLIP
+static volatile bool s_scan_restart_pending;
+static uint32_t s_scan_restarts;
+static esp_timer_handle_t s_scan_timer;
+#endif
+
+IRAM_ATTR static void scan_monitor_vsync(void) {
+  const int64_t now = esp_timer_get_time();
+  if (s_scan_vsync_us) {
+    const uint32_t us = (uint32_t)(now - s_scan_vsync_us);
+    if (us > s_scan_frame_us_max) {
+      s_scan_frame_us_max = us;
+    }
+  }
+  s_scan_vsync_us = now;
+  s_scan_frames++;
+}
+
+#if RGB_BOUNCE_BUFFER_SIZE > 0
+IRAM_ATTR static void scan_monitor_refill_done(void) {
+  if (!s_scan_vsync_us) {
+    return;
+  }
+#if CONFIG_TOUCHSCREEN_LCD_RESTART_ON_SLIP
+  if (s_scan_restart_pending) {
+    return;
+  }
+#endif
+  if (s_scan_settle) {
+    s_scan_settle--;
+    s_scan_phase_us = -1;
+    return;
+  }
+  const uint32_t since_vsync =
+      (uint32_t)(esp_timer_get_time() - s_scan_vsync_us);
+  const int32_t phase = (int32_t)(since_vsync % (uint32_t)SCAN_FRAME_US);
+  if (s_scan_phase_us < 0) {
+    s_scan_phase_us = phase;
+    return;
+  }
+  int32_t drift = phase - s_scan_phase_us;
+  if (drift > SCAN_FRAME_US / 2) {
+    drift -= SCAN_FRAME_US;
+  } else if (drift < -SCAN_FRAME_US / 2) {
+    drift += SCAN_FRAME_US;
+  }
+  // Interrupt latency moves it by microseconds; a slip by a whole buffer.
+  if (drift > SCAN_BOUNCE_US / 2 || drift < -SCAN_BOUNCE_US / 2) {
+    s_scan_slips++;
+    s_scan_phase_us = phase;
+#if CONFIG_TOUCHSCREEN_LCD_RESTART_ON_SLIP
+    // Pending holds off detection until the restart ran, so the one-shot
+    // is never armed twice (esp_timer_start_once() is ISR-safe).
+    s_scan_restart_pending = true;
+    if (esp_timer_start_once(s_scan_timer, 0) != ESP_OK) {
+      s_scan_restart_pending = false;
+    }
+#endif
+  }
+}
+#endif
+
+#if CONFIG_TOUCHSCREEN_LCD_RESTART_ON_SLIP
+// esp_lcd_rgb_panel_restart() is not callable from the ISR, so a slip arms
+// this one-shot; the driver restarts the scan on the next vsync.
+static void scan_restart_timer_cb(void *arg) {
+  if (s_panel_handle && esp_lcd_rgb_panel_restart(s_panel_handle) == ESP_OK) {
+    s_scan_restarts++;
+  }
+  s_scan_settle = 2;
+  s_scan_restart_pending = false;
+}
+#endif
+
+bool waveshare_esp32_s3_rgb_lcd_scan_stats(TouchScreen_panel_stats_t *dst) {
+  if (!dst || !s_lvgl_initialized) {
+    return false;
+  }
+  memset(dst, 0, sizeof(*dst));
+  dst->frames = s_scan_frames;
+  // Reset races with the ISR; at worst one frame is left out of the max.
+  dst->frame_us_max = s_scan_frame_us_max;
+  s_scan_frame_us_max = 0;
+  dst->frame_us = (uint32_t)SCAN_FRAME_US;
+#if RGB_BOUNCE_BUFFER_SIZE > 0
+  dst->slips = s_scan_slips;
+  dst->slip_us = (uint32_t)SCAN_BOUNCE_US;
+#endif
+#if CONFIG_TOUCHSCREEN_LCD_RESTART_ON_SLIP
+  dst->restarts = s_scan_restarts;
+#endif
+  dst->frame_buffers = LVGL_PORT_LCD_RGB_BUFFER_NUMS;
+  dst->bounce_lines = CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT;
+  dst->pixel_clock_hz = LCD_PIXEL_CLOCK_HZ;
+  dst->scan_bytes_per_s = (uint32_t)((uint64_t)LCD_H_RES * LCD_V_RES *
+                                     (RGB_BIT_PER_PIXEL / 8) * 1000000ULL /
+                                     SCAN_FRAME_US);
+  return true;
+}
+#endif
+
 // VSYNC event callback function
 IRAM_ATTR static bool
 rgb_lcd_on_vsync_event(esp_lcd_panel_handle_t panel,
                        const esp_lcd_rgb_panel_event_data_t *edata,
                        void *user_ctx) {
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR && RGB_BOUNCE_BUFFER_SIZE > 0
+  scan_monitor_refill_done();
+#elif CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+  scan_monitor_vsync();
+#endif
   return lvgl_port_notify_rgb_vsync();
 }
 
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR && RGB_BOUNCE_BUFFER_SIZE > 0
+// With bounce buffers LVGL follows the refill, this only feeds the monitor.
+IRAM_ATTR static bool
+rgb_lcd_on_scan_vsync(esp_lcd_panel_handle_t panel,
+                      const esp_lcd_rgb_panel_event_data_t *edata,
+                      void *user_ctx) {
+  scan_monitor_vsync();
+  return false;
+}
+#endif
+
 #if CONFIG_LCD_TOUCH_CONTROLLER_GT911
 /**
  * @brief I2C master initialization
@@ -147,7 +303,7 @@ esp_err_t waveshare_esp32_s3_rgb_lcd_init() {
       .bounce_buffer_size_px =
           RGB_BOUNCE_BUFFER_SIZE,         // Bounce buffer size in pixels
       .sram_trans_align = 4,              // SRAM transaction alignment
-      .psram_trans_align = 64,            // PSRAM transaction alignment
+      .psram_trans_align = RGB_PSRAM_TRANS_ALIGN, // PSRAM transaction alignment
       .hsync_gpio_num = LCD_IO_RGB_HSYNC, // GPIO number for horizontal sync
       .vsync_gpio_num = LCD_IO_RGB_VSYNC, // GPIO number for vertical sync
       .de_gpio_num = LCD_IO_RGB_DE,       // GPIO number for data enable
@@ -245,12 +401,25 @@ esp_err_t waveshare_esp32_s3_rgb_lcd_init() {
       tp_handle)); // Initialize LVGL with the panel and touch handles
   /* Reset display mirror to upright */
   ESP_ERROR_CHECK(esp_lcd_panel_mirror(panel_handle, false, false));
+  s_panel_mirrored = false;
+
+#if CONFIG_TOUCHSCREEN_LCD_RESTART_ON_SLIP
+  // Armed from the refill ISR, so it must exist before the callbacks.
+  const esp_timer_create_args_t scan_timer_args = {
+      .callback = scan_restart_timer_cb,
+      .name = "lcd_scan",
+  };
+  ESP_ERROR_CHECK(esp_timer_create(&scan_timer_args, &s_scan_timer));
+#endif
 
   // Register callbacks for RGB panel events
   esp_lcd_rgb_panel_event_callbacks_t cbs = {
 #if RGB_BOUNCE_BUFFER_SIZE > 0
       .on_bounce_frame_finish =
           rgb_lcd_on_vsync_event, // Callback for bounce frame finish
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+      .on_vsync = rgb_lcd_on_scan_vsync, // Scan monitor only
+#endif
 #else
       .on_vsync = rgb_lcd_on_vsync_event, // Callback for vertical sync
 #endif
@@ -297,7 +466,7 @@ esp_err_t waveshare_esp32_s3_rgb_lcd_init_nolvgl() {
       .num_fbs = BOOT_RGB_NUM_FBS,
       .bounce_buffer_size_px = BOOT_RGB_BOUNCE_BUFFER_SIZE_PX,
       .sram_trans_align = 4,
-      .psram_trans_align = 64,
+      .psram_trans_align = RGB_PSRAM_TRANS_ALIGN,
       .hsync_gpio_num = LCD_IO_RGB_HSYNC,
       .vsync_gpio_num = LCD_IO_RGB_VSYNC,
       .de_gpio_num = LCD_IO_RGB_DE,
@@ -351,33 +520,99 @@ esp_err_t waveshare_esp32_s3_rgb_lcd_init_nolvgl() {
 
   s_panel_handle = panel_handle;
   s_panel_initialized = true;
+  s_panel_mirrored = true;
   panel_backlight_enable();
   return ESP_OK;
 }
 
-static esp_err_t lcd_draw_hline(int x, int y, int w, uint16_t color) {
-  if (!s_panel_initialized || !s_panel_handle) {
-    return ESP_ERR_INVALID_STATE;
+/*
+ * Boot display drawing goes straight into the panel frame buffer instead of
+ * through esp_lcd_panel_draw_bitmap(). Before LVGL starts nothing swaps
+ * frame buffers, so the first one is the one being scanned out. The panel
+ * driver only applies mirroring when copying bitmaps, so it is applied here:
+ * coordinates are logical (upright) and mapped to the frame buffer.
+ */
+static uint16_t *boot_fb(void) {
+  static uint16_t *fb = NULL;
+  if (!fb && s_panel_handle) {
+    void *fb0 = NULL;
+    if (esp_lcd_rgb_panel_get_frame_buffer(s_panel_handle, 1, &fb0) ==
+        ESP_OK)
+      fb = (uint16_t *)fb0;
   }
-  if (w <= 0)
-    return ESP_OK;
+  return fb;
+}
 
-  static uint16_t *row = NULL;
-  static int row_cap = 0;
-  if (row_cap < w) {
-    uint16_t *new_row = (uint16_t *)heap_caps_realloc(row, sizeof(uint16_t) * w,
-                                                      MALLOC_CAP_8BIT);
-    if (!new_row) {
-      return ESP_ERR_NO_MEM;
-    }
-    row = new_row;
-    row_cap = w;
+// Frame buffer address of the logical span [x, x + w) on line y.
+static inline uint16_t *boot_fb_span(uint16_t *fb, int x, int y, int w) {
+  if (s_panel_mirrored) {
+    x = LCD_H_RES - x - w;
+    y = LCD_V_RES - 1 - y;
   }
-  for (int i = 0; i < w; i++)
-    row[i] = color;
-  return esp_lcd_panel_draw_bitmap(s_panel_handle, x, y, x + w, y + 1, row);
+  return fb + (size_t)y * LCD_H_RES + x;
 }
 
+// Makes CPU writes to logical lines [y, y + h) visible to the panel. With
+// bounce buffers the driver reads the frame buffer through the cache.
+static void boot_fb_write_back(uint16_t *fb, int y, int h) {
+#if CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT == 0
+  if (s_panel_mirrored)
+    y = LCD_V_RES - y - h;
+  esp_cache_msync(fb + (size_t)y * LCD_H_RES,
+                  (size_t)h * LCD_H_RES * sizeof(uint16_t),
+                  ESP_CACHE_MSYNC_FLAG_DIR_C2M |
+                      ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+#else
+  (void)fb;
+  (void)y;
+  (void)h;
+#endif
+}
+
+// Fills n RGB565 pixels, two per 32-bit store. Colours with equal bytes
+// (black, white) go through memset, which newlib does word-wide already.
+static void boot_fill_px(uint16_t *dst, size_t n, uint16_t color) {
+  if ((color >> 8) == (color & 0xFF)) {
+    memset(dst, color & 0xFF, n * sizeof(uint16_t));
+    return;
+  }
+  if (n > 0 && ((uintptr_t)dst & 2)) {
+    *dst++ = color;
+    n--;
+  }
+  const uint32_t pair = ((uint32_t)color << 16) | color;
+  uint32_t *d = (uint32_t *)dst;
+  size_t pairs = n >> 1;
+  for (; pairs >= 4; pairs -= 4, d += 4) {
+    d[0] = pair;
+    d[1] = pair;
+    d[2] = pair;
+    d[3] = pair;
+  }
+  while (pairs--)
+    *d++ = pair;
+  if (n & 1)
+    *(uint16_t *)d = color;
+}
+
+// Fills an already clipped logical rectangle. Full-width rectangles are
+// contiguous in the frame buffer and filled in one go.
+static void boot_fb_rect(uint16_t *fb, int x, int y, int w, int h,
+                         uint16_t color) {
+  if (w <= 0 || h <= 0)
+    return;
+  if (w == LCD_H_RES) {
+    const int first = s_panel_mirrored ? y + h - 1 : y;
+    boot_fill_px(boot_fb_span(fb, 0, first, w), (size_t)w * h, color);
+  } else {
+    for (int yy = y; yy < y + h; yy++)
+      boot_fill_px(boot_fb_span(fb, x, yy, w), (size_t)w, color);
+  }
+  boot_fb_write_back(fb, y, h);
+}
+
+static void boot_text_invalidate(void);
+
 esp_err_t waveshare_esp32_s3_rgb_lcd_fill_rect(int x, int y, int w, int h,
                                                uint16_t color) {
   if (!s_panel_initialized || !s_panel_handle) {
@@ -403,11 +638,11 @@ esp_err_t waveshare_esp32_s3_rgb_lcd_fill_rect(int x, int y, int w, int h,
   if (w <= 0 || h <= 0)
     return ESP_OK;
 
-  for (int yy = y; yy < y + h; yy++) {
-    esp_err_t err = lcd_draw_hline(x, yy, w, color);
-    if (err != ESP_OK)
-      return err;
-  }
+  uint16_t *fb = boot_fb();
+  if (!fb)
+    return ESP_ERR_INVALID_STATE;
+  boot_text_invalidate();
+  boot_fb_rect(fb, x, y, w, h, color);
   return ESP_OK;
 }
 
@@ -551,89 +786,192 @@ static const uint8_t *font5x7(char c) {
   }
 }
 
+#define BOOT_TEXT_MAX_LINES 16
+#define BOOT_TEXT_MAX_SCALE 6
+#define BOOT_TEXT_CACHE_LEN 256
+
+typedef struct {
+  const char *start[BOOT_TEXT_MAX_LINES];
+  int len[BOOT_TEXT_MAX_LINES];
+  int lines;
+  int max_len;
+} boot_text_lines_t;
+
+/*
+ * Glyph atlas: every 5-pixel font row is one of 32 bit patterns, so for the
+ * current scale and colours each pattern is prebuilt as a full pixel row of
+ * a character cell (glyph plus spacing column, already mirrored). A glyph is
+ * then 7 * scale row copies. The last text drawn is kept so a redraw with
+ * the same layout only repaints the lines that changed (e.g. OTA progress).
+ */
+static struct {
+  bool atlas_ok;
+  bool mirrored;
+  int scale;
+  uint16_t fg;
+  uint16_t bg;
+  uint16_t rows[32][6 * BOOT_TEXT_MAX_SCALE];
+  bool shown; // the screen shows `text` laid out with the values above
+  char text[BOOT_TEXT_CACHE_LEN];
+  boot_text_lines_t lines;
+} s_boot_text;
+
+static void boot_text_invalidate(void) { s_boot_text.shown = false; }
+
+// Splits text into lines; lines past BOOT_TEXT_MAX_LINES are not shown.
+static void boot_text_split(const char *text, boot_text_lines_t *t) {
+  t->lines = 0;
+  t->max_len = 0;
+  const char *s = text;
+  for (;;) {
+    const char *nl = strchr(s, '\n');
+    int len = nl ? (int)(nl - s) : (int)strlen(s);
+    if (t->lines < BOOT_TEXT_MAX_LINES) {
+      t->start[t->lines] = s;
+      t->len[t->lines] = len;
+      t->lines++;
+      if (len > t->max_len)
+        t->max_len = len;
+    }
+    if (!nl)
+      break;
+    s = nl + 1;
+  }
+}
+
+static void boot_text_build_atlas(int scale, uint16_t fg, uint16_t bg) {
+  if (s_boot_text.atlas_ok && s_boot_text.scale == scale &&
+      s_boot_text.fg == fg && s_boot_text.bg == bg &&
+      s_boot_text.mirrored == s_panel_mirrored)
+    return;
+  const int cell = 6 * scale;
+  for (int bits = 0; bits < 32; bits++) {
+    uint16_t *row = s_boot_text.rows[bits];
+    for (int k = 0; k < cell; k++) {
+      int col = (s_panel_mirrored ? cell - 1 - k : k) / scale;
+      row[k] = (col < 5 && (bits & (1 << (4 - col)))) ? fg : bg;
+    }
+  }
+  s_boot_text.atlas_ok = true;
+  s_boot_text.mirrored = s_panel_mirrored;
+  s_boot_text.scale = scale;
+  s_boot_text.fg = fg;
+  s_boot_text.bg = bg;
+  s_boot_text.shown = false;
+}
+
+// Paints the 7 * scale lines of one text line from logical line y_line,
+// each pixel written once: background margins plus atlas rows.
+static void boot_text_draw_line(uint16_t *fb, const char *s, int len,
+                                int y_line) {
+  const int scale = s_boot_text.scale;
+  const int cell = 6 * scale;
+  const uint16_t bg = s_boot_text.bg;
+  int x0 = (len > 0) ? (LCD_H_RES - (len * cell - scale)) / 2 : LCD_H_RES;
+  if (x0 < 0)
+    x0 = 0;
+  if (len > (LCD_H_RES - x0 + cell - 1) / cell)
+    len = (LCD_H_RES - x0 + cell - 1) / cell; // clipped at the right edge
+  int x1 = x0 + len * cell;
+  if (x1 > LCD_H_RES)
+    x1 = LCD_H_RES;
+  int h = 7 * scale;
+  if (y_line + h > LCD_V_RES)
+    h = LCD_V_RES - y_line;
+
+  const uint8_t *glyphs[LCD_H_RES / 6 + 1];
+  for (int j = 0; j < len; j++) {
+    char c = s[j];
+    if (c >= 'a' && c <= 'z')
+      c = (char)(c - 'a' + 'A');
+    glyphs[j] = font5x7(c);
+  }
+
+  for (int i = 0; i < h; i++) {
+    const int y = y_line + i;
+    const int r = i / scale;
+    boot_fill_px(boot_fb_span(fb, 0, y, x0), (size_t)x0, bg);
+    for (int j = 0; j < len; j++) {
+      const int gx = x0 + j * cell;
+      const int w = (gx + cell > LCD_H_RES) ? LCD_H_RES - gx : cell;
+      const uint16_t *src = s_boot_text.rows[glyphs[j][r]];
+      if (s_panel_mirrored)
+        src += cell - w;
+      memcpy(boot_fb_span(fb, gx, y, w), src, (size_t)w * sizeof(uint16_t));
+    }
+    boot_fill_px(boot_fb_span(fb, x1, y, LCD_H_RES - x1),
+                 (size_t)(LCD_H_RES - x1), bg);
+  }
+  boot_fb_write_back(fb, y_line, h);
+}
+
 esp_err_t waveshare_esp32_s3_rgb_lcd_draw_center_text(const char *text,
                                                       uint16_t fg,
                                                       uint16_t bg) {
   if (!text)
     return ESP_ERR_INVALID_ARG;
-  esp_err_t err = waveshare_esp32_s3_rgb_lcd_clear(bg);
-  if (err != ESP_OK)
-    return err;
+  if (!s_panel_initialized || !s_panel_handle)
+    return ESP_ERR_INVALID_STATE;
+  uint16_t *fb = boot_fb();
+  if (!fb)
+    return ESP_ERR_INVALID_STATE;
 
-  size_t len = strlen(text);
-  if (len == 0)
+  boot_text_lines_t t;
+  boot_text_split(text, &t);
+  if (t.max_len <= 0) {
+    boot_text_invalidate();
+    boot_fb_rect(fb, 0, 0, LCD_H_RES, LCD_V_RES, bg);
     return ESP_OK;
-
-  int lines = 1;
-  int cur_len = 0;
-  int max_line_len = 0;
-  for (size_t i = 0; i < len; i++) {
-    if (text[i] == '\n') {
-      if (cur_len > max_line_len)
-        max_line_len = cur_len;
-      cur_len = 0;
-      lines++;
-    } else {
-      cur_len++;
-    }
   }
-  if (cur_len > max_line_len)
-    max_line_len = cur_len;
-  if (max_line_len <= 0)
-    return ESP_OK;
 
-  int scale_w = (LCD_H_RES - 20) / ((max_line_len * 6) - 1);
-  int total_rows = (lines * 7) + (lines - 1);
+  int scale_w = (LCD_H_RES - 20) / ((t.max_len * 6) - 1);
+  int total_rows = (t.lines * 7) + (t.lines - 1);
   int scale_h = (LCD_V_RES - 20) / total_rows;
   int scale = scale_w < scale_h ? scale_w : scale_h;
   if (scale < 1)
     scale = 1;
-  if (scale > 6)
-    scale = 6;
+  if (scale > BOOT_TEXT_MAX_SCALE)
+    scale = BOOT_TEXT_MAX_SCALE;
 
-  int text_h = (lines * 7 * scale) + ((lines - 1) * scale);
+  int text_h = (t.lines * 7 * scale) + ((t.lines - 1) * scale);
   int y0 = (LCD_V_RES - text_h) / 2;
   if (y0 < 0)
     y0 = 0;
 
-  int line = 0;
-  int line_len = 0;
-  int line_start = 0;
-  for (size_t i = 0; i <= len; i++) {
-    bool line_end = (i == len) || (text[i] == '\n');
-    if (!line_end) {
-      line_len++;
+  const int64_t t0 = esp_timer_get_time();
+  boot_text_build_atlas(scale, fg, bg);
+  const bool partial =
+      s_boot_text.shown && s_boot_text.lines.lines == t.lines;
+  int drawn = 0;
+  int prev_end = 0;
+  for (int l = 0; l < t.lines; l++) {
+    const int y_line = y0 + l * 8 * scale;
+    if (y_line >= LCD_V_RES)
+      break;
+    if (partial && s_boot_text.lines.len[l] == t.len[l] &&
+        memcmp(s_boot_text.lines.start[l], t.start[l], (size_t)t.len[l]) ==
+            0)
       continue;
-    }
-
-    int text_w = (line_len > 0) ? ((line_len * 6 * scale) - scale) : 0;
-    int x0 = (LCD_H_RES - text_w) / 2;
-    if (x0 < 0)
-      x0 = 0;
-    int y_line = y0 + line * (8 * scale);
-
-    for (int j = 0; j < line_len; j++) {
-      char c = text[line_start + j];
-      if (c >= 'a' && c <= 'z')
-        c = (char)(c - 'a' + 'A');
-      const uint8_t *g = font5x7(c);
-      int gx = x0 + j * (6 * scale);
-      for (int r = 0; r < 7; r++) {
-        uint8_t row = g[r];
-        for (int col = 0; col < 5; col++) {
-          if (row & (1 << (4 - col))) {
-            err = waveshare_esp32_s3_rgb_lcd_fill_rect(
-                gx + col * scale, y_line + r * scale, scale, scale, fg);
-            if (err != ESP_OK)
-              return err;
-          }
-        }
-      }
-    }
+    if (!partial)
+      boot_fb_rect(fb, 0, prev_end, LCD_H_RES, y_line - prev_end, bg);
+    boot_text_draw_line(fb, t.start[l], t.len[l], y_line);
+    prev_end = y_line + 7 * scale;
+    if (prev_end > LCD_V_RES)
+      prev_end = LCD_V_RES;
+    drawn++;
+  }
+  if (!partial)
+    boot_fb_rect(fb, 0, prev_end, LCD_H_RES, LCD_V_RES - prev_end, bg);
+  ESP_LOGD(TAG, "boot text: %d/%d lines %s in %lld us", drawn, t.lines,
+           partial ? "updated" : "drawn",
+           (long long)(esp_timer_get_time() - t0));
 
-    line++;
-    line_start = (int)i + 1;
-    line_len = 0;
+  // Keep a copy to diff the next call against (too long: full redraw).
+  size_t len = strlen(text);
+  s_boot_text.shown = len < sizeof(s_boot_text.text);
+  if (s_boot_text.shown) {
+    memcpy(s_boot_text.text, text, len + 1);
+    boot_text_split(s_boot_text.text, &s_boot_text.lines);
   }
   return ESP_OK;
 }
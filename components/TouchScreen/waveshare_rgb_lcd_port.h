@@ -12,6 +12,7 @@
 #include "esp_lcd_touch_gt911.h"
 #include "lv_demos.h"
 #include "lvgl_port.h"
+#include "TouchScreen.h"
 
 
 #define I2C_MASTER_SCL_IO           CONFIG_TOUCHSCREEN_TOUCH_I2C_SCL_GPIO
@@ -34,6 +35,7 @@
 #define RGB_BIT_PER_PIXEL       (16)
 #define RGB_DATA_WIDTH          (16)
 #define RGB_BOUNCE_BUFFER_SIZE  (LCD_H_RES * CONFIG_LCD_RGB_BOUNCE_BUFFER_HEIGHT)
+#define RGB_PSRAM_TRANS_ALIGN   (CONFIG_TOUCHSCREEN_LCD_PSRAM_TRANS_ALIGN)
 #define LCD_IO_RGB_DISP         (-1)             // -1 if not used
 #define LCD_IO_RGB_VSYNC        ((gpio_num_t)CONFIG_TOUCHSCREEN_LCD_RGB_VSYNC_GPIO)
 #define LCD_IO_RGB_HSYNC        ((gpio_num_t)CONFIG_TOUCHSCREEN_LCD_RGB_HSYNC_GPIO)
@@ -71,6 +73,10 @@ esp_err_t waveshare_esp32_s3_rgb_lcd_draw_center_text(const char *text, uint16_t
 int waveshare_esp32_s3_rgb_lcd_width(void);
 int waveshare_esp32_s3_rgb_lcd_height(void);
 
+#if CONFIG_TOUCHSCREEN_LCD_SCAN_MONITOR
+bool waveshare_esp32_s3_rgb_lcd_scan_stats(TouchScreen_panel_stats_t *dst);
+#endif
+
 esp_err_t wavesahre_rgb_lcd_bl_on();
 esp_err_t wavesahre_rgb_lcd_bl_off();
 
@@ -269,6 +269,7 @@ static void boot_fsm_init_on_reset_reason(void)
 static char ble_device_name[20];
 
 #define NETVARS_CMD_RESPONSE_LEN 249
+#define MAIN_COMPOSE_PAYLOAD_MAX CONFIG_MAIN_DATA_PAYLOAD_MAX
 
 bool main_req_parse_callback(const char *data, int len, char *response);
 bool main_parse_callback(const char *data, int len, char *response);
@@ -1041,52 +1042,66 @@ app_main_return_code run_components(void)
 bool main_parse_callback(const char *data, int len, char *response)
 {
     ESP_LOGI(TAG, "Parsing the CFG payload %d %.*s", len, len, data);
+    // Parse once and hand the same tree to every component.
+    int64_t t0 = esp_timer_get_time();
+    size_t heap0 = esp_get_free_heap_size();
+    cJSON *root = cJSON_ParseWithLength(data, (size_t)len);
+    if (!root)
+    {
+        ESP_LOGW(TAG, "CFG payload is not valid JSON");
+        sprintf(response, "c ok");
+        return true;
+    }
+    size_t heap_tree = heap0 - esp_get_free_heap_size();
 #ifdef CONFIG_PORIS_ENABLE_PRJCFG
-    PrjCfg_config_parse_json(data);
+    PrjCfg_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_MEASUREMENT
-    Measurement_config_parse_json(data);
+    Measurement_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_MQTTCOMM
-    MQTTComm_config_parse_json(data);
+    MQTTComm_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_OTA
-    OTA_config_parse_json(data);
+    OTA_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_DUALLED
-    DualLED_config_parse_json(data);
+    DualLED_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_DUALLEDTESTER
-    DualLedTester_config_parse_json(data);
+    DualLedTester_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_RELAYS
-    Relays_config_parse_json(data);
+    Relays_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_RELAYSTEST
-    RelaysTest_config_parse_json(data);
+    RelaysTest_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_UDPCOMM
-    UDPComm_config_parse_json(data);
+    UDPComm_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_WIFI
-    Wifi_config_parse_json(data);
+    Wifi_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_TOUCHSCREEN
-    TouchScreen_config_parse_json(data);
+    TouchScreen_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_BLEPERIPHERAL
-    BlePeripheral_config_parse_json(data);
+    BlePeripheral_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_ADCPROBES
-    ADCProbes_config_parse_json(data);
+    ADCProbes_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_LCDFLAG
-    LCDFlag_config_parse_json(data);
+    LCDFlag_config_parse_json_root(root);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_PPINJECTORUI
-    PPInjectorUI_config_parse_json(data);
+    PPInjectorUI_config_parse_json_root(root);
 #endif
 // [PORIS_INTEGRATION_NETVARS_PARSE]
+    cJSON_Delete(root);
+    ESP_LOGI(TAG, "CFG applied in %" PRId64 " us, JSON tree %u bytes",
+             esp_timer_get_time() - t0, (unsigned)heap_tree);
     sprintf(response, "c ok");
     return true;
 }
@@ -1094,76 +1109,72 @@ bool main_parse_callback(const char *data, int len, char *response)
 static uint32_t msg_counter = 0;
 void main_compose_callback(char *data, int *len)
 {
-    sprintf((char *)data, "this is a payload (%lu)", msg_counter++);
-    *len = strlen((char *)data);
-    ESP_LOGI(TAG, "Composing the DATA payload %d %.*s", *len, *len, data);
-
-    cJSON *root = cJSON_CreateObject();
+    // Stream straight into the caller's buffer: no cJSON tree, no heap. The
+    // callback carries no size, so the bound is MQTTComm's buffer as
+    // configured in CONFIG_MAIN_DATA_PAYLOAD_MAX.
+    NetVars_json_writer_t jw;
+    NetVars_jw_init(&jw, data, MAIN_COMPOSE_PAYLOAD_MAX, NULL, NULL);
+    NetVars_jw_begin_object(&jw, NULL);
 #ifdef CONFIG_PORIS_ENABLE_PRJCFG
-    PrjCfg_netvars_append_json(root);
+    PrjCfg_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_MEASUREMENT
-    Measurement_netvars_append_json(root);
+    Measurement_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_MQTTCOMM
-    MQTTComm_netvars_append_json(root);
+    MQTTComm_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_OTA
-    OTA_netvars_append_json(root);
+    OTA_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_DUALLED
-    DualLED_netvars_append_json(root);
+    DualLED_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_DUALLEDTESTER
-    DualLedTester_netvars_append_json(root);
+    DualLedTester_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_RELAYS
-    Relays_netvars_append_json(root);
+    Relays_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_RELAYSTEST
-    RelaysTest_netvars_append_json(root);
+    RelaysTest_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_UDPCOMM
-    UDPComm_netvars_append_json(root);
+    UDPComm_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_WIFI
-    Wifi_netvars_append_json(root);
+    Wifi_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_TOUCHSCREEN
-    TouchScreen_netvars_append_json(root);
+    TouchScreen_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_BLEPERIPHERAL
-    BlePeripheral_netvars_append_json(root);
+    BlePeripheral_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_ADCPROBES
-    ADCProbes_netvars_append_json(root);
+    ADCProbes_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_LCDFLAG
-    LCDFlag_netvars_append_json(root);
+    LCDFlag_netvars_write_json(&jw);
 #endif
 #ifdef CONFIG_PORIS_ENABLE_PPINJECTORUI
-    PPInjectorUI_netvars_append_json(root);
+    PPInjectorUI_netvars_write_json(&jw);
 #endif
 // [PORIS_INTEGRATION_NETVARS_APPEND]
+    NetVars_jw_end_object(&jw);
 
-    char *cPayload = cJSON_PrintUnformatted(root);
-    if (cPayload != NULL)
+    if (NetVars_jw_finish(&jw))
     {
-        size_t length = strlen(cPayload);
-        *len = (int)length;
-        ESP_LOGI(TAG, "LEN %d", length);
-        ESP_LOGI(TAG, "Payload %s", cPayload);
-        memcpy(data, cPayload, length);
-        data[length] = '\0';
-        free(cPayload);
+        *len = (int)jw.total;
+        ESP_LOGD(TAG, "DATA payload %d bytes: %s", *len, data);
     }
     else
     {
+        ESP_LOGW(TAG, "DATA payload exceeds %d bytes", MAIN_COMPOSE_PAYLOAD_MAX);
         data[0] = 'a';
         data[1] = '\0';
         *len = 1;
     }
-    cJSON_Delete(root);
 }
 
 void i_compose_callback(char *data, int *len)
@@ -1434,6 +1445,10 @@ void app_main(void)
     }
 #endif
 
+#if CONFIG_NETVARS_PARSE_BENCH
+    NetVars_config_parse_benchmark(CONFIG_NETVARS_PARSE_BENCH_MESSAGES);
+#endif
+
     if (init_components() != app_main_ret_ok)
     {
         ESP_LOGE(TAG, "Cannot init components!!!");
@@ -95,13 +95,13 @@ def main():
         ]),
         "netvars_parse": "\n".join([
             f"#ifdef {en_macro}",
-            f"    {name}_config_parse_json(data);",
+            f"    {name}_config_parse_json_root(root);",
             "#endif",
             ""
         ]),
         "netvars_append": "\n".join([
             f"#ifdef {en_macro}",
-            f"    {name}_netvars_append_json(root);",
+            f"    {name}_netvars_write_json(&jw);",
             "#endif",
             ""
         ]),
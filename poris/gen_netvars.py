@@ -7,6 +7,13 @@ import re
 MARKER = "// [PORIS_INTEGRATION_NETVARS]"
 
 
+def upper_sanitized(name: str) -> str:
+    # Same rule new_component.py uses for the $#1 placeholder.
+    u = re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+    u = re.sub(r"_+", "_", u).strip("_")
+    return u or "COMPONENT"
+
+
 def storage_to_enum(storage_type: str) -> str:
     storage_type = (storage_type or "").strip().upper()
     mapping = {
@@ -203,6 +210,56 @@ def render_desc_fragment(mod: str, rows):
     return entries
 
 
+def render_index_fragment(mod: str, rows):
+    """Position enum + json_key index for <mod>_netvars_desc[].
+
+    Positions are emitted under the same enablers as the descriptor
+    fragment, so the preprocessor keeps both in sync. The index lists the
+    positions of every keyed descriptor in strcmp() order of json_key; ties
+    keep table order so lookups still resolve to the first match.
+    """
+    prefix = f"{upper_sanitized(mod)}_NETVARS_POS_"
+    named = [r for r in rows if r["name"]]
+
+    lines = ["enum {"]
+    current_enabler = None
+    for r in named:
+        enabler = r["enabler"]
+        if enabler != current_enabler:
+            if current_enabler:
+                lines.append("#endif")
+            if enabler:
+                lines.append(f"#ifdef {enabler}")
+            current_enabler = enabler
+        lines.append(f"    {prefix}{r['name']},")
+    if current_enabler:
+        lines.append("#endif")
+    lines.append(f"    {prefix}COUNT")
+    lines.append("};")
+    lines.append("")
+
+    keyed = [(r["json_key"].encode("utf-8"), i, r) for i, r in enumerate(named) if r["json_key"]]
+    keyed.sort(key=lambda k: (k[0], k[1]))
+    seen = {}
+    for key, _, r in keyed:
+        if key in seen:
+            print(f"WARNING: {mod}: json_key '{key.decode()}' used by '{seen[key]}' and '{r['name']}'; "
+                  f"parsing only reaches the first one", file=sys.stderr)
+        else:
+            seen[key] = r["name"]
+
+    lines.append(f"// Positions in {mod}_netvars_desc[] sorted by json_key (strcmp order)")
+    lines.append(f"const uint16_t {mod}_netvars_key_index[] = {{")
+    for key, _, r in keyed:
+        if r["enabler"]:
+            lines.append(f"#ifdef {r['enabler']}")
+        lines.append(f"    {prefix}{r['name']}, // \"{key.decode()}\"")
+        if r["enabler"]:
+            lines.append("#endif")
+    lines.append("};")
+    return lines
+
+
 def apply_marker(out_path: Path, generated_lines, default_header_lines):
     if out_path.exists():
         template_text = out_path.read_text(encoding="utf-8")
@@ -250,6 +307,7 @@ def main():
 
     fragment_path = include_dir / f"{mod}_netvar_types_fragment.h_"
     c_fragment_path = comp_dir / f"{mod}_netvars_fragment.c_"
+    index_fragment_path = comp_dir / f"{mod}_netvars_index_fragment.c_"
 
     type_header = [
         f"// Auto-generated fragment for {mod} netvars",
@@ -265,7 +323,15 @@ def main():
     ]
 
     apply_marker(fragment_path, render_types_fragment(rows), type_header)
+    index_header = [
+        f"// Auto-generated fragment for {mod} netvars",
+        f"// Included from {mod}_netvars.c, right after {mod}_netvars_desc[]",
+        "// DO NOT EDIT MANUALLY; edit netvars.csv and regenerate.",
+        "",
+    ]
+
     apply_marker(c_fragment_path, render_desc_fragment(mod, rows), desc_header)
+    apply_marker(index_fragment_path, render_index_fragment(mod, rows), index_header)
 
 
 if __name__ == "__main__":
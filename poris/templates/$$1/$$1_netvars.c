@@ -1,3 +1,4 @@
+#include <assert.h>
 #include <string.h>
 #include <$$1.h>
 #include "$$1_netvars.h"
@@ -10,6 +11,13 @@ const NetVars_desc_t $$1_netvars_desc[] = {
 
 const size_t $$1_netvars_count = sizeof($$1_netvars_desc) / sizeof($$1_netvars_desc[0]);
 
+#include "$$1_netvars_index_fragment.c_"
+
+const size_t $$1_netvars_key_index_count = sizeof($$1_netvars_key_index) / sizeof($$1_netvars_key_index[0]);
+
+_Static_assert(sizeof($$1_netvars_desc) / sizeof($$1_netvars_desc[0]) == $#1_NETVARS_POS_COUNT,
+               "$$1_netvars_index_fragment.c_ is out of date; rerun poris/gen_netvars.py $$1");
+
 void $$1_netvars_append_json(cJSON *root)
 {
     if ($$1_netvars_count > 0)
@@ -18,11 +26,21 @@ void $$1_netvars_append_json(cJSON *root)
     }
 }
 
+void $$1_netvars_write_json(NetVars_json_writer_t *w)
+{
+    if ($$1_netvars_count > 0)
+    {
+        NetVars_write_json_component("$$1", $$1_netvars_desc, $$1_netvars_count, w);
+    }
+}
+
 bool $$1_netvars_parse_json_dict(cJSON *root)
 {
     if ($$1_netvars_count > 0)
     {
-        return NetVars_parse_json_dict($$1_netvars_desc, $$1_netvars_count, root);
+        return NetVars_parse_json_dict_indexed($$1_netvars_desc, $$1_netvars_count,
+                                               $$1_netvars_key_index, $$1_netvars_key_index_count, root,
+                                               &$$1_nvs_mgr);
     }
     else
     {
@@ -32,6 +50,10 @@ bool $$1_netvars_parse_json_dict(cJSON *root)
 
 void $$1_netvars_nvs_load(void)
 {
+    // Runs once at component init: a stale index fragment would make lookups
+    // miss keys silently, so debug builds stop here instead.
+    assert(NetVars_key_index_check("$$1", $$1_netvars_desc, $$1_netvars_count,
+                                   $$1_netvars_key_index, $$1_netvars_key_index_count));
     if ($$1_netvars_count > 0)
     {
         NetVars_nvs_load_component("$$1", $$1_netvars_desc, $$1_netvars_count);
@@ -46,14 +68,26 @@ void $$1_netvars_nvs_save(void)
     }
 }
 
-void $$1_config_parse_json(const char *data)
+void $$1_config_parse_json_root(cJSON *root)
 {
     if ($$1_netvars_count > 0)
     {
-        bool nvs_cfg_changed = NetVars_parse_json_component_data("$$1", $$1_netvars_desc, $$1_netvars_count, data);
-        if (nvs_cfg_changed)
+        // Changed NVS-backed descriptors are marked dirty one by one.
+        (void)NetVars_parse_json_component_indexed("$$1", $$1_netvars_desc, $$1_netvars_count,
+                                                   $$1_netvars_key_index, $$1_netvars_key_index_count, root,
+                                                   &$$1_nvs_mgr);
+    }
+}
+
+void $$1_config_parse_json(const char *data)
+{
+    if ($$1_netvars_count > 0 && data)
+    {
+        cJSON *root = cJSON_Parse(data);
+        if (root)
         {
-            $$1_nvs_set_dirty();
+            $$1_config_parse_json_root(root);
+            cJSON_Delete(root);
         }
     }
 }
@@ -65,8 +99,13 @@ void $$1_nvs_set_dirty(void)
 
 void $$1_nvs_spin(void)
 {
-    if (NetVars_nvs_spin(&$$1_nvs_mgr))
+    if ($$1_netvars_count > 0)
     {
-        $$1_netvars_nvs_save();
+        (void)NetVars_nvs_spin_component("$$1", $$1_netvars_desc, $$1_netvars_count, &$$1_nvs_mgr);
     }
 }
+
+const netvars_nvs_stats_t *$$1_nvs_stats(void)
+{
+    return &$$1_nvs_mgr.stats;
+}
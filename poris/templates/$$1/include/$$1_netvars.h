@@ -16,11 +16,15 @@ void $$1_netvars_nvs_load(void);
 void $$1_netvars_nvs_save(void);
 
 void $$1_netvars_append_json(cJSON *root);
+void $$1_netvars_write_json(NetVars_json_writer_t *w);
 bool $$1_netvars_parse_json_dict(cJSON *root);
 
+// Apply this component's section of an already parsed config document.
+void $$1_config_parse_json_root(cJSON *root);
 void $$1_config_parse_json(const char *data);
 void $$1_nvs_set_dirty(void);
 void $$1_nvs_spin(void);
+const netvars_nvs_stats_t *$$1_nvs_stats(void);
 
 #ifdef __cplusplus
 }
@@ -5,12 +5,19 @@ RS485 test tool for PPInjectorUI protocol.
 Usage examples:
   python3 scripts/rs485_ppinjector_test.py --port /dev/ttyUSB0 --mode machine
   python3 scripts/rs485_ppinjector_test.py --port COM5 --baud 115200 --mode monitor
+  python3 scripts/rs485_ppinjector_test.py --port /dev/ttyUSB0 --no-binary
+
+In machine mode the tool answers "PROTO|BIN|1" with "PROTO_OK|BIN|1" and then
+speaks the binary framed protocol (see components/PPInjectorUI/include/
+PPInjectorUI_binproto.h). Lines typed with /send are converted to the
+matching binary message while binary mode is active.
 """
 
 from __future__ import annotations
 
 import argparse
 import queue
+import struct
 import sys
 import threading
 import time
@@ -33,6 +40,231 @@ SAFE_STATES = [
     "CONFIRM_REMOVAL",
 ]
 
+PROTO_REQ = "PROTO|BIN|1"
+PROTO_ACK = "PROTO_OK|BIN|1"
+
+BIN_MAX_PAYLOAD = 128
+BIN_MAX_FRAME = BIN_MAX_PAYLOAD + 3 + (BIN_MAX_PAYLOAD + 3) // 254 + 2
+
+MSG_QUERY_MOULD = 0x01
+MSG_QUERY_COMMON = 0x02
+MSG_QUERY_STATE = 0x03
+MSG_QUERY_ERROR = 0x04
+MSG_CMD_GOTO = 0x05
+MSG_CMD_TOGGLE = 0x06
+MSG_MOULD = 0x07
+MSG_COMMON = 0x08
+MSG_SUB = 0x09
+MSG_TEXT = 0x7F
+MSG_ENC = 0x81
+MSG_TEMP = 0x82
+MSG_STATE = 0x83
+MSG_EOD = 0x84
+MSG_ERROR = 0x85
+MSG_MOULD_OK = 0x86
+MSG_COMMON_OK = 0x87
+MSG_STATUS = 0x88
+MSG_ENC_DELTA = 0x89
+
+SUB_CHANNELS = ["ENC", "TEMP"]
+ENC_DELTA_UNIT = 0.001  # turns per ENCD count
+ENC_KEYFRAME_PERIOD = 1.0  # seconds between ENC keyframes while streaming
+
+QUERY_TYPES = {
+    "QUERY_MOULD": MSG_QUERY_MOULD,
+    "QUERY_COMMON": MSG_QUERY_COMMON,
+    "QUERY_STATE": MSG_QUERY_STATE,
+    "QUERY_ERROR": MSG_QUERY_ERROR,
+}
+
+MOULD_STRUCT = struct.Struct("<32s11f2sf")
+COMMON_STRUCT = struct.Struct("<2f2I8f2I")
+STATUS_STRUCT = struct.Struct("<2fHB24s")
+
+
+def crc16_ccitt(data: bytes) -> int:
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data: bytes) -> bytes:
+    out = bytearray([0])
+    code_idx = 0
+    code = 1
+    for b in data:
+        if b != 0:
+            out.append(b)
+            code += 1
+        if b == 0 or code == 0xFF:
+            out[code_idx] = code
+            code = 1
+            code_idx = len(out)
+            out.append(0)
+    out[code_idx] = code
+    return bytes(out)
+
+
+def cobs_decode(data: bytes) -> bytes | None:
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        block = data[i:i + code - 1]
+        if 0 in block:
+            return None
+        out += block
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(msg_type: int, payload: bytes = b"") -> bytes:
+    raw = bytes([msg_type]) + payload
+    raw += struct.pack("<H", crc16_ccitt(raw))
+    return cobs_encode(raw) + b"\x00"
+
+
+def decode_frame(block: bytes) -> tuple[int, bytes] | None:
+    raw = cobs_decode(block)
+    if raw is None or len(raw) < 3:
+        return None
+    if crc16_ccitt(raw[:-2]) != struct.unpack("<H", raw[-2:])[0]:
+        return None
+    return raw[0], raw[1:-2]
+
+
+def _fixed(text: str, width: int) -> bytes:
+    return text.encode("utf-8")[:width].ljust(width, b"\x00")
+
+
+def _unfixed(raw: bytes) -> str:
+    return raw.split(b"\x00", 1)[0].decode("utf-8", errors="replace")
+
+
+def pack_mould(record: str) -> bytes:
+    f = (record.split("|") + [""] * 14)[:14]
+    floats = [float(v or 0) for v in f[1:12]]
+    return MOULD_STRUCT.pack(_fixed(f[0], 32), *floats, _fixed(f[12], 2), float(f[13] or 0))
+
+
+def unpack_mould(payload: bytes) -> str:
+    v = MOULD_STRUCT.unpack(payload)
+    floats = "|".join(f"{x:.3f}" for x in v[1:12])
+    return f"{_unfixed(v[0])}|{floats}|{_unfixed(v[12])}|{v[13]:.3f}"
+
+
+def pack_common(record: str) -> bytes:
+    f = (record.split("|") + ["0"] * 14)[:14]
+    return COMMON_STRUCT.pack(
+        float(f[0]), float(f[1]), int(f[2]), int(f[3]),
+        *[float(x) for x in f[4:12]], int(f[12]), int(f[13]),
+    )
+
+
+def unpack_common(payload: bytes) -> str:
+    v = COMMON_STRUCT.unpack(payload)
+    return "|".join(f"{x:.3f}" if isinstance(x, float) else str(x) for x in v)
+
+
+def line_to_frame(line: str) -> bytes:
+    """Binary equivalent of a protocol line; TEXT frame if there is none."""
+    parts = line.split("|")
+    cmd = parts[0].strip().upper()
+    rest = line.split("|", 1)[1] if "|" in line else ""
+    try:
+        if cmd in QUERY_TYPES:
+            return encode_frame(QUERY_TYPES[cmd])
+        if cmd == "ENC":
+            if len(parts) >= 3:
+                return encode_frame(MSG_ENC, struct.pack("<fB", float(parts[1]), int(parts[2]) & 0xFF))
+            return encode_frame(MSG_ENC, struct.pack("<f", float(rest)))
+        if cmd == "ENCD":
+            return encode_frame(MSG_ENC_DELTA, struct.pack("<Bh", int(parts[1]) & 0xFF, int(parts[2])))
+        if cmd == "SUB" and len(parts) >= 4:
+            channel = SUB_CHANNELS.index(parts[1].upper())
+            return encode_frame(MSG_SUB, struct.pack("<BHf", channel, int(parts[2]), float(parts[3])))
+        if cmd == "TEMP":
+            return encode_frame(MSG_TEMP, struct.pack("<f", float(rest)))
+        if cmd == "STATE":
+            return encode_frame(MSG_STATE, rest.encode("utf-8"))
+        if cmd == "EOD":
+            return encode_frame(MSG_EOD, bytes([1 if int(rest or 0) else 0]))
+        if cmd == "ERROR":
+            code, _, msg = rest.partition("|")
+            return encode_frame(MSG_ERROR, struct.pack("<H", int(code or "0", 16)) + msg.encode("utf-8"))
+        if cmd == "MOULD_OK":
+            return encode_frame(MSG_MOULD_OK, pack_mould(rest))
+        if cmd == "COMMON_OK":
+            return encode_frame(MSG_COMMON_OK, pack_common(rest))
+        if cmd == "MOULD":
+            return encode_frame(MSG_MOULD, pack_mould(rest))
+        if cmd == "COMMON":
+            return encode_frame(MSG_COMMON, pack_common(rest))
+        if cmd == "CMD" and len(parts) >= 3 and parts[1].upper() in ("GOTO", "TOGGLE"):
+            msg_type = MSG_CMD_GOTO if parts[1].upper() == "GOTO" else MSG_CMD_TOGGLE
+            return encode_frame(msg_type, "|".join(parts[2:]).encode("utf-8"))
+    except (ValueError, struct.error):
+        pass
+    return encode_frame(MSG_TEXT, line.encode("utf-8"))
+
+
+def frame_to_line(msg_type: int, payload: bytes) -> str:
+    """Text protocol rendering of a decoded frame (for logs and the responder)."""
+    text = payload.decode("utf-8", errors="replace")
+    try:
+        for name, value in QUERY_TYPES.items():
+            if msg_type == value:
+                return name
+        if msg_type == MSG_CMD_GOTO:
+            return f"CMD|GOTO|{text}"
+        if msg_type == MSG_CMD_TOGGLE:
+            return f"CMD|TOGGLE|{text}"
+        if msg_type == MSG_MOULD:
+            return f"MOULD|{unpack_mould(payload)}"
+        if msg_type == MSG_COMMON:
+            return f"COMMON|{unpack_common(payload)}"
+        if msg_type == MSG_TEXT:
+            return text
+        if msg_type == MSG_ENC:
+            if len(payload) >= 5:
+                turns, seq = struct.unpack("<fB", payload[:5])
+                return f"ENC|{turns:.3f}|{seq}"
+            return f"ENC|{struct.unpack('<f', payload)[0]:.3f}"
+        if msg_type == MSG_ENC_DELTA:
+            seq, delta = struct.unpack("<Bh", payload[:3])
+            return f"ENCD|{seq}|{delta}"
+        if msg_type == MSG_SUB:
+            channel, rate, deadband = struct.unpack("<BHf", payload[:7])
+            return f"SUB|{SUB_CHANNELS[channel]}|{rate}|{deadband:.3f}"
+        if msg_type == MSG_TEMP:
+            return f"TEMP|{struct.unpack('<f', payload)[0]:.1f}"
+        if msg_type == MSG_STATE:
+            return f"STATE|{text}"
+        if msg_type == MSG_EOD:
+            return f"EOD|{payload[0]}"
+        if msg_type == MSG_ERROR:
+            code = struct.unpack("<H", payload[:2])[0]
+            return f"ERROR|{code:04X}|{payload[2:].decode('utf-8', errors='replace')}"
+        if msg_type == MSG_MOULD_OK:
+            return f"MOULD_OK|{unpack_mould(payload)}"
+        if msg_type == MSG_COMMON_OK:
+            return f"COMMON_OK|{unpack_common(payload)}"
+        if msg_type == MSG_STATUS:
+            turns, temp, code, flags, state = STATUS_STRUCT.unpack(payload)
+            return f"STATUS|{turns:.3f}|{temp:.1f}|{code:04X}|{flags & 1}|{_unfixed(state)}"
+    except (struct.error, IndexError):
+        pass
+    return f"<frame type=0x{msg_type:02X} len={len(payload)}>"
+
 
 @dataclass
 class MachineModel:
@@ -42,7 +274,7 @@ class MachineModel:
     error_code_hex: str = "0000"
     error_msg: str = ""
     mould_ok: str = (
-        "Default|10.0|20.0|30.0|4.0|5.0|6.0|7.0|8.0|9.0|10.0|11.0|12.0|2D|13.0"
+        "Default|10.0|20.0|30.0|4.0|5.0|6.0|7.0|8.0|9.0|10.0|11.0|2D|13.0"
     )
     common_ok: str = (
         "1.0|2.0|300|50|4.0|5.0|6.0|7.0|8.0|9.0|10.0|11.0|12|13"
@@ -50,29 +282,68 @@ class MachineModel:
 
 
 class RS485Tester:
-    def __init__(self, port: str, baud: int, timeout: float, mode: str, telemetry_period: float) -> None:
+    def __init__(
+        self,
+        port: str,
+        baud: int,
+        timeout: float,
+        mode: str,
+        telemetry_period: float,
+        allow_binary: bool = True,
+    ) -> None:
         self.port = port
         self.baud = baud
         self.timeout = timeout
         self.mode = mode
         self.telemetry_period = telemetry_period
+        self.allow_binary = allow_binary
+        self.binary = False
+        self._tx_lock = threading.Lock()
 
         self.ser = serial.Serial(port=self.port, baudrate=self.baud, timeout=self.timeout)
         self.model = MachineModel()
+        self._init_streaming()
         self._stop = threading.Event()
         self._rx_q: queue.Queue[str] = queue.Queue()
 
+    def _init_streaming(self) -> None:
+        # SUB state, per channel: {"rate": Hz, "deadband": units, "last_tx": t, "last": value}
+        self.subs: dict[str, dict[str, float]] = {}
+        self.enc_seq = 0
+        self.enc_sent_counts = 0
+        self.enc_last_key = 0.0
+        self.last_state_sent = ""
+
     def close(self) -> None:
         self._stop.set()
         if self.ser.is_open:
             self.ser.close()
 
+    def _write(self, data: bytes) -> None:
+        with self._tx_lock:
+            self.ser.write(data)
+            self.ser.flush()
+
     def send_line(self, line: str) -> None:
-        payload = (line.rstrip("\r\n") + "\n").encode("utf-8")
-        self.ser.write(payload)
-        self.ser.flush()
+        line = line.rstrip("\r\n")
+        if self.binary:
+            frame = line_to_frame(line)
+            self._write(frame)
+            print(f"[TX] {line} (bin {len(frame)}B)")
+            return
+        self._write((line + "\n").encode("utf-8"))
         print(f"[TX] {line}")
 
+    def send_status(self) -> None:
+        payload = STATUS_STRUCT.pack(
+            self.model.encoder_turns,
+            self.model.temp_c,
+            int(self.model.error_code_hex or "0", 16),
+            0,
+            _fixed(self.model.state, 24),
+        )
+        self._write(encode_frame(MSG_STATUS, payload))
+
     def reader_loop(self) -> None:
         buf = bytearray()
         while not self._stop.is_set():
@@ -80,22 +351,98 @@ class RS485Tester:
             if not chunk:
                 continue
             ch = chunk[0]
+            if self.binary:
+                if ch == 0:
+                    if buf:
+                        self._handle_frame(bytes(buf))
+                        buf.clear()
+                elif len(buf) < BIN_MAX_FRAME:
+                    buf.append(ch)
+                else:
+                    print("[RX] no frame delimiter, back to text mode")
+                    self.binary = False
+                    buf.clear()
+                continue
             if ch in (10, 13):
                 if buf:
                     line = buf.decode("utf-8", errors="replace").strip()
                     buf.clear()
                     if line:
                         print(f"[RX] {line}")
+                        if line == PROTO_ACK:
+                            self.binary = True
                         self._rx_q.put(line)
             else:
                 buf.append(ch)
 
+    def _handle_frame(self, block: bytes) -> None:
+        decoded = decode_frame(block)
+        if decoded is None:
+            print(f"[RX] bad frame ({len(block)}B)")
+            return
+        line = frame_to_line(*decoded)
+        print(f"[RX] {line} (bin)")
+        self._rx_q.put(line)
+
+    def _send_enc(self, now: float) -> None:
+        sub = self.subs["ENC"]
+        counts = round(self.model.encoder_turns / ENC_DELTA_UNIT)
+        delta = counts - self.enc_sent_counts
+        keyframe = now - self.enc_last_key >= ENC_KEYFRAME_PERIOD or not -32768 <= delta <= 32767
+        if not keyframe and abs(delta) * ENC_DELTA_UNIT < sub["deadband"]:
+            return
+        self.enc_seq = (self.enc_seq + 1) & 0xFF
+        if keyframe:
+            self.send_line(f"ENC|{counts * ENC_DELTA_UNIT:.3f}|{self.enc_seq}")
+            self.enc_last_key = now
+        else:
+            self.send_line(f"ENCD|{self.enc_seq}|{delta}")
+        self.enc_sent_counts = counts
+        sub["last_tx"] = now
+
+    def _send_temp(self, now: float) -> None:
+        sub = self.subs["TEMP"]
+        if abs(self.model.temp_c - sub["last"]) < sub["deadband"] and now - sub["last_tx"] < 5.0:
+            return
+        self.send_line(f"TEMP|{self.model.temp_c:.1f}")
+        sub["last"] = self.model.temp_c
+        sub["last_tx"] = now
+
+    def streaming_tick(self, now: float, dt: float) -> None:
+        """Subscribed telemetry: decimate to the requested rate, apply deadbands."""
+        self.model.encoder_turns += 0.02 * dt
+        self.model.temp_c = 185.0 + 0.25 * ((now % 10.0) - 5.0) / 5.0
+        self.model.state = SAFE_STATES[int(now // 5.0) % len(SAFE_STATES)]
+
+        enc = self.subs.get("ENC")
+        if enc and now - enc["last_tx"] >= 1.0 / max(enc["rate"], 1.0):
+            self._send_enc(now)
+        temp = self.subs.get("TEMP")
+        if temp and now - temp["last_tx"] >= 1.0 / max(temp["rate"], 1.0):
+            self._send_temp(now)
+        if self.model.state != self.last_state_sent:
+            self.send_line(f"STATE|{self.model.state}")
+            self.last_state_sent = self.model.state
+
     def telemetry_loop(self) -> None:
         idx = 0
+        last = time.monotonic()
         while not self._stop.is_set():
+            if self.subs:
+                now = time.monotonic()
+                self.streaming_tick(now, now - last)
+                last = now
+                time.sleep(0.005)
+                continue
+            last = time.monotonic()
             self.model.encoder_turns += 0.01
             self.model.temp_c += 0.05 if (idx % 20) < 10 else -0.05
             self.model.state = SAFE_STATES[(idx // 10) % len(SAFE_STATES)]
+            if self.binary:
+                self.send_status()
+                idx += 1
+                time.sleep(self.telemetry_period)
+                continue
             self.send_line(f"ENC|{self.model.encoder_turns:.3f}")
             self.send_line(f"TEMP|{self.model.temp_c:.1f}")
             self.send_line(f"STATE|{self.model.state}")
@@ -105,6 +452,31 @@ class RS485Tester:
     def handle_machine_request(self, line: str) -> None:
         cmd = line.split("|", 1)[0].strip().upper()
 
+        if cmd == "PROTO":
+            if self.allow_binary and line.strip().upper() == PROTO_REQ and not self.binary:
+                # Acknowledge in text, then switch: the HMI expects frames
+                # right after this line.
+                with self._tx_lock:
+                    self.ser.write((PROTO_ACK + "\n").encode("utf-8"))
+                    self.ser.flush()
+                    self.binary = True
+                print(f"[TX] {PROTO_ACK}")
+            return
+
+        if cmd == "SUB":
+            parts = [p.strip() for p in line.split("|")]
+            if len(parts) >= 4 and parts[1].upper() in SUB_CHANNELS:
+                try:
+                    rate, deadband = float(parts[2]), float(parts[3])
+                except ValueError:
+                    return
+                channel = parts[1].upper()
+                self.subs[channel] = {"rate": rate, "deadband": deadband, "last_tx": 0.0, "last": float("inf")}
+                if channel == "ENC":
+                    self.enc_last_key = 0.0  # next sample is a keyframe
+                print(f"Subscribed {channel}: {rate:g} Hz, deadband {deadband:g}")
+            return
+
         if cmd == "QUERY_STATE":
             self.send_line(f"STATE|{self.model.state}")
             return
@@ -143,6 +515,7 @@ class RS485Tester:
         print("  /state <NAME>              Change simulated state")
         print("  /error <HEX> <MSG...>      Set simulated error")
         print("  /clearerror                Clear simulated error")
+        print("  /unsub                     Drop telemetry subscriptions (plain ENC/TEMP/STATE)")
 
     def interactive_loop(self) -> None:
         self.command_help()
@@ -177,6 +550,10 @@ class RS485Tester:
                 self.model.error_msg = parts[2] if len(parts) > 2 else ""
                 print(f"Error set: {self.model.error_code_hex} {self.model.error_msg}")
                 continue
+            if raw == "/unsub":
+                self._init_streaming()
+                print("Subscriptions cleared")
+                continue
             if raw == "/clearerror":
                 self.model.error_code_hex = "0000"
                 self.model.error_msg = ""
@@ -227,6 +604,11 @@ def parse_args() -> argparse.Namespace:
         default=0.5,
         help="Seconds between periodic ENC/TEMP/STATE updates in machine mode",
     )
+    p.add_argument(
+        "--no-binary",
+        action="store_true",
+        help="Ignore PROTO|BIN|1 requests and keep the text protocol",
+    )
     return p.parse_args()
 
 
@@ -238,6 +620,7 @@ def main() -> int:
         timeout=args.timeout,
         mode=args.mode,
         telemetry_period=args.telemetry_period,
+        allow_binary=not args.no_binary,
     )
     try:
         tester.run()